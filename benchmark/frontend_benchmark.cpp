@@ -0,0 +1,260 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/IR/MLIRContext.h>
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/FormatVariadic.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <pylir/CodeGen/CodeGen.hpp>
+#include <pylir/Diagnostics/Document.hpp>
+#include <pylir/Lexer/Lexer.hpp>
+#include <pylir/Parser/Dumper.hpp>
+#include <pylir/Parser/Parser.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace
+{
+llvm::cl::opt<unsigned> sizeOption("size", llvm::cl::desc("Approximate size of each corpus in MiB"),
+                                   llvm::cl::init(4));
+llvm::cl::opt<unsigned> repetitionsOption("repetitions",
+                                          llvm::cl::desc("Amount of runs per stage, of which the fastest is reported"),
+                                          llvm::cl::init(3));
+llvm::cl::list<std::string> corpusOption("corpus", llvm::cl::desc("Only run the given corpora"),
+                                         llvm::cl::CommaSeparated);
+llvm::cl::opt<std::string> outputOption("o", llvm::cl::desc("Output file for the JSON results"),
+                                        llvm::cl::value_desc("filename"), llvm::cl::init("-"));
+
+/// Returns the peak resident set size of the process in bytes.
+std::size_t getPeakRSS()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    #ifdef __APPLE__
+    return usage.ru_maxrss;
+    #else
+    return usage.ru_maxrss * 1024;
+    #endif
+#endif
+}
+
+/// Generates 'size' bytes worth of source code, calling 'generator' with an increasing index for every chunk.
+std::string generate(std::size_t size, llvm::function_ref<void(std::string&, std::size_t)> generator)
+{
+    std::string result;
+    for (std::size_t i = 0; result.size() < size; i++)
+    {
+        generator(result, i);
+    }
+    return result;
+}
+
+std::string deeplyNestedExpressions(std::size_t size)
+{
+    return generate(size,
+                    [](std::string& result, std::size_t index)
+                    {
+                        constexpr std::size_t depth = 64;
+                        result += "nested_" + std::to_string(index) + " = ";
+                        for (std::size_t i = 0; i < depth; i++)
+                        {
+                            result += "(" + std::to_string(i) + (i % 2 ? " * " : " + ");
+                        }
+                        result += "1";
+                        result.append(depth, ')');
+                        result += "\n";
+                    });
+}
+
+std::string longLiteralTables(std::size_t size)
+{
+    return generate(size,
+                    [](std::string& result, std::size_t index)
+                    {
+                        result += "table_" + std::to_string(index) + " = {\n";
+                        for (std::size_t i = 0; i < 32; i++)
+                        {
+                            result += "    'key_" + std::to_string(i) + "': [" + std::to_string(index * 31337 + i)
+                                      + ", 0x" + std::to_string(i) + "FF_FF, 3.14159e" + std::to_string(i % 10)
+                                      + ", \"a fairly long string literal within the table\", b'bytes'],\n";
+                        }
+                        result += "}\n";
+                    });
+}
+
+std::string manySmallFunctions(std::size_t size)
+{
+    return generate(size,
+                    [](std::string& result, std::size_t index)
+                    {
+                        auto name = "function_" + std::to_string(index);
+                        result += "def " + name + "(a, b, c=" + std::to_string(index) + "):\n";
+                        result += "    if a < b:\n";
+                        result += "        return a + b * " + std::to_string(index) + "\n";
+                        result += "    while a:\n";
+                        result += "        a = a - 1\n";
+                        result += "    return [a, b, c]\n\n";
+                    });
+}
+
+std::string unicodeIdentifiers(std::size_t size)
+{
+    return generate(size,
+                    [](std::string& result, std::size_t index)
+                    {
+                        auto suffix = std::to_string(index);
+                        result += "変数_" + suffix + " = 1\n";
+                        result += "λ_" + suffix + " = 変数_" + suffix + " + 2\n";
+                        result += "ñandú_" + suffix + " = (λ_" + suffix + ", 変数_" + suffix + ")\n";
+                        result += "σύνολο_" + suffix + " = [ñandú_" + suffix + ", λ_" + suffix + "]\n";
+                    });
+}
+
+struct Corpus
+{
+    const char* name;
+    std::string (*generator)(std::size_t);
+};
+
+constexpr Corpus corpora[] = {
+    {"deeply-nested-expressions", deeplyNestedExpressions},
+    {"long-literal-tables", longLiteralTables},
+    {"many-small-functions", manySmallFunctions},
+    {"unicode-identifiers", unicodeIdentifiers},
+};
+
+/// Runs 'stage' multiple times and returns a JSON object containing the best throughput in MiB/s of 'bytes' and the
+/// peak resident set size of the process afterwards.
+llvm::json::Object measure(std::size_t bytes, llvm::function_ref<void()> stage)
+{
+    std::chrono::duration<double> best = std::chrono::duration<double>::max();
+    for (unsigned i = 0; i < std::max(1u, repetitionsOption.getValue()); i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        stage();
+        best = std::min<std::chrono::duration<double>>(best, std::chrono::steady_clock::now() - start);
+    }
+    return llvm::json::Object{
+        {"seconds", best.count()},
+        {"MiBps", static_cast<double>(bytes) / (1024.0 * 1024.0) / best.count()},
+        {"peakRSS", static_cast<std::int64_t>(getPeakRSS())},
+    };
+}
+
+llvm::json::Object runCorpus(const std::string& source)
+{
+    pylir::Diag::Document document(source, "<benchmark>");
+    llvm::json::Object stages;
+    stages["lexer"] = measure(source.size(),
+                              [&]
+                              {
+                                  pylir::Lexer lexer(document);
+                                  std::for_each(lexer.begin(), lexer.end(), [](auto&&) {});
+                              });
+
+    // Parsing includes lexing, as the parser lexes lazily.
+    std::optional<pylir::Syntax::FileInput> fileInput;
+    stages["parser"] = measure(source.size(),
+                               [&]
+                               {
+                                   pylir::Parser parser(document);
+                                   auto tree = parser.parseFileInput();
+                                   if (!tree)
+                                   {
+                                       llvm::report_fatal_error(llvm::Twine("Failed to parse corpus: ") + tree.error());
+                                   }
+                                   fileInput = std::move(*tree);
+                               });
+
+    stages["dumper"] = measure(source.size(),
+                               [&]
+                               {
+                                   pylir::Dumper dumper;
+                                   if (dumper.dump(*fileInput).empty())
+                                   {
+                                       llvm::report_fatal_error("Failed to dump corpus");
+                                   }
+                               });
+
+    mlir::MLIRContext context;
+    stages["codegen"] = measure(source.size(),
+                                [&]
+                                {
+                                    auto module = pylir::codegen(&context, *fileInput, document);
+                                    if (!module)
+                                    {
+                                        llvm::report_fatal_error("Failed to generate code for corpus");
+                                    }
+                                });
+    return stages;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    llvm::cl::ParseCommandLineOptions(
+        argc, argv,
+        "Measures the throughput of the Lexer, Parser, Dumper and CodeGen on generated corpora.\n"
+        "Peak RSS is the high-water mark of the whole process. Use --corpus to measure a single corpus in "
+        "isolation.\n");
+
+    llvm::json::Array results;
+    for (const auto& corpus : corpora)
+    {
+        if (!corpusOption.empty() && llvm::find(corpusOption, corpus.name) == corpusOption.end())
+        {
+            continue;
+        }
+        auto source = corpus.generator(static_cast<std::size_t>(sizeOption) * 1024 * 1024);
+        results.push_back(llvm::json::Object{
+            {"corpus", corpus.name},
+            {"bytes", static_cast<std::int64_t>(source.size())},
+            {"stages", runCorpus(source)},
+        });
+    }
+
+    std::error_code ec;
+    llvm::raw_fd_ostream output(outputOption, ec, llvm::sys::fs::OF_Text);
+    if (ec)
+    {
+        llvm::errs() << "Failed to open '" << outputOption << "': " << ec.message() << '\n';
+        return 1;
+    }
+    output << llvm::formatv("{0:2}", llvm::json::Value(llvm::json::Object{{"results", std::move(results)}})) << '\n';
+    return 0;
+}
@@ -0,0 +1,106 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/FormatVariadic.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <pylir/Diagnostics/Document.hpp>
+#include <pylir/Lexer/Lexer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace
+{
+llvm::cl::opt<unsigned> linesOption("lines", llvm::cl::desc("Amount of lines of the generated source"),
+                                    llvm::cl::init(100000));
+llvm::cl::opt<unsigned> repetitionsOption("repetitions",
+                                          llvm::cl::desc("Amount of runs per mode, of which the fastest is reported"),
+                                          llvm::cl::init(5));
+llvm::cl::opt<std::string> outputOption("o", llvm::cl::desc("Output file for the JSON results"),
+                                        llvm::cl::value_desc("filename"), llvm::cl::init("-"));
+
+/// Generates a source file consisting of 'lines' lines which resemble data heavy python code: Indented blocks,
+/// comments, long string literals and number literals.
+std::string generateSource(std::size_t lines)
+{
+    std::string result;
+    for (std::size_t i = 0; i < lines; i++)
+    {
+        switch (i % 4)
+        {
+            case 0: result += "def function_" + std::to_string(i) + "(argument, *args, **kwargs):\n"; break;
+            case 1: result += "    # A comment describing what is going on in this function in great detail\n"; break;
+            case 2:
+                result += "    table = {'key_" + std::to_string(i)
+                          + "': 'a fairly long string literal that is part of an embedded table', 'number': "
+                          + std::to_string(i * 31337) + ", 'float': 3.14159265}\n";
+                break;
+            case 3: result += "    return argument + table['number'] * 0x7FFF_FFFF\n"; break;
+        }
+    }
+    return result;
+}
+
+/// Lexes 'document' multiple times and returns a JSON object containing the best throughput in MiB/s. Lexes in
+/// parallel if 'threadPool' is non-null.
+llvm::json::Object measure(const pylir::Diag::Document& document, llvm::ThreadPool* threadPool = nullptr)
+{
+    std::chrono::duration<double> best = std::chrono::duration<double>::max();
+    for (unsigned i = 0; i < std::max(1u, repetitionsOption.getValue()); i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        pylir::Lexer lexer(
+            document, 0, [](auto&&) {}, threadPool);
+        bool error = std::any_of(lexer.begin(), lexer.end(),
+                                 [](const pylir::Token& token)
+                                 { return token.getTokenType() == pylir::TokenType::SyntaxError; });
+        best = std::min<std::chrono::duration<double>>(best, std::chrono::steady_clock::now() - start);
+        if (error)
+        {
+            llvm::report_fatal_error("Failed to lex generated source");
+        }
+    }
+    return llvm::json::Object{
+        {"seconds", best.count()},
+        {"MiBps", static_cast<double>(document.getText().size()) / (1024.0 * 1024.0) / best.count()},
+    };
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    llvm::cl::ParseCommandLineOptions(argc, argv,
+                                      "Measures the throughput of the Lexer on a generated source file, both when "
+                                      "lexing sequentially and in parallel.\n");
+
+    pylir::Diag::Document document(generateSource(linesOption), "<benchmark>");
+    llvm::ThreadPool threadPool;
+    auto parallel = measure(document, &threadPool);
+    parallel["threads"] = static_cast<std::int64_t>(threadPool.getThreadCount());
+    llvm::json::Object results{
+        {"bytes", static_cast<std::int64_t>(document.getText().size())},
+        {"sequential", measure(document)},
+        {"parallel", std::move(parallel)},
+    };
+
+    std::error_code ec;
+    llvm::raw_fd_ostream output(outputOption, ec, llvm::sys::fs::OF_Text);
+    if (ec)
+    {
+        llvm::errs() << "Failed to open '" << outputOption << "': " << ec.message() << '\n';
+        return 1;
+    }
+    output << llvm::formatv("{0:2}", llvm::json::Value(std::move(results))) << '\n';
+    return 0;
+}
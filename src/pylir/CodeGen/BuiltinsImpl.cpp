@@ -502,6 +502,7 @@ void pylir::CodeGen::createBuiltinsImpl()
     createClass(m_builder.getUnboundLocalErrorBuiltin(), {nameError});
     auto arithmeticError = createClass(m_builder.getArithmeticErrorBuiltin(), {exception});
     createClass(m_builder.getOverflowErrorBuiltin(), {arithmeticError});
+    createClass(m_builder.getImportErrorBuiltin(), {exception});
 
     createClass(m_builder.getStopIterationBuiltin(), {exception},
                 [&](SlotMapImpl& slots)
@@ -9,20 +9,27 @@
 #include <mlir/Dialect/Arithmetic/IR/Arithmetic.h>
 #include <mlir/Dialect/ControlFlow/IR/ControlFlowOps.h>
 #include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/IR/Threading.h>
 
 #include <llvm/ADT/ScopeExit.h>
+#include <llvm/ADT/Sequence.h>
 #include <llvm/ADT/TypeSwitch.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
 
+#include <pylir/Diagnostics/DiagnosticMessages.hpp>
 #include <pylir/Optimizer/PylirPy/IR/PylirPyAttributes.hpp>
 #include <pylir/Optimizer/PylirPy/IR/PylirPyDialect.hpp>
 #include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
 #include <pylir/Optimizer/PylirPy/Util/Builtins.hpp>
 #include <pylir/Optimizer/PylirPy/Util/Util.hpp>
+#include <pylir/Parser/Parser.hpp>
 #include <pylir/Parser/Visitor.hpp>
 #include <pylir/Support/Functional.hpp>
 #include <pylir/Support/ValueReset.hpp>
 
-pylir::CodeGen::CodeGen(mlir::MLIRContext* context, Diag::Document& document)
+pylir::CodeGen::CodeGen(mlir::MLIRContext* context, Diag::Document& document, CodeGenOptions options)
     : m_builder(
         [&]
         {
@@ -31,7 +38,8 @@ pylir::CodeGen::CodeGen(mlir::MLIRContext* context, Diag::Document& document)
             return context;
         }()),
       m_module(mlir::ModuleOp::create(m_builder.getUnknownLoc())),
-      m_document(&document)
+      m_document(&document),
+      m_options(std::move(options))
 {
     for (const auto& iter : Py::Builtins::allBuiltins)
     {
@@ -51,35 +59,92 @@ pylir::CodeGen::CodeGen(mlir::MLIRContext* context, Diag::Document& document)
 
 mlir::ModuleOp pylir::CodeGen::visit(const pylir::Syntax::FileInput& fileInput)
 {
+    m_tokenValues = fileInput.tokenValues.get();
     m_builder.setInsertionPointToEnd(m_module.getBody());
     createBuiltinsImpl();
+    if (m_builder.getContext()->isMultithreadingEnabled())
+    {
+        collectDeferrableFunctions(fileInput);
+    }
 
+    // The global variables and the initializer of any module but the main module are public and prefixed with the
+    // module name, allowing other modules to import from it.
+    bool isMainModule = m_options.moduleName == "__main__";
+    std::string modulePrefix = isMainModule ? "" : m_options.moduleName + ".";
     for (const auto& token : fileInput.globals)
     {
         auto locExit = changeLoc(token);
-        auto op = m_builder.createGlobalHandle(m_qualifiers + std::string(token.getValue()));
-        m_globalScope.identifiers.emplace(token.getValue(), Identifier{op.getOperation()});
+        auto op = m_builder.createGlobalHandle(modulePrefix + std::string(token.getValue()));
+        if (!isMainModule)
+        {
+            op.setPublic();
+        }
+        m_globalScope->identifiers.emplace(token, Identifier{op.getOperation()});
     }
     m_builder.setCurrentLoc(m_builder.getUnknownLoc());
+    mlir::FlatSymbolRefAttr initialized;
+    if (!isMainModule)
+    {
+        // Public, as loading a handle before storing to it is otherwise undefined behaviour.
+        auto op = m_builder.createGlobalHandle(modulePrefix + "$initialized");
+        op.setPublic();
+        initialized = mlir::FlatSymbolRefAttr::get(op);
+    }
 
-    auto initFunc =
-        mlir::func::FuncOp::create(m_builder.getUnknownLoc(), m_qualifiers + "__init__", m_builder.getFunctionType({}, {}));
+    auto initFunc = mlir::func::FuncOp::create(m_builder.getUnknownLoc(), modulePrefix + "__init__",
+                                               m_builder.getFunctionType({}, {}));
     auto reset = implementFunction(initFunc);
     // We aren't actually at function scope, even if wwe are implementing a function
     m_functionScope.reset();
+    if (initialized)
+    {
+        // Every import of the module calls its initializer, but only the first one may execute it.
+        auto isUnbound = m_builder.createIsUnboundValue(m_builder.createLoad(initialized));
+        auto alreadyInitialized = BlockPtr{};
+        auto firstImport = BlockPtr{};
+        m_builder.create<mlir::cf::CondBranchOp>(isUnbound, firstImport, alreadyInitialized);
+
+        implementBlock(alreadyInitialized);
+        m_builder.create<mlir::func::ReturnOp>();
+
+        implementBlock(firstImport);
+        m_builder.createStore(m_builder.createNoneRef(), initialized);
+    }
+    // Lets the runtime time the initialization of each module. Exceptions escaping the module skip the end marker.
+    mlir::Value moduleName;
+    if (m_options.timeModuleInit)
+    {
+        moduleName = m_builder.createConstant(m_options.moduleName);
+        m_builder.create<Py::ModuleInitStartOp>(moduleName);
+    }
     // Go through all globals again and initialize them explicitly to unbound
     auto unbound = m_builder.createConstant(m_builder.getUnboundAttr());
-    for (auto& [name, identifier] : m_globalScope.identifiers)
+    for (auto& [name, identifier] : m_globalScope->identifiers)
     {
         m_builder.createStore(unbound, mlir::FlatSymbolRefAttr::get(pylir::get<mlir::Operation*>(identifier.kind)));
     }
 
-    visit(fileInput.input);
+    visit(*fileInput.input);
     if (needsTerminator())
     {
+        if (moduleName)
+        {
+            m_builder.create<Py::ModuleInitEndOp>(moduleName);
+        }
         m_builder.create<mlir::func::ReturnOp>();
     }
+    implementDeferredFunctions();
+    if (m_options.importedFiles)
+    {
+        m_options.importedFiles->insert(m_options.importedFiles->end(), m_importedFiles.begin(),
+                                        m_importedFiles.end());
+    }
 
+    if (m_errorsOccurred)
+    {
+        m_module->erase();
+        return nullptr;
+    }
     return m_module;
 }
 
@@ -195,8 +260,8 @@ void pylir::CodeGen::visit(const Syntax::GlobalOrNonLocalStmt& globalOrNonLocalS
     }
     for (const auto& identifier : globalOrNonLocalStmt.identifiers)
     {
-        auto result = m_globalScope.identifiers.find(identifier.getValue());
-        PYLIR_ASSERT(result != m_globalScope.identifiers.end());
+        auto result = m_globalScope->identifiers.find(identifier);
+        PYLIR_ASSERT(result != m_globalScope->identifiers.end());
         m_functionScope->identifiers.insert(*result);
     }
 }
@@ -204,7 +269,7 @@ void pylir::CodeGen::visit(const Syntax::GlobalOrNonLocalStmt& globalOrNonLocalS
 void pylir::CodeGen::assignTarget(const Syntax::Atom& atom, mlir::Value value)
 {
     auto locExit = changeLoc(atom);
-    writeIdentifier(IdentifierToken{atom.token}, value);
+    writeIdentifier(IdentifierToken{atom.token, *m_tokenValues}, value);
 }
 
 void pylir::CodeGen::assignTarget(const Syntax::Subscription& subscription, mlir::Value value)
@@ -633,7 +698,7 @@ mlir::Value pylir::CodeGen::visit(const Syntax::Call& call)
     auto locExit = changeLoc(call);
     auto [tuple, keywords] = pylir::match(
         call.variant,
-        [&](const std::vector<Syntax::Argument>& vector) -> std::pair<mlir::Value, mlir::Value>
+        [&](const Syntax::ArenaVector<Syntax::Argument>& vector) -> std::pair<mlir::Value, mlir::Value>
         { return visit(vector); },
         [&](const Syntax::Comprehension& comprehension) -> std::pair<mlir::Value, mlir::Value>
         {
@@ -672,7 +737,7 @@ void pylir::CodeGen::writeIdentifier(const IdentifierToken& identifierToken, mli
         return;
     }
 
-    auto result = getCurrentScope().identifiers.find(identifierToken.getValue());
+    auto result = getCurrentScope().identifiers.find(identifierToken);
     // Should not be possible
     PYLIR_ASSERT(result != getCurrentScope().identifiers.end());
 
@@ -703,18 +768,18 @@ mlir::Value pylir::CodeGen::readIdentifier(const IdentifierToken& identifierToke
         implementBlock(elseBlock);
 
         // if not found in locals, it does not import free variables but rather goes straight to the global scope
-        scope = &m_globalScope;
+        scope = m_globalScope.get();
     }
     else
     {
         scope = &getCurrentScope();
     }
-    auto result = scope->identifiers.find(identifierToken.getValue());
-    if (result == scope->identifiers.end() && scope != &m_globalScope)
+    auto result = scope->identifiers.find(identifierToken);
+    if (result == scope->identifiers.end() && scope != m_globalScope.get())
     {
         // Try the global namespace
-        result = m_globalScope.identifiers.find(identifierToken.getValue());
-        scope = &m_globalScope;
+        result = m_globalScope->identifiers.find(identifierToken);
+        scope = m_globalScope.get();
     }
     if (result == scope->identifiers.end())
     {
@@ -729,8 +794,9 @@ mlir::Value pylir::CodeGen::readIdentifier(const IdentifierToken& identifierToke
             implementBlock(classNamespaceFound);
             return classNamespaceFound->getArgument(0);
         }
+        auto message = m_builder.createConstant(fmt::format("name '{}' is not defined", identifierToken.getValue()));
         auto exception = Py::buildException(m_builder.getCurrentLoc(), m_builder, Py::Builtins::NameError.name,
-                                            /*TODO: string arg*/ {}, m_currentExceptBlock);
+                                            {message}, m_currentExceptBlock);
         raiseException(exception);
         if (!m_classNamespace)
         {
@@ -762,9 +828,11 @@ mlir::Value pylir::CodeGen::readIdentifier(const IdentifierToken& identifierToke
             m_builder.create<mlir::cf::CondBranchOp>(success, successBlock, failureBlock);
 
             implementBlock(failureBlock);
+            auto message = m_builder.createConstant(
+                fmt::format("local variable '{}' referenced before assignment", identifierToken.getValue()));
             auto exception =
                 Py::buildException(m_builder.getCurrentLoc(), m_builder, Py::Builtins::UnboundLocalError.name,
-                                   /*TODO: string arg*/ {}, m_currentExceptBlock);
+                                   {message}, m_currentExceptBlock);
             raiseException(exception);
 
             implementBlock(successBlock);
@@ -779,14 +847,17 @@ mlir::Value pylir::CodeGen::readIdentifier(const IdentifierToken& identifierToke
     implementBlock(unbound);
     if (result->second.kind.index() == Identifier::Global)
     {
+        auto message = m_builder.createConstant(fmt::format("name '{}' is not defined", identifierToken.getValue()));
         auto exception = Py::buildException(m_builder.getCurrentLoc(), m_builder, Py::Builtins::NameError.name,
-                                            /*TODO: string arg*/ {}, m_currentExceptBlock);
+                                            {message}, m_currentExceptBlock);
         raiseException(exception);
     }
     else
     {
+        auto message = m_builder.createConstant(
+            fmt::format("local variable '{}' referenced before assignment", identifierToken.getValue()));
         auto exception = Py::buildException(m_builder.getCurrentLoc(), m_builder, Py::Builtins::UnboundLocalError.name,
-                                            /*TODO: string arg*/ {}, m_currentExceptBlock);
+                                            {message}, m_currentExceptBlock);
         raiseException(exception);
     }
 
@@ -805,20 +876,20 @@ mlir::Value pylir::CodeGen::visit(const pylir::Syntax::Atom& atom)
 {
     switch (atom.token.getTokenType())
     {
-        case TokenType::IntegerLiteral: return m_builder.createConstant(pylir::get<BigInt>(atom.token.getValue()));
+        case TokenType::IntegerLiteral: return m_builder.createConstant(m_tokenValues->getInteger(atom.token));
         case TokenType::ComplexLiteral:
             // TODO:
             PYLIR_UNREACHABLE;
         case TokenType::FloatingPointLiteral:
-            return m_builder.createConstant(pylir::get<double>(atom.token.getValue()));
-        case TokenType::StringLiteral: return m_builder.createConstant(pylir::get<std::string>(atom.token.getValue()));
+            return m_builder.createConstant(m_tokenValues->getDouble(atom.token));
+        case TokenType::StringLiteral: return m_builder.createConstant(m_tokenValues->getString(atom.token));
         case TokenType::ByteLiteral:
             // TODO:
             PYLIR_UNREACHABLE;
         case TokenType::TrueKeyword: return m_builder.createConstant(true);
         case TokenType::FalseKeyword: return m_builder.createConstant(false);
         case TokenType::NoneKeyword: return m_builder.createNoneRef();
-        case TokenType::Identifier: return readIdentifier(IdentifierToken{atom.token});
+        case TokenType::Identifier: return readIdentifier(IdentifierToken{atom.token, *m_tokenValues});
         default: PYLIR_UNREACHABLE;
     }
 }
@@ -862,7 +933,7 @@ mlir::Value pylir::CodeGen::visit(const Syntax::ListDisplay& listDisplay)
     auto locExit = changeLoc(listDisplay);
     return pylir::match(
         listDisplay.variant,
-        [&](const std::vector<Syntax::StarredItem>& list) -> mlir::Value
+        [&](const Syntax::ArenaVector<Syntax::StarredItem>& list) -> mlir::Value
         {
             auto operands = visit(list);
             return makeList(operands);
@@ -893,7 +964,7 @@ mlir::Value pylir::CodeGen::visit(const Syntax::SetDisplay& setDisplay)
     auto locExit = changeLoc(setDisplay);
     return pylir::match(
         setDisplay.variant,
-        [&](const std::vector<Syntax::StarredItem>& list) -> mlir::Value
+        [&](const Syntax::ArenaVector<Syntax::StarredItem>& list) -> mlir::Value
         {
             auto operands = visit(list);
             return makeSet(operands);
@@ -910,7 +981,7 @@ mlir::Value pylir::CodeGen::visit(const Syntax::DictDisplay& dictDisplay)
     auto locExit = changeLoc(dictDisplay);
     return pylir::match(
         dictDisplay.variant,
-        [&](const std::vector<Syntax::DictDisplay::KeyDatum>& list) -> mlir::Value
+        [&](const Syntax::ArenaVector<Syntax::DictDisplay::KeyDatum>& list) -> mlir::Value
         {
             std::vector<Py::DictArg> result;
             for (const auto& iter : list)
@@ -1419,11 +1490,9 @@ void pylir::CodeGen::visit(const pylir::Syntax::FuncDef& funcDef)
 {
     std::vector<Py::IterArg> defaultParameters;
     std::vector<Py::DictArg> keywordOnlyDefaultParameters;
-    std::vector<IdentifierToken> functionParametersTokens;
     std::vector<FunctionParameter> functionParameters;
     for (const auto& iter : funcDef.parameterList)
     {
-        functionParametersTokens.push_back(iter.name);
         functionParameters.push_back({std::string{iter.name.getValue()},
                                       static_cast<FunctionParameter::Kind>(iter.kind), iter.maybeDefault != nullptr});
         if (!iter.maybeDefault)
@@ -1446,76 +1515,23 @@ void pylir::CodeGen::visit(const pylir::Syntax::FuncDef& funcDef)
     }
     auto locExit = changeLoc(funcDef);
     auto qualifiedName = m_qualifiers + std::string(funcDef.funcName.getValue());
-    std::vector<IdentifierToken> usedClosures;
-    mlir::func::FuncOp func;
+    std::vector<IdentifierToken> usedClosures(funcDef.nonLocalVariables.begin(), funcDef.nonLocalVariables.end());
+    auto func = mlir::func::FuncOp::create(
+        m_builder.getCurrentLoc(), formImplName(qualifiedName + "$impl"),
+        m_builder.getFunctionType(std::vector<mlir::Type>(1 + functionParameters.size(), m_builder.getDynamicType()),
+                                  {m_builder.getDynamicType()}));
+    func.setPrivate();
+    if (m_deferrableFunctions.count(&funcDef))
+    {
+        // The calling convention wrapper only needs the signature of the implementation. Its body is implemented
+        // later, once the module has been generated.
+        auto callingConvention = buildFunctionCC(formImplName(qualifiedName + "$cc"), func, functionParameters);
+        m_deferredFunctions.push_back({&funcDef, func, callingConvention});
+        func = callingConvention;
+    }
+    else
     {
-        pylir::ValueReset namespaceReset(m_classNamespace);
-        m_classNamespace = {};
-        func =
-            mlir::func::FuncOp::create(m_builder.getCurrentLoc(), formImplName(qualifiedName + "$impl"),
-                                       m_builder.getFunctionType(std::vector<mlir::Type>(1 + functionParameters.size(),
-                                                                                         m_builder.getDynamicType()),
-                                                                 {m_builder.getDynamicType()}));
-        func.setPrivate();
-        auto reset = implementFunction(func);
-
-        m_qualifiers.append(funcDef.funcName.getValue());
-        m_qualifiers += ".<locals>.";
-        auto locals = funcDef.localVariables;
-        auto closures = funcDef.closures;
-        for (auto [name, value] : llvm::zip(functionParametersTokens, llvm::drop_begin(func.getArguments())))
-        {
-            if (funcDef.closures.count(name))
-            {
-                auto closureType = m_builder.createCellRef();
-                auto tuple = m_builder.createMakeTuple({closureType, value});
-                auto emptyDict = m_builder.createConstant(m_builder.getDictAttr());
-                auto metaType = m_builder.createTypeOf(closureType);
-                auto newMethod = m_builder.createGetSlot(closureType, metaType, "__new__");
-                mlir::Value cell = m_builder.createFunctionCall(newMethod, {newMethod, tuple, emptyDict});
-                m_functionScope->identifiers.emplace(name.getValue(), Identifier{cell});
-                closures.erase(name);
-            }
-            else
-            {
-                m_functionScope->identifiers.emplace(
-                    name.getValue(), Identifier{SSABuilder::DefinitionsMap{{m_builder.getBlock(), value}}});
-                locals.erase(name);
-            }
-        }
-        for (const auto& iter : locals)
-        {
-            m_functionScope->identifiers.emplace(iter.getValue(), Identifier{SSABuilder::DefinitionsMap{}});
-        }
-        for (const auto& iter : closures)
-        {
-            auto closureType = m_builder.createCellRef();
-            auto tuple = m_builder.createMakeTuple({closureType});
-            auto emptyDict = m_builder.createConstant(m_builder.getDictAttr());
-            auto metaType = m_builder.createTypeOf(closureType);
-            auto newMethod = m_builder.createGetSlot(closureType, metaType, "__new__");
-            mlir::Value cell = m_builder.createFunctionCall(newMethod, {newMethod, tuple, emptyDict});
-            m_functionScope->identifiers.emplace(iter.getValue(), Identifier{cell});
-        }
-        if (!funcDef.nonLocalVariables.empty())
-        {
-            auto self = func.getArgument(0);
-            auto metaType = m_builder.createFunctionRef();
-            auto closureTuple = m_builder.createGetSlot(self, metaType, "__closure__");
-            for (const auto& iter : llvm::enumerate(funcDef.nonLocalVariables))
-            {
-                auto constant = m_builder.create<mlir::arith::ConstantIndexOp>(iter.index());
-                auto cell = m_builder.createTupleGetItem(closureTuple, constant);
-                m_functionScope->identifiers.emplace(iter.value().getValue(), Identifier{mlir::Value{cell}});
-                usedClosures.push_back(iter.value());
-            }
-        }
-
-        visit(*funcDef.suite);
-        if (needsTerminator())
-        {
-            m_builder.create<mlir::func::ReturnOp>(mlir::ValueRange{m_builder.createNoneRef()});
-        }
+        implementFuncDef(funcDef, func);
         func = buildFunctionCC(formImplName(qualifiedName + "$cc"), func, functionParameters);
     }
     mlir::Value value = m_builder.createMakeFunc(mlir::FlatSymbolRefAttr::get(func));
@@ -1557,7 +1573,7 @@ void pylir::CodeGen::visit(const pylir::Syntax::FuncDef& funcDef)
             std::transform(usedClosures.begin(), usedClosures.end(), args.begin(),
                            [&](const IdentifierToken& token) -> Py::IterArg
                            {
-                               auto result = getCurrentScope().identifiers.find(token.getValue());
+                               auto result = getCurrentScope().identifiers.find(token);
                                PYLIR_ASSERT(result != getCurrentScope().identifiers.end());
                                return pylir::get<mlir::Value>(result->second.kind);
                            });
@@ -1579,6 +1595,164 @@ void pylir::CodeGen::visit(const pylir::Syntax::FuncDef& funcDef)
     writeIdentifier(funcDef.funcName, value);
 }
 
+void pylir::CodeGen::implementFuncDef(const Syntax::FuncDef& funcDef, mlir::func::FuncOp func)
+{
+    pylir::ValueReset namespaceReset(m_classNamespace);
+    m_classNamespace = {};
+    auto reset = implementFunction(func);
+
+    m_qualifiers.append(funcDef.funcName.getValue());
+    m_qualifiers += ".<locals>.";
+    IdentifierSet locals(funcDef.localVariables.begin(), funcDef.localVariables.end());
+    IdentifierSet closures(funcDef.closures.begin(), funcDef.closures.end());
+    for (auto [parameter, value] : llvm::zip(funcDef.parameterList, llvm::drop_begin(func.getArguments())))
+    {
+        const auto& name = parameter.name;
+        if (funcDef.closures.count(name))
+        {
+            auto closureType = m_builder.createCellRef();
+            auto tuple = m_builder.createMakeTuple({closureType, value});
+            auto emptyDict = m_builder.createConstant(m_builder.getDictAttr());
+            auto metaType = m_builder.createTypeOf(closureType);
+            auto newMethod = m_builder.createGetSlot(closureType, metaType, "__new__");
+            mlir::Value cell = m_builder.createFunctionCall(newMethod, {newMethod, tuple, emptyDict});
+            m_functionScope->identifiers.emplace(name, Identifier{cell});
+            closures.erase(name);
+        }
+        else
+        {
+            m_functionScope->identifiers.emplace(name,
+                                                 Identifier{SSABuilder::DefinitionsMap{{m_builder.getBlock(), value}}});
+            locals.erase(name);
+        }
+    }
+    for (const auto& iter : locals)
+    {
+        m_functionScope->identifiers.emplace(iter, Identifier{SSABuilder::DefinitionsMap{}});
+    }
+    for (const auto& iter : closures)
+    {
+        auto closureType = m_builder.createCellRef();
+        auto tuple = m_builder.createMakeTuple({closureType});
+        auto emptyDict = m_builder.createConstant(m_builder.getDictAttr());
+        auto metaType = m_builder.createTypeOf(closureType);
+        auto newMethod = m_builder.createGetSlot(closureType, metaType, "__new__");
+        mlir::Value cell = m_builder.createFunctionCall(newMethod, {newMethod, tuple, emptyDict});
+        m_functionScope->identifiers.emplace(iter, Identifier{cell});
+    }
+    if (!funcDef.nonLocalVariables.empty())
+    {
+        auto self = func.getArgument(0);
+        auto metaType = m_builder.createFunctionRef();
+        auto closureTuple = m_builder.createGetSlot(self, metaType, "__closure__");
+        for (const auto& iter : llvm::enumerate(funcDef.nonLocalVariables))
+        {
+            auto constant = m_builder.create<mlir::arith::ConstantIndexOp>(iter.index());
+            auto cell = m_builder.createTupleGetItem(closureTuple, constant);
+            m_functionScope->identifiers.emplace(iter.value(), Identifier{mlir::Value{cell}});
+        }
+    }
+
+    visit(*funcDef.suite);
+    if (needsTerminator())
+    {
+        m_builder.create<mlir::func::ReturnOp>(mlir::ValueRange{m_builder.createNoneRef()});
+    }
+}
+
+namespace
+{
+/// Counts the names of all functions defined at global scope, including the ones nested within compound statements.
+class GlobalFunctionNameCounter : public pylir::Syntax::Visitor<GlobalFunctionNameCounter>
+{
+public:
+    std::unordered_map<std::string_view, std::size_t> counts;
+
+    using Visitor::visit;
+
+    void visit(const pylir::Syntax::FuncDef& funcDef)
+    {
+        counts[funcDef.funcName.getValue()]++;
+    }
+
+    void visit(const pylir::Syntax::ClassDef&) {}
+};
+} // namespace
+
+void pylir::CodeGen::collectDeferrableFunctions(const Syntax::FileInput& fileInput)
+{
+    // Functions are only deferred if the generated code does not depend on the order in which they are implemented.
+    // The implementation of any function nested within 'f' is named 'f.<locals>.*' with a counter appended, that is
+    // only deterministic if 'f' is the only function of that name at global scope. The function also mustn't be
+    // nested within a loop, try statement or similar, whose state would otherwise have to be captured.
+    GlobalFunctionNameCounter counter;
+    counter.visit(fileInput);
+    for (const auto& iter : fileInput.input->statements)
+    {
+        const auto* compoundStmt = std::get_if<IntrVarPtr<Syntax::CompoundStmt>>(&iter);
+        if (!compoundStmt)
+        {
+            continue;
+        }
+        const auto* funcDef = (*compoundStmt)->dyn_cast<Syntax::FuncDef>();
+        if (!funcDef || counter.counts[funcDef->funcName.getValue()] != 1)
+        {
+            continue;
+        }
+        m_deferrableFunctions.insert(funcDef);
+    }
+}
+
+void pylir::CodeGen::implementDeferredFunctions()
+{
+    struct Result
+    {
+        mlir::OwningOpRef<mlir::ModuleOp> module;
+        std::string errors;
+        std::vector<std::string> importedFiles;
+        bool errorsOccurred = false;
+    };
+    std::vector<Result> results(m_deferredFunctions.size());
+    mlir::parallelForEach(m_builder.getContext(), llvm::seq<std::size_t>(0, m_deferredFunctions.size()),
+                          [&](std::size_t index)
+                          {
+                              const auto& deferred = m_deferredFunctions[index];
+                              auto& result = results[index];
+                              llvm::raw_string_ostream errorStream(result.errors);
+                              CodeGen codeGen(m_builder.getContext(), *m_document, m_options);
+                              codeGen.m_globalScope = m_globalScope;
+                              codeGen.m_tokenValues = m_tokenValues;
+                              codeGen.m_errorStream = &errorStream;
+                              auto locExit = codeGen.changeLoc(*deferred.funcDef);
+                              codeGen.implementFuncDef(*deferred.funcDef, deferred.implementation);
+                              result.module = codeGen.m_module;
+                              result.importedFiles = std::move(codeGen.m_importedFiles);
+                              result.errorsOccurred = codeGen.m_errorsOccurred;
+                          });
+
+    // Insert the implementation and any nested functions right before the calling convention wrapper. This is the
+    // same place as if the function had been implemented sequentially.
+    for (auto [deferred, result] : llvm::zip(m_deferredFunctions, results))
+    {
+        for (auto& op : llvm::make_early_inc_range(result.module->getBody()->getOperations()))
+        {
+            // Symbols of imported modules are declared by every code generator importing them.
+            auto symbol = mlir::dyn_cast<mlir::SymbolOpInterface>(op);
+            if (symbol && (symbol.isDeclaration() || mlir::isa<Py::GlobalHandleOp>(op))
+                && m_module.lookupSymbol(symbol.getNameAttr()))
+            {
+                op.erase();
+                continue;
+            }
+            op.moveBefore(deferred.callingConvention);
+        }
+        m_importedFiles.insert(m_importedFiles.end(), result.importedFiles.begin(), result.importedFiles.end());
+        *m_errorStream << result.errors;
+        m_errorsOccurred = m_errorsOccurred || result.errorsOccurred;
+    }
+    m_deferredFunctions.clear();
+}
+
 void pylir::CodeGen::visit(const pylir::Syntax::ClassDef& classDef)
 {
     m_builder.setCurrentLoc(getLoc(classDef, classDef.className));
@@ -2049,6 +2223,157 @@ void pylir::CodeGen::visit(const Syntax::DelStmt& delStmt)
 
 void pylir::CodeGen::visit(const Syntax::ImportStmt& importStmt)
 {
-    // TODO:
-    PYLIR_UNREACHABLE;
+    auto diagnoseUnsupported = [&](const BaseToken& keyword, const auto& message)
+    {
+        *m_errorStream << createDiagnosticsBuilder(keyword, message)
+                              .addLabel(keyword, std::nullopt, Diag::ERROR_COLOUR)
+                              .emitError();
+        m_errorsOccurred = true;
+    };
+    pylir::match(
+        importStmt.variant,
+        // TODO: Binding modules requires module objects and attribute references.
+        [&](const Syntax::ImportStmt::ImportAs& importAs)
+        { diagnoseUnsupported(importAs.import, Diag::IMPORTING_MODULES_IS_NOT_YET_SUPPORTED); },
+        [&](const Syntax::ImportStmt::ImportAll& importAll)
+        { diagnoseUnsupported(importAll.star, Diag::IMPORTING_ALL_NAMES_IS_NOT_YET_SUPPORTED); },
+        [&](const Syntax::ImportStmt::FromImport& fromImport)
+        {
+            const auto& relativeModule = fromImport.relativeModule;
+            if (!relativeModule.dots.empty())
+            {
+                diagnoseUnsupported(relativeModule.dots.front(), Diag::RELATIVE_IMPORTS_ARE_NOT_YET_SUPPORTED);
+                return;
+            }
+            const auto& module = *relativeModule.module;
+            std::string moduleName;
+            llvm::interleave(
+                module.identifiers, [&](const IdentifierToken& token) { moduleName += token.getValue(); },
+                [&] { moduleName += "."; });
+            // Features have already been handled by the parser.
+            if (moduleName == "__future__")
+            {
+                return;
+            }
+            const auto* globals = getModuleInterface(module, moduleName);
+            if (!globals)
+            {
+                return;
+            }
+            callModuleInitializer(moduleName);
+            for (const auto& [imported, name] : fromImport.imports)
+            {
+                if (!globals->count(std::string(imported.getValue())))
+                {
+                    *m_errorStream << createDiagnosticsBuilder(imported, Diag::CANNOT_IMPORT_NAME_N_FROM_N,
+                                                               imported.getValue(), moduleName)
+                                          .addLabel(imported, std::nullopt, Diag::ERROR_COLOUR)
+                                          .emitError();
+                    m_errorsOccurred = true;
+                    continue;
+                }
+                auto locExit = changeLoc(imported);
+                auto value =
+                    m_builder.createLoad(declareImportedGlobal(moduleName + "." + std::string(imported.getValue())));
+                auto isUnbound = m_builder.createIsUnboundValue(value);
+                auto unbound = BlockPtr{};
+                auto found = BlockPtr{};
+                m_builder.create<mlir::cf::CondBranchOp>(isUnbound, unbound, found);
+
+                implementBlock(unbound);
+                auto message = m_builder.createConstant(
+                    fmt::format(Diag::CANNOT_IMPORT_NAME_N_FROM_N, imported.getValue(), moduleName));
+                auto exception = Py::buildException(m_builder.getCurrentLoc(), m_builder,
+                                                    Py::Builtins::ImportError.name, {message}, m_currentExceptBlock);
+                raiseException(exception);
+
+                implementBlock(found);
+                writeIdentifier(name ? *name : imported, value);
+            }
+        });
+}
+
+const std::unordered_set<std::string>*
+    pylir::CodeGen::getModuleInterface(const Syntax::ImportStmt::Module& module, const std::string& moduleName)
+{
+    if (auto result = m_moduleInterfaces.find(moduleName); result != m_moduleInterfaces.end())
+    {
+        return &result->second;
+    }
+
+    llvm::SmallString<64> relativePath;
+    for (const auto& iter : module.identifiers)
+    {
+        llvm::sys::path::append(relativePath, iter.getValue());
+    }
+    relativePath += ".py";
+
+    llvm::SmallVector<llvm::StringRef> directories{llvm::sys::path::parent_path(m_document->getFilename())};
+    directories.append(m_options.importPaths.begin(), m_options.importPaths.end());
+    for (auto directory : directories)
+    {
+        llvm::SmallString<128> path = directory;
+        llvm::sys::path::append(path, relativePath);
+        auto buffer = llvm::MemoryBuffer::getFile(path);
+        if (!buffer)
+        {
+            continue;
+        }
+        // Only the names of the global variables are required to import from the module. Its code is generated when
+        // it is compiled separately.
+        Diag::Document document(std::string((*buffer)->getBuffer()), std::string(path));
+        Parser parser(document);
+        auto tree = parser.parseFileInput();
+        if (!tree)
+        {
+            *m_errorStream << tree.error();
+            m_errorsOccurred = true;
+            return nullptr;
+        }
+        auto& globals = m_moduleInterfaces[moduleName];
+        for (const auto& iter : tree->globals)
+        {
+            globals.emplace(iter.getValue());
+        }
+        m_importedFiles.emplace_back(path);
+        return &globals;
+    }
+
+    *m_errorStream << createDiagnosticsBuilder(module.identifiers.front(), Diag::COULD_NOT_FIND_MODULE_N, moduleName)
+                          .addLabel(module.identifiers.front(), module.identifiers.back(), std::nullopt,
+                                    Diag::ERROR_COLOUR)
+                          .emitError();
+    m_errorsOccurred = true;
+    return nullptr;
+}
+
+mlir::FlatSymbolRefAttr pylir::CodeGen::declareImportedGlobal(llvm::StringRef name)
+{
+    if (!m_module.lookupSymbol(name))
+    {
+        mlir::OpBuilder::InsertionGuard guard{m_builder};
+        m_builder.setInsertionPointToEnd(m_module.getBody());
+        m_builder.createGlobalHandle(name).setPublic();
+    }
+    return mlir::FlatSymbolRefAttr::get(m_builder.getContext(), name);
+}
+
+void pylir::CodeGen::callModuleInitializer(llvm::StringRef moduleName)
+{
+    auto name = (moduleName + ".__init__").str();
+    auto initializer = m_module.lookupSymbol<mlir::func::FuncOp>(name);
+    if (!initializer)
+    {
+        initializer = mlir::func::FuncOp::create(m_builder.getUnknownLoc(), name, m_builder.getFunctionType({}, {}));
+        initializer.setPrivate();
+        m_module.push_back(initializer);
+    }
+    if (!m_currentExceptBlock)
+    {
+        m_builder.create<Py::CallOp>(initializer, mlir::ValueRange{});
+        return;
+    }
+    auto happyPath = BlockPtr{};
+    m_builder.createInvoke({}, mlir::FlatSymbolRefAttr::get(initializer), {}, happyPath, {}, m_currentExceptBlock, {});
+    implementBlock(happyPath);
 }
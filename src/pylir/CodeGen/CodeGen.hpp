@@ -14,6 +14,7 @@
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/ScopeExit.h>
 #include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/Support/raw_ostream.h>
 
 #include <pylir/Diagnostics/DiagnosticsBuilder.hpp>
 #include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
@@ -24,12 +25,30 @@
 #include <pylir/Support/ValueReset.hpp>
 
 #include <map>
+#include <memory>
 #include <stack>
+#include <string>
 #include <tuple>
+#include <unordered_set>
+#include <vector>
 
 namespace pylir
 {
 
+struct CodeGenOptions
+{
+    /// Name of the module being compiled. The global variables and the initializer '<name>.__init__' of any module but
+    /// the main module '__main__', whose initializer is called '__init__', are public and can be imported.
+    std::string moduleName = "__main__";
+    /// Directories in which source files of imported modules are searched, after the directory of the compiled file.
+    std::vector<std::string> importPaths;
+    /// If non-null, the paths of the source files of all imported modules are appended to it.
+    std::vector<std::string>* importedFiles = nullptr;
+    /// Whether to mark the start and end of the module initializer with 'py.intr.moduleInitStart' and
+    /// 'py.intr.moduleInitEnd', allowing the runtime to report the time spent initializing the module.
+    bool timeModuleInit = false;
+};
+
 class CodeGen
 {
     Py::PyBuilder m_builder;
@@ -37,9 +56,16 @@ class CodeGen
     mlir::func::FuncOp m_currentFunc;
     mlir::Region* m_currentRegion{};
     Diag::Document* m_document;
+    const TokenValueStorage* m_tokenValues = nullptr;
     mlir::Value m_classNamespace{};
     std::unordered_map<std::string, std::size_t> m_implNames;
     std::unordered_map<std::string_view, mlir::FlatSymbolRefAttr> m_builtinNamespace;
+    llvm::raw_ostream* m_errorStream = &llvm::errs();
+    bool m_errorsOccurred = false;
+    CodeGenOptions m_options;
+    /// Names of the global variables of every module imported so far.
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_moduleInterfaces;
+    std::vector<std::string> m_importedFiles;
 
     struct Loop
     {
@@ -81,23 +107,47 @@ class CodeGen
 
     struct Scope
     {
-        std::unordered_map<std::string_view, Identifier> identifiers;
+        IdentifierMap<Identifier> identifiers;
         SSABuilder ssaBuilder;
     };
 
-    Scope m_globalScope;
+    // Shared with the code generators implementing deferred functions.
+    std::shared_ptr<Scope> m_globalScope = std::make_shared<Scope>();
     std::optional<Scope> m_functionScope;
     std::string m_qualifiers;
 
+    /// Function at global scope whose body is implemented after the rest of the module, possibly in parallel.
+    struct DeferredFunction
+    {
+        const Syntax::FuncDef* PYLIR_NON_NULL funcDef;
+        mlir::func::FuncOp implementation;
+        mlir::func::FuncOp callingConvention;
+    };
+    llvm::SmallPtrSet<const Syntax::FuncDef*, 8> m_deferrableFunctions;
+    std::vector<DeferredFunction> m_deferredFunctions;
+
+    void collectDeferrableFunctions(const Syntax::FileInput& fileInput);
+
+    void implementDeferredFunctions();
+
+    void implementFuncDef(const Syntax::FuncDef& funcDef, mlir::func::FuncOp func);
+
     [[nodiscard]] auto markOpenBlock(mlir::Block* block)
     {
         getCurrentScope().ssaBuilder.markOpenBlock(block);
         return llvm::make_scope_exit([this, block] { getCurrentScope().ssaBuilder.sealBlock(block); });
     }
 
+    template <class T, class S, class... Args>
+    [[nodiscard]] Diag::DiagnosticsBuilder createDiagnosticsBuilder(const T& location, const S& message,
+                                                                    Args&&... args) const
+    {
+        return Diag::DiagnosticsBuilder(*m_document, location, message, std::forward<Args>(args)...);
+    }
+
     Scope& getCurrentScope()
     {
-        return m_functionScope ? *m_functionScope : m_globalScope;
+        return m_functionScope ? *m_functionScope : *m_globalScope;
     }
 
     class BlockPtr
@@ -181,6 +231,16 @@ class CodeGen
 
     void raiseException(mlir::Value exceptionObject);
 
+    /// Returns the names of the global variables of 'module', which are computed by parsing its source file. Returns
+    /// null and emits an error if the module could not be found or parsed.
+    const std::unordered_set<std::string>* getModuleInterface(const Syntax::ImportStmt::Module& module,
+                                                              const std::string& moduleName);
+
+    /// Returns a reference to the public handle 'name' of an imported module, declaring it if required.
+    mlir::FlatSymbolRefAttr declareImportedGlobal(llvm::StringRef name);
+
+    void callModuleInitializer(llvm::StringRef moduleName);
+
     mlir::Value buildSubclassCheck(mlir::Value type, mlir::Value base);
 
     void buildTupleForEach(mlir::Value tuple, mlir::Block* endBlock, mlir::ValueRange endArgs,
@@ -385,7 +445,7 @@ class CodeGen
     }
 
 public:
-    CodeGen(mlir::MLIRContext* context, Diag::Document& document);
+    CodeGen(mlir::MLIRContext* context, Diag::Document& document, CodeGenOptions options = {});
 
     mlir::ModuleOp visit(const Syntax::FileInput& fileInput);
 
@@ -480,9 +540,9 @@ public:
 };
 
 inline mlir::OwningOpRef<mlir::ModuleOp> codegen(mlir::MLIRContext* context, const Syntax::FileInput& input,
-                                                 Diag::Document& document)
+                                                 Diag::Document& document, CodeGenOptions options = {})
 {
-    CodeGen codegen{context, document};
+    CodeGen codegen{context, document, std::move(options)};
     return codegen.visit(input);
 }
 
@@ -187,4 +187,15 @@ constexpr auto STARRED_PARAMETER_N_HERE = FMT_STRING("starred parameter '{}' her
 constexpr auto EXCEPT_CLAUSE_WITHOUT_EXPRESSION_MUST_COME_LAST =
     FMT_STRING("except clause without expression must come last");
 
+constexpr auto IMPORTING_MODULES_IS_NOT_YET_SUPPORTED = FMT_STRING("importing modules is not yet supported");
+
+constexpr auto RELATIVE_IMPORTS_ARE_NOT_YET_SUPPORTED = FMT_STRING("relative imports are not yet supported");
+
+constexpr auto IMPORTING_ALL_NAMES_IS_NOT_YET_SUPPORTED =
+    FMT_STRING("importing all names of a module is not yet supported");
+
+constexpr auto COULD_NOT_FIND_MODULE_N = FMT_STRING("could not find module '{}'");
+
+constexpr auto CANNOT_IMPORT_NAME_N_FROM_N = FMT_STRING("cannot import name '{}' from '{}'");
+
 } // namespace pylir::Diag
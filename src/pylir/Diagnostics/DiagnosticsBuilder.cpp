@@ -20,18 +20,37 @@ std::string pylir::Diag::DiagnosticsBuilder::printLine(std::size_t width, std::s
                                                        const Document& document, std::vector<Label> labels)
 {
     std::string result = fmt::format("{1: >{0}} | ", width, lineNumber);
-    auto line = document.getLine(lineNumber);
+    auto utf8Line = document.getLine(lineNumber);
     if (labels.empty())
     {
-        result += Text::toUTF8String(line) + "\n";
+        result += utf8Line;
+        result += '\n';
         return result;
     }
-    auto offset = line.data() - document.getText().data();
+    // The document only stores UTF-8. Decode the line and translate the byte offsets of all labels to indices of
+    // codepoints within the line.
+    auto utf32Line = Text::toUTF32String(utf8Line);
+    std::u32string_view line = utf32Line;
+    auto lineOffset = static_cast<std::size_t>(utf8Line.data() - document.getText().data());
+    auto toIndex = [&](std::size_t offset)
+    {
+        offset -= lineOffset;
+        auto prefix = utf8Line.substr(0, offset);
+        return static_cast<std::size_t>(std::count_if(prefix.begin(), prefix.end(),
+                                                      [](char value)
+                                                      { return (static_cast<unsigned char>(value) & 0xC0) != 0x80; }))
+               + (offset - prefix.size());
+    };
+    for (auto& iter : labels)
+    {
+        iter.start = toIndex(iter.start);
+        iter.end = toIndex(iter.end);
+    }
     {
         std::size_t lastEnd = 0;
         for (auto& iter : labels)
         {
-            result += Text::toUTF8String(line.substr(lastEnd, iter.start - offset - lastEnd));
+            result += Text::toUTF8String(line.substr(lastEnd, iter.start - lastEnd));
             fmt::text_style style;
             if (iter.optionalColour)
             {
@@ -42,12 +61,12 @@ std::string pylir::Diag::DiagnosticsBuilder::printLine(std::size_t width, std::s
                 style |= static_cast<fmt::emphasis>(*iter.optionalEmphasis);
             }
             // If not pointing at newline
-            if (iter.start - offset != line.size())
+            if (iter.start != line.size())
             {
                 result += fmt::format(style, "{}",
-                                      Text::toUTF8String(line.substr(iter.start - offset, iter.end - iter.start)));
+                                      Text::toUTF8String(line.substr(iter.start, iter.end - iter.start)));
             }
-            lastEnd = iter.end - offset;
+            lastEnd = iter.end;
         }
         if (lastEnd <= line.size())
         {
@@ -63,7 +82,7 @@ std::string pylir::Diag::DiagnosticsBuilder::printLine(std::size_t width, std::s
         underlines.reserve(line.size());
         for (auto& iter : labels)
         {
-            for (auto codepoint : line.substr(lastEnd, iter.start - offset - lastEnd))
+            for (auto codepoint : line.substr(lastEnd, iter.start - lastEnd))
             {
                 if (Text::isWhitespace(codepoint))
                 {
@@ -73,18 +92,18 @@ std::string pylir::Diag::DiagnosticsBuilder::printLine(std::size_t width, std::s
                 auto consoleWidth = Text::consoleWidth(codepoint);
                 underlines.insert(underlines.end(), consoleWidth, U' ');
             }
-            lastEnd = iter.end - offset;
+            lastEnd = iter.end;
             fmt::text_style style;
             if (iter.optionalColour)
             {
                 style = fmt::fg(static_cast<fmt::color>(*iter.optionalColour));
             }
-            if (iter.start - offset == line.size())
+            if (iter.start == line.size())
             {
                 underlines += fmt::format(style, U"^");
                 continue;
             }
-            auto substr = line.substr(iter.start - offset, iter.end - iter.start);
+            auto substr = line.substr(iter.start, iter.end - iter.start);
             if (substr.size() == 1)
             {
                 auto consoleWidth = Text::consoleWidth(substr.front());
@@ -120,7 +139,7 @@ std::string pylir::Diag::DiagnosticsBuilder::printLine(std::size_t width, std::s
             {
                 style = fmt::fg(static_cast<fmt::color>(*iter.optionalColour));
             }
-            auto thisMid = (iter.end - iter.start) / 2 + iter.start - offset;
+            auto thisMid = (iter.end - iter.start) / 2 + iter.start;
             for (auto codepoint : line.substr(lastEnd, thisMid - lastEnd))
             {
                 if (Text::isWhitespace(codepoint))
@@ -152,7 +171,7 @@ std::string pylir::Diag::DiagnosticsBuilder::printLine(std::size_t width, std::s
                 {
                     style = fmt::fg(static_cast<fmt::color>(*iter->optionalColour));
                 }
-                auto thisMid = (iter->end - iter->start) / 2 + iter->start - offset;
+                auto thisMid = (iter->end - iter->start) / 2 + iter->start;
                 for (auto codepoint : line.substr(lastEnd, thisMid - lastEnd))
                 {
                     if (Text::isWhitespace(codepoint))
@@ -170,7 +189,7 @@ std::string pylir::Diag::DiagnosticsBuilder::printLine(std::size_t width, std::s
                 if (auto next = iter + 1; next != labels.end())
                 {
                     std::size_t widthTillNext = 0;
-                    auto nextMid = (next->end - next->start) / 2 + next->start - offset;
+                    auto nextMid = (next->end - next->start) / 2 + next->start;
                     for (std::size_t i = thisMid; i < nextMid; i++)
                     {
                         widthTillNext += Text::consoleWidth(line[i]);
@@ -297,7 +316,7 @@ std::string pylir::Diag::DiagnosticsBuilder::emitMessage(const Message& message,
     for (std::size_t i = std::max<std::ptrdiff_t>(1, static_cast<std::ptrdiff_t>(*neededLines.begin()) - MARGIN);
          i < *neededLines.begin(); i++)
     {
-        result += fmt::format("{1: >{0}} | {2}\n", width, i, Text::toUTF8String(document.getLine(i)));
+        result += fmt::format("{1: >{0}} | {2}\n", width, i, document.getLine(i));
     }
     for (std::size_t i : neededLines)
     {
@@ -306,7 +325,7 @@ std::string pylir::Diag::DiagnosticsBuilder::emitMessage(const Message& message,
     }
     for (std::size_t i = largestLine + 1; i < largestLine + MARGIN + 1 && document.hasLine(i); i++)
     {
-        result += fmt::format("{1: >{0}} | {2}\n", width, i, Text::toUTF8String(document.getLine(i)));
+        result += fmt::format("{1: >{0}} | {2}\n", width, i, document.getLine(i));
     }
 
     return result;
@@ -6,11 +6,118 @@
 
 #include "Document.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PYLIR_DOCUMENT_SSE2
+#endif
+
+namespace
+{
+/// Returns the index of the first byte in 'text' that is either not ASCII or a carriage return. Everything before it
+/// can be taken over into the document as is.
+std::size_t findNonTrivialByte(std::string_view text)
+{
+    std::size_t i = 0;
+#ifdef PYLIR_DOCUMENT_SSE2
+    // The sign bit of every byte that is not ASCII is set, which is exactly what 'movemask' collects.
+    const auto carriageReturns = _mm_set1_epi8('\r');
+    for (; i + 16 <= text.size(); i += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+        auto mask = _mm_movemask_epi8(_mm_or_si128(block, _mm_cmpeq_epi8(block, carriageReturns)));
+        if (mask != 0)
+        {
+            for (; (mask & 1) == 0; mask >>= 1)
+            {
+                i++;
+            }
+            return i;
+        }
+    }
+#endif
+    for (; i < text.size(); i++)
+    {
+        if (static_cast<unsigned char>(text[i]) >= 0x80 || text[i] == '\r')
+        {
+            return i;
+        }
+    }
+    return i;
+}
+
+void appendUTF8(std::string& text, char32_t codepoint)
+{
+    auto utf8 = pylir::Text::toUTF8(codepoint);
+    // The unused trailing bytes are zero, but so is the encoding of U+0000. The lead byte is therefore used to
+    // determine the length of the encoding instead.
+    auto lead = static_cast<unsigned char>(utf8[0]);
+    std::size_t size = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+    text.append(utf8.data(), size);
+}
+} // namespace
+
 pylir::Diag::Document::Document(std::string input, std::string filename, pylir::Text::Encoding encoding)
-    : m_filename(std::move(filename)), m_input(std::move(input))
+    : m_filename(std::move(filename))
 {
-    std::string_view view = m_input;
+    std::string_view view = input;
     m_encoding = Text::readBOM(view).value_or(encoding);
+    if (m_encoding == Text::Encoding::UTF8)
+    {
+        // Most files are valid UTF-8 using only '\n' as newline. These are validated and then taken over without
+        // any copies.
+        std::string_view remaining = view;
+        while (!remaining.empty())
+        {
+            remaining.remove_prefix(findNonTrivialByte(remaining));
+            if (remaining.empty() || remaining.front() == '\r')
+            {
+                break;
+            }
+            auto copy = remaining;
+            bool legal;
+            Text::toUTF32(copy, &legal);
+            if (!legal)
+            {
+                break;
+            }
+            remaining = copy;
+        }
+        if (remaining.empty())
+        {
+            input.erase(0, input.size() - view.size());
+            m_text = std::move(input);
+            return;
+        }
+
+        // Otherwise, copy the valid prefix and normalize everything after.
+        m_text.reserve(view.size());
+        m_text.append(view.begin(), remaining.begin());
+        view = remaining;
+        while (!view.empty())
+        {
+            auto trivialEnd = findNonTrivialByte(view);
+            m_text.append(view.substr(0, trivialEnd));
+            view.remove_prefix(trivialEnd);
+            if (view.empty())
+            {
+                break;
+            }
+            if (view.front() == '\r')
+            {
+                view.remove_prefix(1);
+                if (!view.empty() && view.front() == '\n')
+                {
+                    view.remove_prefix(1);
+                }
+                m_text += '\n';
+                continue;
+            }
+            // Invalid sequences are replaced by the unicode replacement character.
+            appendUTF8(m_text, Text::toUTF32(view));
+        }
+        return;
+    }
+
     m_text.reserve(view.size());
     auto transcoder = Text::Transcoder<void, char32_t>(view, m_encoding);
     for (auto iter = transcoder.begin(); iter != transcoder.end();)
@@ -25,14 +132,45 @@ pylir::Diag::Document::Document(std::string input, std::string filename, pylir::
                     increment = 2;
                 }
                 m_text += '\n';
-                m_lineStarts.push_back(m_text.size());
                 std::advance(iter, increment);
                 break;
             }
-            case '\n': m_lineStarts.push_back(m_text.size() + 1); [[fallthrough]];
-            default: m_text += *iter++;
+            default: appendUTF8(m_text, *iter++);
+        }
+    }
+}
+
+void pylir::Diag::Document::computeLineStarts() const
+{
+    auto& lineStarts = m_lineTable->lineStarts;
+    // Reserve for an average line length of 32 characters instead of counting the newlines upfront, which would be a
+    // second pass over the whole text. The vector still grows if lines are shorter on average.
+    lineStarts.reserve(m_text.size() / 32 + 2);
+    lineStarts.push_back(0);
+    std::size_t i = 0;
+#ifdef PYLIR_DOCUMENT_SSE2
+    // Compare 16 bytes at a time. Newlines are rare enough that most blocks are skipped after one comparison.
+    const auto newlines = _mm_set1_epi8('\n');
+    for (; i + 16 <= m_text.size(); i += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_text.data() + i));
+        auto mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, newlines));
+        for (std::size_t j = 0; mask != 0; j++, mask >>= 1)
+        {
+            if (mask & 1)
+            {
+                lineStarts.push_back(i + j + 1);
+            }
+        }
+    }
+#endif
+    for (; i < m_text.size(); i++)
+    {
+        if (m_text[i] == '\n')
+        {
+            lineStarts.push_back(i + 1);
         }
     }
     // + 1 for imaginary newline that does not exist
-    m_lineStarts.push_back(m_text.size() + 1);
+    lineStarts.push_back(m_text.size() + 1);
 }
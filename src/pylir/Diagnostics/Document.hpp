@@ -10,8 +10,13 @@
 #include <pylir/Support/Text.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <tcb/span.hpp>
 
@@ -21,15 +26,129 @@ class Document
 {
     std::string m_filename;
     Text::Encoding m_encoding;
-    std::string m_input;
-    std::u32string m_text;
-    std::vector<std::size_t> m_lineStarts{0};
+    /// Text of the document in UTF-8 with all newlines normalized to '\n'. It is guaranteed to be valid UTF-8. All
+    /// offsets into the document are byte offsets into this string.
+    std::string m_text;
+
+    /// Offsets at which each line starts. Only computed on first use, as many documents are never asked for line
+    /// information. Held behind a pointer to keep the document movable.
+    struct LineTable
+    {
+        std::once_flag computed;
+        std::vector<std::size_t> lineStarts;
+        /// Line number of the last lookup. Consecutive queries tend to be on the same or the following line.
+        std::atomic<std::size_t> lastLine{1};
+    };
+    std::unique_ptr<LineTable> m_lineTable = std::make_unique<LineTable>();
+
+    void computeLineStarts() const;
+
+    [[nodiscard]] const std::vector<std::size_t>& lineStarts() const
+    {
+        std::call_once(m_lineTable->computed, [this] { computeLineStarts(); });
+        return m_lineTable->lineStarts;
+    }
+
+    static bool isContinuationByte(char value)
+    {
+        return (static_cast<unsigned char>(value) & 0xC0) == 0x80;
+    }
 
 public:
+    /// Bidirectional iterator decoding the UTF-8 text of a document into codepoints on the fly. The difference between
+    /// two iterators is in bytes, the same unit as all other offsets into the document.
+    class Iterator
+    {
+        const char* m_ptr = nullptr;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = char32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char32_t*;
+        using reference = char32_t;
+
+        Iterator() = default;
+
+        explicit Iterator(const char* ptr) : m_ptr(ptr) {}
+
+        /// Returns the position of the first byte of the current codepoint.
+        [[nodiscard]] const char* base() const
+        {
+            return m_ptr;
+        }
+
+        char32_t operator*() const
+        {
+            auto lead = static_cast<unsigned char>(m_ptr[0]);
+            if (lead < 0x80)
+            {
+                return lead;
+            }
+            auto continuation = [this](std::size_t index) -> char32_t
+            { return static_cast<unsigned char>(m_ptr[index]) & 0x3F; };
+            if (lead < 0xE0)
+            {
+                return (static_cast<char32_t>(lead & 0x1F) << 6) | continuation(1);
+            }
+            if (lead < 0xF0)
+            {
+                return (static_cast<char32_t>(lead & 0x0F) << 12) | (continuation(1) << 6) | continuation(2);
+            }
+            return (static_cast<char32_t>(lead & 0x07) << 18) | (continuation(1) << 12) | (continuation(2) << 6)
+                   | continuation(3);
+        }
+
+        Iterator& operator++()
+        {
+            auto lead = static_cast<unsigned char>(*m_ptr);
+            m_ptr += lead < 0x80 ? 1 : (lead < 0xE0 ? 2 : (lead < 0xF0 ? 3 : 4));
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        Iterator& operator--()
+        {
+            do
+            {
+                m_ptr--;
+            } while (isContinuationByte(*m_ptr));
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --(*this);
+            return copy;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.m_ptr - rhs.m_ptr;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.m_ptr == rhs.m_ptr;
+        }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.m_ptr != rhs.m_ptr;
+        }
+    };
+
     using value_type = char32_t;
-    using reference = const char32_t&;
-    using const_reference = const char32_t&;
-    using iterator = const char32_t*;
+    using reference = char32_t;
+    using const_reference = char32_t;
+    using iterator = Iterator;
     using const_iterator = iterator;
     using difference_type = std::ptrdiff_t;
     using size_type = std::size_t;
@@ -39,7 +158,7 @@ public:
 
     [[nodiscard]] iterator begin() const
     {
-        return m_text.data();
+        return iterator(m_text.data());
     }
 
     [[nodiscard]] const_iterator cbegin() const
@@ -49,7 +168,7 @@ public:
 
     [[nodiscard]] iterator end() const
     {
-        return m_text.data() + m_text.size();
+        return iterator(m_text.data() + m_text.size());
     }
 
     [[nodiscard]] const_iterator cend() const
@@ -59,43 +178,61 @@ public:
 
     [[nodiscard]] std::size_t getLineNumber(std::size_t offset) const
     {
-        auto result = std::lower_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
-        if (result != m_lineStarts.end() && *result == offset)
+        const auto& starts = lineStarts();
+        auto contains = [&](std::size_t line)
+        { return line < starts.size() && starts[line - 1] <= offset && offset < starts[line]; };
+        auto lastLine = m_lineTable->lastLine.load(std::memory_order_relaxed);
+        if (contains(lastLine))
         {
-            result++;
+            return lastLine;
         }
-        return result - m_lineStarts.begin();
+        std::size_t result;
+        if (contains(lastLine + 1))
+        {
+            result = lastLine + 1;
+        }
+        else
+        {
+            result = std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin();
+        }
+        m_lineTable->lastLine.store(result, std::memory_order_relaxed);
+        return result;
     }
 
     [[nodiscard]] std::size_t getColNumber(std::size_t offset) const
     {
-        auto lineNumber = getLineNumber(offset);
-        return offset - m_lineStarts[lineNumber - 1] + 1;
+        return getLineCol(offset).second;
     }
 
+    /// Returns the line and column of 'offset'. The column is counted in codepoints.
     [[nodiscard]] std::pair<std::size_t, std::size_t> getLineCol(std::size_t offset) const
     {
         auto lineNumber = getLineNumber(offset);
-        return {lineNumber, offset - m_lineStarts[lineNumber - 1] + 1};
+        auto lineStart = lineStarts()[lineNumber - 1];
+        auto lineText = std::string_view(m_text).substr(lineStart, offset - lineStart);
+        auto codepoints = static_cast<std::size_t>(std::count_if(
+            lineText.begin(), lineText.end(), [](char value) { return !isContinuationByte(value); }));
+        return {lineNumber, codepoints + (offset - lineStart - lineText.size()) + 1};
     }
 
-    [[nodiscard]] std::u32string_view getLine(std::size_t lineNumber) const
+    /// Returns the UTF-8 text of the line 'lineNumber', excluding the newline.
+    [[nodiscard]] std::string_view getLine(std::size_t lineNumber) const
     {
-        return std::u32string_view(m_text).substr(m_lineStarts[lineNumber - 1],
-                                                  m_lineStarts[lineNumber] - m_lineStarts[lineNumber - 1] - 1);
+        const auto& starts = lineStarts();
+        return std::string_view(m_text).substr(starts[lineNumber - 1], starts[lineNumber] - starts[lineNumber - 1] - 1);
     }
 
     [[nodiscard]] bool hasLine(std::size_t lineNumber) const
     {
-        return m_lineStarts.size() > lineNumber;
+        return lineStarts().size() > lineNumber;
     }
 
     [[nodiscard]] tcb::span<const std::size_t> getLineStarts() const
     {
-        return m_lineStarts;
+        return lineStarts();
     }
 
-    [[nodiscard]] std::u32string_view getText() const
+    [[nodiscard]] std::string_view getText() const
     {
         return m_text;
     }
@@ -19,7 +19,7 @@ namespace pylir::Diag
 ///
 /// `static std::pair<std::size_t, std::size_t> getRange` callable with `T` OR 'T' and 'void*':
 ///     This method HAS to be implemented and returns the source of range of T via two indices. These refer to the
-///     offset of the UTF32 text within the `Document` instance of the file `T` has been parsed in.
+///     byte offset of the UTF-8 text within the `Document` instance of the file `T` has been parsed in.
 ///     The first index refers to the inclusive start of 'T', while the second index refers to the exclusive end of 'T'
 ///     (in other words, the first index, that is not part of T. This may be one past the very last element in the
 ///      document).
@@ -6,23 +6,45 @@
 
 #include "Lexer.hpp"
 
+#include <llvm/Support/ThreadPool.h>
 #include <llvm/Support/UnicodeCharRanges.h>
 
 #include <pylir/Diagnostics/DiagnosticMessages.hpp>
 #include <pylir/Diagnostics/DiagnosticsBuilder.hpp>
 #include <pylir/Support/Util.hpp>
 
+#include <algorithm>
 #include <charconv>
+#include <future>
 #include <functional>
 #include <iterator>
 #include <locale>
+#include <string_view>
 #include <unordered_map>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PYLIR_LEXER_SSE2
+#endif
+
 pylir::Lexer::Lexer(const Diag::Document& document, int fieldId,
+                    std::function<void(Diag::DiagnosticsBuilder&& diagnosticsBuilder)> warningCallback,
+                    llvm::ThreadPool* threadPool)
+    : Lexer(document, fieldId, document.begin(), document.end(), std::move(warningCallback))
+{
+    if (threadPool)
+    {
+        lexInParallel(*threadPool);
+    }
+}
+
+pylir::Lexer::Lexer(const Diag::Document& document, int fileId, Diag::Document::const_iterator begin,
+                    Diag::Document::const_iterator end,
                     std::function<void(Diag::DiagnosticsBuilder&& diagnosticsBuilder)> warningCallback)
-    : m_fileId(fieldId),
+    : m_fileId(fileId),
       m_document(&document),
-      m_current(m_document->begin()),
+      m_current(begin),
+      m_end(end),
       m_warningCallback(std::move(warningCallback))
 {
 }
@@ -307,23 +329,118 @@ constexpr llvm::sys::UnicodeCharRange legalIdentifiers[] = {
 };
 #pragma endregion
 
+/// Equivalent to 'Text::isWhitespace', but avoids the unicode property lookup for ASCII characters, which make up the
+/// vast majority of whitespace in source files.
+bool isWhitespace(char32_t value)
+{
+    if (value < 0x80)
+    {
+        return (value >= 0x9 && value <= 0xd) || (value >= 0x1c && value <= 0x20);
+    }
+    return pylir::Text::isWhitespace(value);
+}
+
+// The functions below scan the UTF-8 bytes of the document for ASCII characters. None of the bytes of a multi-byte
+// sequence are ASCII, making it impossible to mistake them for one of the characters searched for.
+
+#ifdef PYLIR_LEXER_SSE2
+/// Returns the index of the lowest set bit within a non-zero 'movemask' result.
+std::size_t firstSetBit(int mask)
+{
+    std::size_t index = 0;
+    for (; (mask & 1) == 0; mask >>= 1)
+    {
+        index++;
+    }
+    return index;
+}
+#endif
+
+/// Returns the first newline in [begin, end) or 'end' if there is none.
+const char* findNewline(const char* begin, const char* end)
+{
+#ifdef PYLIR_LEXER_SSE2
+    const auto newlines = _mm_set1_epi8('\n');
+    for (; end - begin >= 16; begin += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        auto mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, newlines));
+        if (mask != 0)
+        {
+            return begin + firstSetBit(mask);
+        }
+    }
+#endif
+    return std::find(begin, end, '\n');
+}
+
+/// Returns the first byte in [begin, end) that is not a space or 'end' if there is none.
+const char* findNonSpace(const char* begin, const char* end)
+{
+#ifdef PYLIR_LEXER_SSE2
+    const auto spaces = _mm_set1_epi8(' ');
+    for (; end - begin >= 16; begin += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        auto mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(block, spaces)) & 0xFFFF;
+        if (mask != 0)
+        {
+            return begin + firstSetBit(mask);
+        }
+    }
+#endif
+    return std::find_if(begin, end, [](char value) { return value != ' '; });
+}
+
+/// Returns the first byte in [begin, end) within a string literal that needs special handling or 'end' if there is
+/// none. These are the 'quote' character, backslashes, newlines and, within a bytes literal, any non-ASCII byte.
+const char* findStringSpecial(const char* begin, const char* end, char quote, bool bytes)
+{
+#ifdef PYLIR_LEXER_SSE2
+    const auto quotes = _mm_set1_epi8(quote);
+    const auto backslashes = _mm_set1_epi8('\\');
+    const auto newlines = _mm_set1_epi8('\n');
+    // The sign bit of every non-ASCII byte is set, which is exactly what 'movemask' collects.
+    const auto nonAscii = bytes ? _mm_set1_epi8(static_cast<char>(0xFF)) : _mm_setzero_si128();
+    for (; end - begin >= 16; begin += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        auto special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quotes), _mm_cmpeq_epi8(block, backslashes)),
+                                    _mm_or_si128(_mm_cmpeq_epi8(block, newlines), _mm_and_si128(block, nonAscii)));
+        auto mask = _mm_movemask_epi8(special);
+        if (mask != 0)
+        {
+            return begin + firstSetBit(mask);
+        }
+    }
+#endif
+    return std::find_if(begin, end,
+                        [&](char value)
+                        {
+                            return value == quote || value == '\\' || value == '\n'
+                                   || (bytes && static_cast<unsigned char>(value) > 127);
+                        });
+}
+
 } // namespace
 
 bool pylir::Lexer::parseNext()
 {
-    if (m_current == m_document->end())
+    if (m_current == m_end)
     {
         return false;
     }
     do
     {
-        const auto *start = m_current;
+        auto start = m_current;
         switch (*m_current)
         {
             case U'#':
             {
-                m_current = std::find_if(m_current, m_document->end(), [](char32_t value) { return value == '\n'; });
-                if (m_current == m_document->end())
+                // Comments are skipped over their UTF-8 bytes without decoding. No byte within a multi-byte sequence
+                // can be mistaken for a newline.
+                m_current = Diag::Document::const_iterator(findNewline(m_current.base(), m_end.base()));
+                if (m_current == m_end)
                 {
                     break;
                 }
@@ -344,13 +461,13 @@ bool pylir::Lexer::parseNext()
             case U'\\':
             {
                 m_current++;
-                if (m_current == m_document->end())
+                if (m_current == m_end)
                 {
                     auto builder =
                         createDiagnosticsBuilder(m_current - m_document->begin(), Diag::UNEXPECTED_EOF_WHILE_PARSING)
                             .addLabel(m_current - m_document->begin(), "\\n", Diag::INSERT_COLOUR);
                     m_tokens.emplace_back(start - m_document->begin(), m_current - m_document->begin(), m_fileId,
-                                          TokenType::SyntaxError, builder.emitError());
+                                          TokenType::SyntaxError, m_values->insert(builder.emitError()));
                     return true;
                 }
                 if (*m_current != U'\n')
@@ -361,7 +478,7 @@ bool pylir::Lexer::parseNext()
                             .addLabel(m_current - m_document->begin(), "\\n", Diag::INSERT_COLOUR,
                                       Diag::emphasis::strikethrough);
                     m_tokens.emplace_back(start - m_document->begin(), m_current - m_document->begin(), m_fileId,
-                                          TokenType::SyntaxError, builder.emitError());
+                                          TokenType::SyntaxError, m_values->insert(builder.emitError()));
                     return true;
                 }
                 m_current++;
@@ -371,17 +488,17 @@ bool pylir::Lexer::parseNext()
             case U'U':
             {
                 m_current++;
-                if (m_current != m_document->end() && (*m_current == '\'' || *m_current == '"'))
+                if (m_current != m_end && (*m_current == '\'' || *m_current == '"'))
                 {
                     if (auto opt = parseLiteral(false, false))
                     {
                         m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId,
-                                              TokenType::StringLiteral, std::move(*opt));
+                                              TokenType::StringLiteral, m_values->insert(std::move(*opt)));
                     }
                     else
                     {
                         m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId,
-                                              TokenType::SyntaxError, std::move(opt).error());
+                                              TokenType::SyntaxError, m_values->insert(std::move(opt).error()));
                     }
                 }
                 else
@@ -397,19 +514,19 @@ bool pylir::Lexer::parseNext()
                 if (auto opt = parseLiteral(false, false))
                 {
                     m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId,
-                                          TokenType::StringLiteral, std::move(*opt));
+                                          TokenType::StringLiteral, m_values->insert(std::move(*opt)));
                 }
                 else
                 {
                     m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId,
-                                          TokenType::SyntaxError, std::move(opt).error());
+                                          TokenType::SyntaxError, m_values->insert(std::move(opt).error()));
                 }
                 break;
             }
             case U'r':
             case U'R':
             {
-                if (std::next(m_current) == m_document->end())
+                if (std::next(m_current) == m_end)
                 {
                     parseIdentifier();
                     break;
@@ -421,7 +538,7 @@ bool pylir::Lexer::parseNext()
                     case U'F':
                     {
                         auto maybeLiteral = std::next(m_current, 2);
-                        if (maybeLiteral == m_document->end() || (*maybeLiteral != U'\'' && *maybeLiteral != U'"'))
+                        if (maybeLiteral == m_end || (*maybeLiteral != U'\'' && *maybeLiteral != U'"'))
                         {
                             parseIdentifier();
                             break;
@@ -437,19 +554,19 @@ bool pylir::Lexer::parseNext()
                         if (auto opt = parseLiteral(true, false))
                         {
                             m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId,
-                                                  TokenType::StringLiteral, std::move(*opt));
+                                                  TokenType::StringLiteral, m_values->insert(std::move(*opt)));
                         }
                         else
                         {
                             m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId,
-                                                  TokenType::SyntaxError, std::move(opt).error());
+                                                  TokenType::SyntaxError, m_values->insert(std::move(opt).error()));
                         }
                         break;
                     }
                     case 'b':
                     case 'B':
                     {
-                        if (std::next(m_current, 2) == m_document->end())
+                        if (std::next(m_current, 2) == m_end)
                         {
                             parseIdentifier();
                             break;
@@ -466,12 +583,12 @@ bool pylir::Lexer::parseNext()
                         if (auto opt = parseLiteral(true, true))
                         {
                             m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId,
-                                                  TokenType::ByteLiteral, std::move(*opt));
+                                                  TokenType::ByteLiteral, m_values->insert(std::move(*opt)));
                         }
                         else
                         {
                             m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId,
-                                                  TokenType::SyntaxError, std::move(opt).error());
+                                                  TokenType::SyntaxError, m_values->insert(std::move(opt).error()));
                         }
                         break;
                     }
@@ -482,7 +599,7 @@ bool pylir::Lexer::parseNext()
             case U'b':
             case U'B':
             {
-                if (std::next(m_current) == m_document->end())
+                if (std::next(m_current) == m_end)
                 {
                     parseIdentifier();
                     break;
@@ -510,19 +627,19 @@ bool pylir::Lexer::parseNext()
                 if (auto opt = parseLiteral(raw, true))
                 {
                     m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId,
-                                          TokenType::ByteLiteral, std::move(*opt));
+                                          TokenType::ByteLiteral, m_values->insert(std::move(*opt)));
                 }
                 else
                 {
                     m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId,
-                                          TokenType::SyntaxError, std::move(opt).error());
+                                          TokenType::SyntaxError, m_values->insert(std::move(opt).error()));
                 }
                 break;
             }
                 //            case U'f':
                 //            case U'F':
                 //            {
-                //                if (std::next(m_current) != m_document->end()
+                //                if (std::next(m_current) != m_end
                 //                    && (*std::next(m_current) == '"' || *std::next(m_current) == '\''))
                 //                {
                 //                    // TODO: parse format string
@@ -536,7 +653,7 @@ bool pylir::Lexer::parseNext()
                 //            }
             case U'.':
             {
-                if (std::next(m_current) == m_document->end() || *std::next(m_current) < U'0'
+                if (std::next(m_current) == m_end || *std::next(m_current) < U'0'
                    || *std::next(m_current) > U'9')
                 {
                     m_current++;
@@ -561,12 +678,12 @@ bool pylir::Lexer::parseNext()
             }
             case U'-':
             {
-                if (std::next(m_current) != m_document->end() && *std::next(m_current) == U'=')
+                if (std::next(m_current) != m_end && *std::next(m_current) == U'=')
                 {
                     std::advance(m_current, 2);
                     m_tokens.emplace_back(start - m_document->begin(), 2, m_fileId, TokenType::MinusAssignment);
                 }
-                else if (std::next(m_current) != m_document->end() && *std::next(m_current) == U'>')
+                else if (std::next(m_current) != m_end && *std::next(m_current) == U'>')
                 {
                     std::advance(m_current, 2);
                     m_tokens.emplace_back(start - m_document->begin(), 2, m_fileId, TokenType::Arrow);
@@ -602,12 +719,12 @@ bool pylir::Lexer::parseNext()
                         default: PYLIR_UNREACHABLE;
                     }
                 }();
-                if (std::next(m_current) == m_document->end() || *std::next(m_current) != U'=')
+                if (std::next(m_current) == m_end || *std::next(m_current) != U'=')
                 {
                     m_current++;
                     m_tokens.emplace_back(start - m_document->begin(), 1, m_fileId, normal);
                 }
-                else if (std::next(m_current) != m_document->end())
+                else if (std::next(m_current) != m_end)
                 {
                     std::advance(m_current, 2);
                     m_tokens.emplace_back(start - m_document->begin(), 2, m_fileId, assignment);
@@ -638,10 +755,10 @@ bool pylir::Lexer::parseNext()
                         default: PYLIR_UNREACHABLE;
                     }
                 }();
-                if (std::next(m_current) != m_document->end() && *std::next(m_current) == *m_current)
+                if (std::next(m_current) != m_end && *std::next(m_current) == *m_current)
                 {
                     m_current++;
-                    if (std::next(m_current) != m_document->end() && *std::next(m_current) == U'=')
+                    if (std::next(m_current) != m_end && *std::next(m_current) == U'=')
                     {
                         std::advance(m_current, 2);
                         m_tokens.emplace_back(start - m_document->begin(), 3, m_fileId, twiceAss);
@@ -652,7 +769,7 @@ bool pylir::Lexer::parseNext()
                         m_tokens.emplace_back(start - m_document->begin(), 2, m_fileId, twice);
                     }
                 }
-                else if (std::next(m_current) != m_document->end() && *std::next(m_current) == U'=')
+                else if (std::next(m_current) != m_end && *std::next(m_current) == U'=')
                 {
                     std::advance(m_current, 2);
                     m_tokens.emplace_back(start - m_document->begin(), 2, m_fileId, singleAss);
@@ -716,7 +833,7 @@ bool pylir::Lexer::parseNext()
                 m_tokens.emplace_back(start - m_document->begin(), 1, m_fileId, TokenType::SemiColon);
                 break;
             case U'!':
-                if (std::next(m_current) != m_document->end() && *std::next(m_current) == U'=')
+                if (std::next(m_current) != m_end && *std::next(m_current) == U'=')
                 {
                     std::advance(m_current, 2);
                     m_tokens.emplace_back(start - m_document->begin(), 2, m_fileId, TokenType::NotEqual);
@@ -725,9 +842,9 @@ bool pylir::Lexer::parseNext()
                 [[fallthrough]];
             default:
             {
-                if (Text::isWhitespace(*m_current))
+                if (isWhitespace(*m_current))
                 {
-                    m_current = std::find_if_not(m_current, m_document->end(), Text::isWhitespace);
+                    m_current = std::find_if_not(m_current, m_end, isWhitespace);
                     continue;
                 }
                 parseIdentifier();
@@ -735,8 +852,8 @@ bool pylir::Lexer::parseNext()
             }
         }
         break;
-    } while (m_current != m_document->end());
-    if (m_current == m_document->end())
+    } while (m_current != m_end);
+    if (m_current == m_end)
     {
         m_tokens.emplace_back(m_current - m_document->begin(), 0, m_fileId, TokenType::Newline);
         parseIndent();
@@ -744,73 +861,101 @@ bool pylir::Lexer::parseNext()
     return true;
 }
 
+namespace
+{
+bool isASCIIInitialCharacter(char32_t value)
+{
+    return (value >= U'a' && value <= U'z') || (value >= U'A' && value <= U'Z') || value == U'_';
+}
+
+bool isASCIIIdentifierCharacter(char32_t value)
+{
+    return isASCIIInitialCharacter(value) || (value >= U'0' && value <= U'9');
+}
+} // namespace
+
 void pylir::Lexer::parseIdentifier()
 {
     static auto initialCharacterSet = llvm::sys::UnicodeCharSet(initialCharacters);
-    if (!initialCharacterSet.contains(*m_current))
+    if (*m_current < 0x80 ? !isASCIIInitialCharacter(*m_current) : !initialCharacterSet.contains(*m_current))
     {
+        auto next = std::next(m_current);
         auto builder = createDiagnosticsBuilder(m_current - m_document->begin(), Diag::UNEXPECTED_CHARACTER_N,
-                                                Text::toUTF8String({&*m_current, 1}))
+                                                std::string(m_current.base(), next.base()))
                            .addLabel(m_current - m_document->begin(), std::nullopt, Diag::ERROR_COLOUR);
-        m_tokens.emplace_back(m_current - m_document->begin(), 1, m_fileId, TokenType::SyntaxError,
-                              builder.emitError());
-        m_current++;
+        m_tokens.emplace_back(m_current - m_document->begin(), next - m_current, m_fileId, TokenType::SyntaxError,
+                              m_values->insert(builder.emitError()));
+        m_current = next;
         return;
     }
     static auto legalIdentifierSet = llvm::sys::UnicodeCharSet(legalIdentifiers);
-    const auto *start = m_current;
-    m_current = std::find_if_not(m_current, m_document->end(),
-                                 [&](char32_t value) { return legalIdentifierSet.contains(value); });
-    auto utf32 = std::u32string_view{start, static_cast<std::size_t>(m_current - start)};
-    static std::unordered_map<std::u32string_view, TokenType> keywords = {
-        {U"False", TokenType::FalseKeyword},
-        {U"None", TokenType::NoneKeyword},
-        {U"True", TokenType::TrueKeyword},
-        {U"and", TokenType::AndKeyword},
-        {U"as", TokenType::AsKeyword},
-        {U"assert", TokenType::AssertKeyword},
-        {U"async", TokenType::AsyncKeyword},
-        {U"await", TokenType::AwaitKeyword},
-        {U"break", TokenType::BreakKeyword},
-        {U"class", TokenType::ClassKeyword},
-        {U"continue", TokenType::ContinueKeyword},
-        {U"def", TokenType::DefKeyword},
-        {U"del", TokenType::DelKeyword},
-        {U"elif", TokenType::ElifKeyword},
-        {U"else", TokenType::ElseKeyword},
-        {U"except", TokenType::ExceptKeyword},
-        {U"finally", TokenType::FinallyKeyword},
-        {U"for", TokenType::ForKeyword},
-        {U"from", TokenType::FromKeyword},
-        {U"global", TokenType::GlobalKeyword},
-        {U"if", TokenType::IfKeyword},
-        {U"import", TokenType::ImportKeyword},
-        {U"in", TokenType::InKeyword},
-        {U"is", TokenType::IsKeyword},
-        {U"lambda", TokenType::LambdaKeyword},
-        {U"nonlocal", TokenType::NonlocalKeyword},
-        {U"not", TokenType::NotKeyword},
-        {U"or", TokenType::OrKeyword},
-        {U"pass", TokenType::PassKeyword},
-        {U"raise", TokenType::RaiseKeyword},
-        {U"return", TokenType::ReturnKeyword},
-        {U"try", TokenType::TryKeyword},
-        {U"while", TokenType::WhileKeyword},
-        {U"with", TokenType::WithKeyword},
-        {U"yield", TokenType::YieldKeyword},
+    auto start = m_current;
+    // The vast majority of identifiers are pure ASCII. These are checked without the binary search within the unicode
+    // character set and don't require normalization either, as NFKC leaves ASCII unchanged.
+    bool isASCII = true;
+    m_current = std::find_if_not(m_current, m_end,
+                                 [&](char32_t value)
+                                 {
+                                     if (value < 0x80)
+                                     {
+                                         return isASCIIIdentifierCharacter(value);
+                                     }
+                                     isASCII = false;
+                                     return legalIdentifierSet.contains(value);
+                                 });
+    auto utf8 = std::string_view{start.base(), static_cast<std::size_t>(m_current - start)};
+    static std::unordered_map<std::string_view, TokenType> keywords = {
+        {"False", TokenType::FalseKeyword},
+        {"None", TokenType::NoneKeyword},
+        {"True", TokenType::TrueKeyword},
+        {"and", TokenType::AndKeyword},
+        {"as", TokenType::AsKeyword},
+        {"assert", TokenType::AssertKeyword},
+        {"async", TokenType::AsyncKeyword},
+        {"await", TokenType::AwaitKeyword},
+        {"break", TokenType::BreakKeyword},
+        {"class", TokenType::ClassKeyword},
+        {"continue", TokenType::ContinueKeyword},
+        {"def", TokenType::DefKeyword},
+        {"del", TokenType::DelKeyword},
+        {"elif", TokenType::ElifKeyword},
+        {"else", TokenType::ElseKeyword},
+        {"except", TokenType::ExceptKeyword},
+        {"finally", TokenType::FinallyKeyword},
+        {"for", TokenType::ForKeyword},
+        {"from", TokenType::FromKeyword},
+        {"global", TokenType::GlobalKeyword},
+        {"if", TokenType::IfKeyword},
+        {"import", TokenType::ImportKeyword},
+        {"in", TokenType::InKeyword},
+        {"is", TokenType::IsKeyword},
+        {"lambda", TokenType::LambdaKeyword},
+        {"nonlocal", TokenType::NonlocalKeyword},
+        {"not", TokenType::NotKeyword},
+        {"or", TokenType::OrKeyword},
+        {"pass", TokenType::PassKeyword},
+        {"raise", TokenType::RaiseKeyword},
+        {"return", TokenType::ReturnKeyword},
+        {"try", TokenType::TryKeyword},
+        {"while", TokenType::WhileKeyword},
+        {"with", TokenType::WithKeyword},
+        {"yield", TokenType::YieldKeyword},
     };
-    if (auto result = keywords.find(utf32); result != keywords.end())
+    if (auto result = keywords.find(utf8); result != keywords.end())
     {
         m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId, result->second);
         return;
     }
 
-    auto normalized = Text::normalize(utf32, Text::Normalization::NFKC);
-    [[maybe_unused]] bool ok;
-    auto utf8 = Text::toUTF8String(normalized, &ok);
-    PYLIR_ASSERT(ok);
+    if (isASCII)
+    {
+        m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId, TokenType::Identifier,
+                              m_values->insertIdentifier(std::string(utf8)));
+        return;
+    }
+
     m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId, TokenType::Identifier,
-                          std::move(utf8));
+                          m_values->insertIdentifier(Text::normalize(utf8, Text::Normalization::NFKC)));
 }
 
 namespace
@@ -884,7 +1029,7 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
 {
     bool longString = false;
     auto character = *m_current++;
-    if (m_current != m_document->end() && std::next(m_current) != m_document->end())
+    if (m_current != m_end && std::next(m_current) != m_end)
     {
         if (std::array{*m_current, *std::next(m_current)} == std::array{character, character})
         {
@@ -897,7 +1042,7 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
     {
         if (!longString)
         {
-            if (m_current == m_document->end())
+            if (m_current == m_end)
             {
                 auto builder =
                     createDiagnosticsBuilder(m_current - m_document->begin(), Diag::EXPECTED_END_OF_LITERAL)
@@ -911,10 +1056,10 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
             }
             return false;
         }
-        if (m_current == m_document->end() || std::next(m_current) == m_document->end()
-            || std::next(m_current, 2) == m_document->end())
+        if (m_current == m_end || std::next(m_current) == m_end
+            || std::next(m_current, 2) == m_end)
         {
-            while (m_current != m_document->end())
+            while (m_current != m_end)
             {
                 m_current = std::next(m_current);
             }
@@ -931,7 +1076,24 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
         }
         return false;
     };
-    std::u32string result;
+    std::string result;
+    // Bytes literals contain every value as a single byte, while string literals are encoded in UTF-8.
+    auto append = [&](char32_t value)
+    {
+        if (bytes || value < 0x80)
+        {
+            result += static_cast<char>(value);
+            return;
+        }
+        for (auto character : Text::toUTF8(value))
+        {
+            if (!character)
+            {
+                break;
+            }
+            result += character;
+        }
+    };
     tl::expected<bool, std::string> success;
 
     auto diagnoseNonAscii = [&]
@@ -963,12 +1125,12 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
             {
                 if (raw)
                 {
-                    result += *m_current;
+                    append(*m_current);
                     m_current++;
                     break;
                 }
                 m_current++;
-                if (m_current == m_document->end())
+                if (m_current == m_end)
                 {
                     continue;
                 }
@@ -978,7 +1140,7 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                     case '"':
                     case '\\':
                     {
-                        result += *m_current;
+                        append(*m_current);
                         m_current++;
                         break;
                     }
@@ -1000,7 +1162,7 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                             case 'v': escape = '\v'; break;
                             default: PYLIR_UNREACHABLE;
                         }
-                        result += escape;
+                        append(escape);
                         m_current++;
                         break;
                     }
@@ -1008,51 +1170,48 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                     {
                         m_current++;
                         result += '\n';
-                        std::size_t count = 0;
-                        while (std::next(m_current, count) != m_document->end() && count != sizeof("ewline") - 1)
-                        {
-                            count++;
-                        }
-                        if (std::u32string_view(std::prev(m_current), count + 1) == U"newline")
+                        constexpr std::string_view rest = "ewline";
+                        auto remaining = static_cast<std::size_t>(m_end - m_current);
+                        if (std::string_view(m_current.base(), std::min(remaining, rest.size())) == rest)
                         {
-                            std::advance(m_current, count);
+                            m_current = Diag::Document::const_iterator(m_current.base() + rest.size());
                         }
                         break;
                     }
                     case 'x':
                     {
                         m_current++;
-                        if (m_current == m_document->end())
+                        if (m_current == m_end)
                         {
                             // TODO deprecation
-                            result += U"\\x";
+                            result += "\\x";
                             break;
                         }
                         if (!isHex(*m_current))
                         {
                             // TODO deprecation
-                            result += U"\\x";
-                            result += *m_current;
+                            result += "\\x";
+                            append(*m_current);
                             break;
                         }
                         m_current++;
-                        if (m_current == m_document->end())
+                        if (m_current == m_end)
                         {
                             // TODO deprecation
-                            result += U"\\x";
-                            result += *std::prev(m_current);
+                            result += "\\x";
+                            append(*std::prev(m_current));
                             break;
                         }
                         if (!isHex(*m_current))
                         {
                             // TODO deprecation
-                            result += U"\\x";
-                            result += *std::prev(m_current);
-                            result += *m_current;
+                            result += "\\x";
+                            append(*std::prev(m_current));
+                            append(*m_current);
                             break;
                         }
                         char32_t unicode = fromHex(*std::prev(m_current)) * 16 + fromHex(*m_current);
-                        result += unicode;
+                        append(unicode);
                         m_current++;
                         break;
                     }
@@ -1067,13 +1226,13 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                     {
                         char32_t value = 0;
                         std::size_t count = 0;
-                        while (count < 3 && m_current != m_document->end() && *m_current >= '0' && *m_current <= '7')
+                        while (count < 3 && m_current != m_end && *m_current >= '0' && *m_current <= '7')
                         {
                             value = value * 8 + *m_current - U'0';
                             m_current++;
                             count++;
                         }
-                        result += value;
+                        append(value);
                         break;
                     }
                     case 'u':
@@ -1081,8 +1240,8 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                     {
                         if (bytes)
                         {
-                            result += U"\\";
-                            result += *m_current;
+                            result += "\\";
+                            append(*m_current);
                             m_current++;
                             break;
                         }
@@ -1091,7 +1250,7 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                         std::size_t size = big ? 8 : 4;
                         std::size_t count = 0;
                         char32_t value = 0;
-                        while (count < size && m_current != m_document->end() && isHex(*m_current))
+                        while (count < size && m_current != m_end && isHex(*m_current))
                         {
                             value = value * 16 + fromHex(*m_current);
                             m_current++;
@@ -1122,22 +1281,22 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                                               Diag::ERROR_COMPLY);
                             return tl::unexpected{builder.emitError()};
                         }
-                        result += value;
+                        append(value);
                         break;
                     }
                     case 'N':
                     {
                         if (bytes)
                         {
-                            result += U"\\N";
+                            result += "\\N";
                             m_current++;
                             break;
                         }
                         m_current++;
-                        if (m_current == m_document->end() || *m_current != '{')
+                        if (m_current == m_end || *m_current != '{')
                         {
                             std::optional<Diag::emphasis> emphasis;
-                            if (m_current != m_document->end())
+                            if (m_current != m_end)
                             {
                                 emphasis = Diag::emphasis::strikethrough;
                             }
@@ -1151,9 +1310,8 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                             return tl::unexpected{builder.emitError()};
                         }
                         m_current++;
-                        const auto *closing = std::find(m_current, m_document->end(), U'}');
-                        auto utf8Name = Text::toUTF8String(
-                            std::u32string_view{m_current, static_cast<std::size_t>(closing - m_current)});
+                        auto closing = std::find(m_current, m_end, U'}');
+                        auto utf8Name = std::string(m_current.base(), closing.base());
                         auto codepoint = Text::fromName(utf8Name);
                         if (!codepoint)
                         {
@@ -1164,17 +1322,17 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                                               std::nullopt, Diag::ERROR_COLOUR)
                                     .addLabel(m_current - m_document->begin() - 2, m_current - m_document->begin() - 1,
                                               std::nullopt, Diag::ERROR_COMPLY);
-                            if (closing != m_document->end())
+                            if (closing != m_end)
                             {
                                 builder.addLabel(closing - m_document->begin(), std::nullopt, Diag::ERROR_COMPLY);
                             }
                             return tl::unexpected{builder.emitError()};
                         }
-                        if (closing != m_document->end())
+                        if (closing != m_end)
                         {
                             closing++;
                         }
-                        result += *codepoint;
+                        append(*codepoint);
                         m_current = closing;
                         break;
                     }
@@ -1185,7 +1343,7 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                             return diagnoseNonAscii();
                         }
                         result += '\\';
-                        result += *m_current;
+                        append(*m_current);
                         m_current++;
                         // TODO deprecation warning
                         break;
@@ -1203,40 +1361,59 @@ tl::expected<std::string, std::string> pylir::Lexer::parseLiteral(bool raw, bool
                                       Diag::emphasis::strikethrough);
                     return tl::unexpected{builder.emitError()};
                 }
-                result += *m_current;
+                append(*m_current);
                 m_current++;
                 break;
             }
             default:
+            {
                 if (bytes && *m_current > 127)
                 {
                     return diagnoseNonAscii();
                 }
-                result += *m_current;
+                append(*m_current);
                 m_current++;
+                // Skip ahead to the next character that might need special handling and append everything before it
+                // at once.
+                const auto* runEnd =
+                    findStringSpecial(m_current.base(), m_end.base(), static_cast<char>(character), bytes);
+                result.append(m_current.base(), runEnd);
+                m_current = Diag::Document::const_iterator(runEnd);
                 break;
+            }
         }
     }
     if (!success)
     {
         return tl::unexpected{std::move(success).error()};
     }
-    if (bytes)
+    return result;
+}
+
+namespace
+{
+/// Converts the digits in 'text' to an integer. Most literals fit into 64 bit, which are returned as is instead of
+/// going through the arbitrary precision radix conversion.
+std::variant<std::uint64_t, pylir::BigInt> parseInteger(const std::string& text, unsigned radix)
+{
+    std::uint64_t value;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value, radix);
+    if (ec == std::errc{} && ptr == text.data() + text.size())
     {
-        std::string byteConverted(result.begin(), result.end());
-        return byteConverted;
+        return value;
     }
-    return Text::toUTF8String(result);
+    return pylir::BigInt(text, radix);
 }
+} // namespace
 
 void pylir::Lexer::parseNumber()
 {
-    const auto *start = m_current;
-    PYLIR_ASSERT(m_current != m_document->end());
+    auto start = m_current;
+    PYLIR_ASSERT(m_current != m_end);
     bool (*allowedDigits)(char32_t) = +[](char32_t value) { return value >= U'0' && value <= U'9'; };
     unsigned radix = 10;
     bool isFloat = false;
-    if (*m_current == U'0' && std::next(m_current) != m_document->end())
+    if (*m_current == U'0' && std::next(m_current) != m_end)
     {
         switch (*std::next(m_current))
         {
@@ -1283,8 +1460,8 @@ void pylir::Lexer::parseNumber()
             default: break;
         }
     }
-    const auto *numberStart = m_current;
-    const auto *end = std::find_if_not(m_current, m_document->end(),
+    auto numberStart = m_current;
+    auto end = std::find_if_not(m_current, m_end,
                                 [allowedDigits, previous = U'\0', &isFloat, radix](char32_t value) mutable
                                 {
                                     if (value == U'.' && radix == 10)
@@ -1313,14 +1490,14 @@ void pylir::Lexer::parseNumber()
     {
         auto builder =
             createDiagnosticsBuilder(end - m_document->begin() - 1, Diag::UNDERSCORE_ONLY_ALLOWED_BETWEEN_DIGITS)
-                .addLabel(end - 1 - m_document->begin(), std::nullopt, Diag::ERROR_COLOUR)
+                .addLabel(end - m_document->begin() - 1, std::nullopt, Diag::ERROR_COLOUR)
                 .addLabel(start - m_document->begin(), end - m_document->begin() - 2, std::nullopt, Diag::ERROR_COMPLY);
         m_tokens.emplace_back(start - m_document->begin(), end - start, m_fileId, TokenType::SyntaxError,
-                              builder.emitError());
+                              m_values->insert(builder.emitError()));
         return;
     }
     std::string text;
-    for (auto codepoint : std::u32string_view{numberStart, static_cast<std::size_t>(end - numberStart)})
+    for (auto codepoint : std::string_view{numberStart.base(), static_cast<std::size_t>(end - numberStart)})
     {
         if (codepoint != U'_')
         {
@@ -1330,38 +1507,43 @@ void pylir::Lexer::parseNumber()
     auto checkSuffix = [&]
     {
         static auto legalIdentifierSet = llvm::sys::UnicodeCharSet(legalIdentifiers);
-        const auto *suffixEnd = std::find_if_not(m_current, m_document->end(),
+        auto suffixEnd = std::find_if_not(m_current, m_end,
                                           [&](char32_t value) { return legalIdentifierSet.contains(value); });
         if (suffixEnd != m_current)
         {
             auto builder = createDiagnosticsBuilder(
                                m_current - m_document->begin(), Diag::INVALID_INTEGER_SUFFIX,
-                               Text::toUTF8String({m_current, static_cast<std::size_t>(suffixEnd - m_current)}))
+                               std::string(m_current.base(), suffixEnd.base()))
                                .addLabel(start - m_document->begin(), m_current - m_document->begin() - 1, std::nullopt,
                                          Diag::ERROR_COMPLY)
                                .addLabel(m_current - m_document->begin(), suffixEnd - m_document->begin() - 1,
                                          std::nullopt, Diag::ERROR_COLOUR, Diag::emphasis::strikethrough);
             m_tokens.emplace_back(m_current - m_document->begin(), suffixEnd - m_current, m_fileId,
-                                  TokenType::SyntaxError, builder.emitError());
+                                  TokenType::SyntaxError, m_values->insert(builder.emitError()));
             m_current = suffixEnd;
             return;
         }
     };
-    isFloat = isFloat || (end != m_document->end() && (*end == U'e' || *end == U'E'));
+    isFloat = isFloat || (end != m_end && (*end == U'e' || *end == U'E'));
     if (!isFloat)
     {
-        BigInt integer(text, radix);
-        if (radix == 10 && m_current != m_document->end() && (*m_current == U'j' || *m_current == U'J'))
+        auto integer = parseInteger(text, radix);
+        if (radix == 10 && m_current != m_end && (*m_current == U'j' || *m_current == U'J'))
         {
             m_current++;
+            auto value = pylir::match(
+                integer, [](std::uint64_t small) { return static_cast<double>(small); },
+                [](const BigInt& big) { return big.roundToDouble(); });
             m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId, TokenType::ComplexLiteral,
-                                  integer.roundToDouble());
+                                  m_values->insert(value));
             checkSuffix();
             return;
         }
-        if (radix == 10 && !integer.isZero() && text.front() == '0')
+        bool isZero = pylir::match(
+            integer, [](std::uint64_t small) { return small == 0; }, [](const BigInt& big) { return big.isZero(); });
+        if (radix == 10 && !isZero && text.front() == '0')
         {
-            const auto *leadingEnd =
+            auto leadingEnd =
                 std::find_if_not(numberStart, end, [](char32_t value) { return value == U'_' || value == U'0'; });
             auto builder =
                 createDiagnosticsBuilder(end - m_document->begin() - 1, Diag::NUMBER_WITH_LEADING_ZEROS_NOT_ALLOWED)
@@ -1373,11 +1555,18 @@ void pylir::Lexer::parseNumber()
                     .addLabel(numberStart - m_document->begin(), leadingEnd - m_document->begin() - 1, std::nullopt,
                               Diag::NOTE_COMPLY, Diag::emphasis::strikethrough);
             m_tokens.emplace_back(start - m_document->begin(), end - start, m_fileId, TokenType::SyntaxError,
-                                  builder.emitError());
+                                  m_values->insert(builder.emitError()));
             return;
         }
-        m_tokens.emplace_back(start - m_document->begin(), end - start, m_fileId, TokenType::IntegerLiteral,
-                              std::move(integer));
+        if (auto* small = std::get_if<std::uint64_t>(&integer))
+        {
+            m_tokens.emplace_back(start - m_document->begin(), end - start, m_fileId, *small);
+        }
+        else
+        {
+            m_tokens.emplace_back(start - m_document->begin(), end - start, m_fileId, TokenType::IntegerLiteral,
+                                  m_values->insert(pylir::get<BigInt>(std::move(integer))));
+        }
         checkSuffix();
         return;
     }
@@ -1386,16 +1575,16 @@ void pylir::Lexer::parseNumber()
     {
         text.insert(text.begin(), '0');
     }
-    if (end != m_document->end() && (*end == U'e' || *end == U'E'))
+    if (end != m_end && (*end == U'e' || *end == U'E'))
     {
         text += U'e';
         end++;
-        if (end != m_document->end() && (*end == U'+' || *end == U'-'))
+        if (end != m_end && (*end == U'+' || *end == U'-'))
         {
             text += *end;
             end++;
         }
-        const auto *newEnd = std::find_if_not(end, m_document->end(),
+        auto newEnd = std::find_if_not(end, m_end,
                                        [previous = U'\0', allowedDigits](char32_t value) mutable
                                        {
                                            if (value == U'_')
@@ -1417,10 +1606,10 @@ void pylir::Lexer::parseNumber()
                                          Diag::ERROR_COMPLY)
                                .addLabel(end - m_document->begin(), std::nullopt, Diag::ERROR_COLOUR);
             m_tokens.emplace_back(start - m_document->begin(), end - start, m_fileId, TokenType::SyntaxError,
-                                  builder.emitError());
+                                  m_values->insert(builder.emitError()));
             return;
         }
-        for (auto codepoint : std::u32string_view{end, static_cast<std::size_t>(newEnd - end)})
+        for (auto codepoint : std::string_view{end.base(), static_cast<std::size_t>(newEnd - end)})
         {
             if (codepoint != U'_')
             {
@@ -1460,24 +1649,33 @@ void pylir::Lexer::parseNumber()
     reset.reset();
 #endif
     auto tokenType = TokenType::FloatingPointLiteral;
-    if (m_current != m_document->end() && (*m_current == U'j' || *m_current == U'J'))
+    if (m_current != m_end && (*m_current == U'j' || *m_current == U'J'))
     {
         m_current++;
         tokenType = TokenType::ComplexLiteral;
     }
-    m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId, tokenType, number);
+    m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId, tokenType,
+                          m_values->insert(number));
     checkSuffix();
 }
 
 void pylir::Lexer::parseIndent()
 {
-    const auto *start = m_current;
+    auto start = m_current;
     std::size_t indent = 0;
-    for (; m_current != m_document->end() && Text::isWhitespace(*m_current); m_current++)
+    while (m_current != m_end && isWhitespace(*m_current))
     {
         switch (*m_current)
         {
             case U'\n': return;
+            case U' ':
+            {
+                // Indentation mostly consists of spaces, which are skipped all at once.
+                const auto* spacesEnd = findNonSpace(m_current.base(), m_end.base());
+                indent += spacesEnd - m_current.base();
+                m_current = Diag::Document::const_iterator(spacesEnd);
+                continue;
+            }
             case U'\t':
                 if (indent % 8 == 0)
                 {
@@ -1490,6 +1688,7 @@ void pylir::Lexer::parseIndent()
                 break;
             default: indent++;
         }
+        m_current++;
     }
     if (indent < m_indentation.top().first)
     {
@@ -1520,7 +1719,7 @@ void pylir::Lexer::parseIndent()
                     .addLabel(m_tokens[m_indentation.top().second], std::nullopt, Diag::NOTE_COLOUR);
             }
             m_tokens.emplace_back(start - m_document->begin(), m_current - start, m_fileId, TokenType::SyntaxError,
-                                  builder.emitError());
+                                  m_values->insert(builder.emitError()));
         }
     }
     else if (indent > m_indentation.top().first)
@@ -1529,3 +1728,226 @@ void pylir::Lexer::parseIndent()
         m_indentation.emplace(indent, m_tokens.size() - 1);
     }
 }
+
+namespace
+{
+/// Returns true if the string literal whose quote is at 'quote' is a raw string literal, in the same way as the lexer
+/// would lex it.
+bool isRawStringPrefix(const char* begin, const char* quote)
+{
+    auto isPrefixCharacter = [](char32_t value)
+    {
+        switch (value)
+        {
+            case U'r':
+            case U'R':
+            case U'b':
+            case U'B': return true;
+            default: return false;
+        }
+    };
+    const auto* prefixStart = quote;
+    while (prefixStart != begin && quote - prefixStart < 2 && isPrefixCharacter(*std::prev(prefixStart)))
+    {
+        prefixStart--;
+    }
+    if (prefixStart != begin
+        && (static_cast<unsigned char>(*std::prev(prefixStart)) >= 0x80
+            || isASCIIIdentifierCharacter(*std::prev(prefixStart))))
+    {
+        // Part of an identifier and not a prefix.
+        return false;
+    }
+    auto isR = [](char32_t value) { return value == U'r' || value == U'R'; };
+    switch (quote - prefixStart)
+    {
+        case 1: return isR(prefixStart[0]);
+        // Either 'rb' or 'br' in any casing.
+        case 2: return isR(prefixStart[0]) != isR(prefixStart[1]);
+        default: return false;
+    }
+}
+
+/// Returns the start of every line in [begin, end) that starts a new top level statement. These are lines starting
+/// with a character other than whitespace or a comment, that are not within brackets, a string literal or the
+/// continuation of a previous line. The lexer is in the exact same state at these positions as at the start of a file.
+/// Operates on the UTF-8 bytes of the document, as all characters of interest are ASCII.
+std::vector<const char*> findTopLevelStatements(const char* begin, const char* end)
+{
+    std::vector<const char*> result;
+    std::size_t depth = 0;
+    bool lineStart = false;
+    for (const auto* iter = begin; iter != end;)
+    {
+        if (lineStart)
+        {
+            lineStart = false;
+            if (depth == 0 && !isWhitespace(*pylir::Diag::Document::const_iterator(iter)) && *iter != '#')
+            {
+                result.push_back(iter);
+            }
+        }
+        switch (*iter)
+        {
+            case U'#': iter = findNewline(iter, end); break;
+            case U'\n':
+                iter++;
+                lineStart = true;
+                break;
+            case U'\\':
+                // A line continuation. Skip the newline so that the next line is not treated as line start.
+                iter = std::min(iter + 2, end);
+                break;
+            case U'(':
+            case U'[':
+            case U'{':
+                depth++;
+                iter++;
+                break;
+            case U')':
+            case U']':
+            case U'}':
+                if (depth != 0)
+                {
+                    depth--;
+                }
+                iter++;
+                break;
+            case U'\'':
+            case U'"':
+            {
+                bool raw = isRawStringPrefix(begin, iter);
+                auto character = *iter++;
+                bool longString = end - iter >= 2 && iter[0] == character && iter[1] == character;
+                if (longString)
+                {
+                    iter += 2;
+                }
+                while (iter != end)
+                {
+                    iter = findStringSpecial(iter, end, character, false);
+                    if (iter == end)
+                    {
+                        break;
+                    }
+                    if (*iter == U'\\' && !raw)
+                    {
+                        iter = std::min(iter + 2, end);
+                        continue;
+                    }
+                    if (!longString && *iter == U'\n')
+                    {
+                        // Erroneous string literal. The lexer ends it at the newline as well.
+                        break;
+                    }
+                    if (*iter++ != character)
+                    {
+                        continue;
+                    }
+                    if (!longString)
+                    {
+                        break;
+                    }
+                    if (end - iter >= 2 && iter[0] == character && iter[1] == character)
+                    {
+                        iter += 2;
+                        break;
+                    }
+                }
+                break;
+            }
+            default: iter++; break;
+        }
+    }
+    return result;
+}
+} // namespace
+
+void pylir::Lexer::lexInParallel(llvm::ThreadPool& threadPool)
+{
+    PYLIR_ASSERT(m_tokens.empty());
+#ifdef __cpp_lib_to_chars
+    constexpr bool threadSafe = true;
+#else
+    // Parsing floating point literals may temporarily change the global locale without 'std::from_chars', which is not
+    // thread safe.
+    constexpr bool threadSafe = false;
+#endif
+    if (!threadSafe || threadPool.getThreadCount() <= 1)
+    {
+        return;
+    }
+    // Chunks smaller than this aren't worth the overhead of dispatching them to another thread.
+    constexpr std::size_t minimumChunkSize = 64 * 1024;
+    auto chunkSize = std::max<std::size_t>(minimumChunkSize, (m_end - m_current) / (threadPool.getThreadCount() * 4));
+    std::vector<const char*> chunkStarts{m_current.base()};
+    for (const auto* iter : findTopLevelStatements(m_current.base(), m_end.base()))
+    {
+        if (static_cast<std::size_t>(iter - chunkStarts.back()) >= chunkSize)
+        {
+            chunkStarts.push_back(iter);
+        }
+    }
+    if (chunkStarts.size() == 1)
+    {
+        // Not worth it. Just lex lazily as usual.
+        return;
+    }
+
+    struct Chunk
+    {
+        std::vector<Token> tokens;
+        TokenValueStorage values;
+        std::vector<Diag::DiagnosticsBuilder> warnings;
+    };
+    std::vector<Chunk> chunks(chunkStarts.size());
+    chunkStarts.push_back(m_end.base());
+    std::vector<std::shared_future<void>> futures;
+    for (std::size_t i = 0; i < chunks.size(); i++)
+    {
+        futures.push_back(threadPool.async(
+            [&, i]
+            {
+                auto& chunk = chunks[i];
+                Lexer lexer(*m_document, m_fileId, Diag::Document::const_iterator(chunkStarts[i]),
+                            Diag::Document::const_iterator(chunkStarts[i + 1]),
+                            [&](Diag::DiagnosticsBuilder&& builder) { chunk.warnings.push_back(std::move(builder)); });
+                while (lexer.parseNext())
+                {
+                }
+                chunk.tokens = std::move(lexer.m_tokens);
+                chunk.values = std::move(*lexer.m_values);
+                if (i + 1 == chunks.size())
+                {
+                    return;
+                }
+                // Chunks end right before a top level statement. The lexer additionally emits a newline token as it
+                // has reached the end of its input, which does not exist when lexing sequentially.
+                PYLIR_ASSERT(!chunk.tokens.empty());
+                PYLIR_ASSERT(chunk.tokens.back().getTokenType() == TokenType::Newline
+                             && chunk.tokens.back().getSize() == 0);
+                chunk.tokens.pop_back();
+            }));
+    }
+    for (auto& iter : futures)
+    {
+        iter.wait();
+    }
+
+    std::size_t tokenCount = 0;
+    for (auto& iter : chunks)
+    {
+        tokenCount += iter.tokens.size();
+    }
+    m_tokens.reserve(tokenCount);
+    for (auto& iter : chunks)
+    {
+        m_values->merge(std::move(iter.values), iter.tokens);
+        m_tokens.insert(m_tokens.end(), std::move_iterator(iter.tokens.begin()), std::move_iterator(iter.tokens.end()));
+        for (auto& warning : iter.warnings)
+        {
+            m_warningCallback(std::move(warning));
+        }
+    }
+    m_current = m_end;
+}
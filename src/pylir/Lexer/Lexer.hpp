@@ -13,6 +13,7 @@
 #include <pylir/Support/Text.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <stack>
 #include <string_view>
@@ -22,14 +23,21 @@
 
 #include "Token.hpp"
 
+namespace llvm
+{
+class ThreadPool;
+} // namespace llvm
+
 namespace pylir
 {
 class Lexer
 {
     int m_fileId;
     std::vector<Token> m_tokens;
+    std::shared_ptr<TokenValueStorage> m_values = std::make_shared<TokenValueStorage>();
     const Diag::Document* m_document;
     Diag::Document::const_iterator m_current;
+    Diag::Document::const_iterator m_end;
     std::function<void(Diag::DiagnosticsBuilder&& diagnosticsBuilder)> m_warningCallback;
     std::size_t m_depth = 0;
     std::stack<std::pair<std::size_t, std::size_t>> m_indentation{{{0, static_cast<std::size_t>(-1)}}};
@@ -44,6 +52,12 @@ class Lexer
 
     void parseIndent();
 
+    Lexer(const Diag::Document& document, int fileId, Diag::Document::const_iterator begin,
+          Diag::Document::const_iterator end,
+          std::function<void(Diag::DiagnosticsBuilder&& diagnosticsBuilder)> warningCallback);
+
+    void lexInParallel(llvm::ThreadPool& threadPool);
+
 public:
     using value_type = Token;
     using reference = const Token&;
@@ -53,9 +67,13 @@ public:
     using difference_type = iterator::difference_type;
     using size_type = std::size_t;
 
+    /// Creates a new lexer for 'document'. If 'threadPool' is not null, and the document is large enough, the whole
+    /// document is lexed eagerly within the constructor. The document is split at top level statements, which are
+    /// then lexed in parallel. The resulting tokens and warnings are the same as lexing the document sequentially.
     explicit Lexer(
         const Diag::Document& document, int fileId = 0,
-        std::function<void(Diag::DiagnosticsBuilder&& diagnosticsBuilder)> warningCallback = [](auto&&) {});
+        std::function<void(Diag::DiagnosticsBuilder&& diagnosticsBuilder)> warningCallback = [](auto&&) {},
+        llvm::ThreadPool* threadPool = nullptr);
 
     ~Lexer() = default;
 
@@ -65,6 +83,13 @@ public:
     Lexer(Lexer&&) noexcept = default;
     Lexer& operator=(Lexer&&) noexcept = default;
 
+    /// Returns the storage containing the values of all tokens lexed by this lexer. Tokens refer to their value by an
+    /// index into the storage, which therefore has to be kept alive for as long as the values are accessed.
+    [[nodiscard]] const std::shared_ptr<TokenValueStorage>& getTokenValues() const
+    {
+        return m_values;
+    }
+
     [[nodiscard]] iterator begin()
     {
         return {*this, 0};
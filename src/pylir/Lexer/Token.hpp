@@ -11,12 +11,19 @@
 #include <pylir/Support/Macros.hpp>
 #include <pylir/Support/Variant.hpp>
 
+#include <llvm/ADT/ArrayRef.h>
+
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -144,17 +151,44 @@ public:
 
 class Token : public BaseToken
 {
+    enum class PayloadKind : std::uint8_t
+    {
+        None,
+        Index,
+        Integer,
+    };
+
     TokenType m_tokenType;
+    PayloadKind m_payloadKind = PayloadKind::None;
+    std::uint64_t m_payload = 0;
 
 public:
-    using Variant = std::variant<std::monostate, std::string, BigInt, double>;
+    /// Index of the value of a token within the 'TokenValueStorage' it was created with.
+    enum class ValueIndex : std::uint64_t
+    {
+    };
 
-private:
-    Variant m_value;
+    /// Creates a new token without a value. These make up the majority of tokens.
+    Token(int offset, int size, int fileId, TokenType tokenType)
+        : BaseToken(offset, size, fileId), m_tokenType(tokenType)
+    {
+    }
 
-public:
-    Token(int offset, int size, int fileId, TokenType tokenType, Variant value = {})
-        : BaseToken(offset, size, fileId), m_tokenType(tokenType), m_value(std::move(value))
+    /// Creates a new token whose value is stored at 'index' within a 'TokenValueStorage'.
+    Token(int offset, int size, int fileId, TokenType tokenType, ValueIndex index)
+        : BaseToken(offset, size, fileId),
+          m_tokenType(tokenType),
+          m_payloadKind(PayloadKind::Index),
+          m_payload(static_cast<std::uint64_t>(index))
+    {
+    }
+
+    /// Creates a new integer literal whose value fits into 64 bit. The value is stored within the token itself.
+    Token(int offset, int size, int fileId, std::uint64_t integer)
+        : BaseToken(offset, size, fileId),
+          m_tokenType(TokenType::IntegerLiteral),
+          m_payloadKind(PayloadKind::Integer),
+          m_payload(integer)
     {
     }
 
@@ -163,26 +197,125 @@ public:
         return m_tokenType;
     }
 
-    [[nodiscard]] const Variant& getValue() const
+    /// Returns the index of the value of this token within its 'TokenValueStorage' or an empty optional if the token
+    /// has no value or its value is stored inline.
+    [[nodiscard]] std::optional<ValueIndex> getValueIndex() const
     {
-        return m_value;
+        if (m_payloadKind != PayloadKind::Index)
+        {
+            return std::nullopt;
+        }
+        return ValueIndex{m_payload};
+    }
+
+    /// Returns the value of an integer literal if it fits into 64 bit and is therefore stored inline.
+    [[nodiscard]] std::optional<std::uint64_t> getInlineInteger() const
+    {
+        if (m_payloadKind != PayloadKind::Integer)
+        {
+            return std::nullopt;
+        }
+        return m_payload;
     }
 };
 
-class IdentifierToken : public BaseToken
+/// Owns the values of tokens. Tokens only refer to their value by index, so the storage has to be kept alive for as
+/// long as the values of tokens created with it are accessed. Identifiers with the same name share a single value.
+class TokenValueStorage
 {
-    std::string m_value;
+public:
+    using Variant = std::variant<std::string, BigInt, double>;
+
+private:
+    std::deque<Variant> m_values;
+    std::unordered_map<std::string_view, Token::ValueIndex> m_identifiers;
 
 public:
-    explicit IdentifierToken(const Token& token)
-        : BaseToken(token.getOffset(), token.getSize(), token.getFileId()),
-          m_value(pylir::get<std::string>(token.getValue()))
+    /// Adds 'value' to the storage and returns its index.
+    Token::ValueIndex insert(Variant value)
     {
+        m_values.push_back(std::move(value));
+        return Token::ValueIndex{m_values.size() - 1};
     }
 
-    explicit IdentifierToken(Token&& token)
-        : BaseToken(token.getOffset(), token.getSize(), token.getFileId()),
-          m_value(pylir::get<std::string>(std::move(token).getValue()))
+    /// Like 'insert', but returns the existing index if an identifier with the same name was inserted previously.
+    Token::ValueIndex insertIdentifier(std::string identifier)
+    {
+        if (auto result = m_identifiers.find(identifier); result != m_identifiers.end())
+        {
+            return result->second;
+        }
+        auto index = insert(std::move(identifier));
+        m_identifiers.emplace(pylir::get<std::string>((*this)[index]), index);
+        return index;
+    }
+
+    /// Moves all values of 'tokens', which have been created with 'other', into this storage and changes the tokens to
+    /// refer to them. Identifiers are interned into this storage.
+    void merge(TokenValueStorage&& other, llvm::MutableArrayRef<Token> tokens)
+    {
+        std::vector<std::optional<Token::ValueIndex>> indices(other.m_values.size());
+        for (auto& token : tokens)
+        {
+            auto index = token.getValueIndex();
+            if (!index)
+            {
+                continue;
+            }
+            auto& newIndex = indices[static_cast<std::size_t>(*index)];
+            if (!newIndex)
+            {
+                auto& value = other.m_values[static_cast<std::size_t>(*index)];
+                newIndex = token.getTokenType() == TokenType::Identifier ?
+                               insertIdentifier(std::move(pylir::get<std::string>(value))) :
+                               insert(std::move(value));
+            }
+            token = Token(token.getOffset(), token.getSize(), token.getFileId(), token.getTokenType(), *newIndex);
+        }
+    }
+
+    [[nodiscard]] const Variant& operator[](Token::ValueIndex index) const
+    {
+        return m_values[static_cast<std::size_t>(index)];
+    }
+
+    /// Returns the name of an identifier, the contents of a string or byte literal or the message of a syntax error.
+    [[nodiscard]] const std::string& getString(const Token& token) const
+    {
+        PYLIR_ASSERT(token.getValueIndex());
+        return pylir::get<std::string>((*this)[*token.getValueIndex()]);
+    }
+
+    /// Returns the value of an integer literal. Integers that fit into 64 bit are stored inline within the token and
+    /// only converted to a 'BigInt' when requested.
+    [[nodiscard]] BigInt getInteger(const Token& token) const
+    {
+        if (auto integer = token.getInlineInteger())
+        {
+            return BigInt(*integer);
+        }
+        PYLIR_ASSERT(token.getValueIndex());
+        return pylir::get<BigInt>((*this)[*token.getValueIndex()]);
+    }
+
+    /// Returns the value of a floating point or complex literal.
+    [[nodiscard]] double getDouble(const Token& token) const
+    {
+        PYLIR_ASSERT(token.getValueIndex());
+        return pylir::get<double>((*this)[*token.getValueIndex()]);
+    }
+};
+
+/// Token of an identifier. Identifiers are interned by the 'TokenValueStorage' of the lexer, making it possible to
+/// compare them by their handle instead of their name. The name is owned by the storage, which has to outlive the
+/// token.
+class IdentifierToken : public BaseToken
+{
+    std::string_view m_value;
+
+public:
+    IdentifierToken(const Token& token, const TokenValueStorage& values)
+        : BaseToken(token.getOffset(), token.getSize(), token.getFileId()), m_value(values.getString(token))
     {
     }
 
@@ -195,13 +328,20 @@ public:
     {
         return m_value;
     }
+
+    /// Returns a handle uniquely identifying the name of the identifier. Handles of two identifiers interned by the
+    /// same storage are equal if and only if their names are equal.
+    [[nodiscard]] const void* getHandle() const
+    {
+        return m_value.data();
+    }
 };
 
 struct IdentifierHash
 {
     std::size_t operator()(const IdentifierToken& identifierToken) const noexcept
     {
-        return std::hash<std::string_view>{}(identifierToken.getValue());
+        return std::hash<const void*>{}(identifierToken.getHandle());
     }
 };
 
@@ -209,7 +349,7 @@ struct IdentifierEquals
 {
     bool operator()(const IdentifierToken& lhs, const IdentifierToken& rhs) const noexcept
     {
-        return lhs.getValue() == rhs.getValue();
+        return lhs.getHandle() == rhs.getHandle();
     }
 };
 
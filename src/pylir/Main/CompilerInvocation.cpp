@@ -33,8 +33,15 @@
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/FileUtilities.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Path.h>
+#include <llvm/Support/Process.h>
 #include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/raw_sha1_ostream.h>
 
 #include <pylir/CodeGen/CodeGen.hpp>
 #include <pylir/Diagnostics/DiagnosticMessages.hpp>
@@ -42,8 +49,10 @@
 #include <pylir/LLVM/PylirGC.hpp>
 #include <pylir/Optimizer/Conversion/Passes.hpp>
 #include <pylir/Optimizer/PylirMem/IR/PylirMemDialect.hpp>
+#include <pylir/Optimizer/PylirMem/Transforms/Passes.hpp>
 #include <pylir/Optimizer/PylirPy/IR/PylirPyDialect.hpp>
 #include <pylir/Optimizer/PylirPy/Transforms/Passes.hpp>
+#include <pylir/Optimizer/PylirPy/Util/Linker.hpp>
 #include <pylir/Optimizer/Transforms/Passes.hpp>
 #include <pylir/Parser/Dumper.hpp>
 #include <pylir/Parser/Parser.hpp>
@@ -81,6 +90,100 @@ bool enableLTO(const pylir::cli::CommandLine& commandLine)
     return false;
 #endif
 }
+
+/// Returns the directory of the compilation cache or an empty optional if the compilation cache is not used.
+std::optional<std::string> getCompilationCacheDirectory(const llvm::opt::InputArgList& args)
+{
+    std::string directory;
+    if (auto* arg = args.getLastArg(OPT_cache_dir_EQ))
+    {
+        directory = arg->getValue();
+    }
+    else if (auto env = llvm::sys::Process::GetEnv("PYLIR_CACHE_DIR"))
+    {
+        directory = std::move(*env);
+    }
+    if (directory.empty())
+    {
+        return std::nullopt;
+    }
+    return directory;
+}
+
+/// Returns the path within the compilation cache at which the object file compiled from the input hashed by
+/// 'hashInput' is stored or returns an empty optional if the compilation cache is not used.
+std::optional<std::string> getCompilationCachePath(const pylir::cli::CommandLine& commandLine,
+                                                   pylir::CompilerInvocation::Action action,
+                                                   llvm::function_ref<void(llvm::MD5&)> hashInput)
+{
+    const auto& args = commandLine.getArgs();
+    auto directory = getCompilationCacheDirectory(args);
+    if (!directory)
+    {
+        return std::nullopt;
+    }
+    // Only object files are cached. Other outputs are meant for inspecting the compiler and should always be produced
+    // by actually running it.
+    if ((action != pylir::CompilerInvocation::ObjectFile && action != pylir::CompilerInvocation::Link)
+        || args.hasArg(OPT_emit_llvm, OPT_emit_mlir, OPT_emit_pylir) || args.hasArg(OPT_dump_ast, OPT_link_pylir_EQ)
+        || enableLTO(commandLine))
+    {
+        return std::nullopt;
+    }
+
+    // Every option that may affect the object file becomes part of the key. Options are excluded explicitly, rather
+    // than included, to guarantee that a newly added option affecting the output is never missed. Excluded are the
+    // input and output files, options that only print diagnostic output and options only affecting the linker.
+    llvm::MD5 hash;
+    hash.update(PYLIR_VERSION);
+    hash.update(llvm::sys::getDefaultTargetTriple());
+    hashInput(hash);
+    for (auto* arg : args)
+    {
+        switch (arg->getOption().getID())
+        {
+            case OPT_INPUT:
+            case OPT_o:
+            case OPT_cache_dir_EQ:
+            case OPT_verbose:
+            case OPT__HASH_HASH_HASH: continue;
+            default: break;
+        }
+        if (arg->getOption().getGroup().isValid() && arg->getOption().getGroup().matches(OPT_grp_link))
+        {
+            continue;
+        }
+        hash.update(llvm::StringRef("\0", 1));
+        hash.update(arg->getAsString(args));
+        // The profile may change without the path to it changing.
+        if (arg->getOption().matches(OPT_fprofile_use_EQ))
+        {
+            if (auto profile = llvm::MemoryBuffer::getFile(arg->getValue()))
+            {
+                hash.update((*profile)->getBuffer());
+            }
+        }
+    }
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+
+    llvm::SmallString<128> path(*directory);
+    llvm::sys::path::append(path, llvm::Twine(result.digest()) + ".o");
+    return std::string(path);
+}
+
+void writeToCompilationCache(llvm::StringRef path, llvm::StringRef object)
+{
+    // The cache is purely an optimization. Failing to write to it is therefore not an error.
+    if (llvm::sys::fs::create_directories(llvm::sys::path::parent_path(path)))
+    {
+        return;
+    }
+    if (auto error = llvm::writeFileAtomically((path + "-%%%%%%%%").str(), path, object))
+    {
+        llvm::consumeError(std::move(error));
+    }
+}
 } // namespace
 
 mlir::LogicalResult pylir::CompilerInvocation::executeAction(llvm::opt::Arg* inputFile,
@@ -184,9 +287,34 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(llvm::opt::Arg* input
                 return mlir::failure();
             }
             exit.reset();
+            if (auto cachePath =
+                    getCompilationCachePath(commandLine, action, [&](llvm::MD5& hash) { hash.update(content); }))
+            {
+                if (auto buffer = llvm::MemoryBuffer::getFile(*cachePath))
+                {
+                    if (commandLine.verbose())
+                    {
+                        llvm::errs() << "Using cached object file '" << *cachePath << "'\n";
+                    }
+                    if (mlir::failed(ensureOutputStream(args, action)))
+                    {
+                        return mlir::failure();
+                    }
+                    *m_output << (*buffer)->getBuffer();
+                    return mlir::success();
+                }
+                m_compilationCachePaths.push_back(std::move(*cachePath));
+            }
             m_document = Diag::Document(std::move(content), inputFile->getValue());
             {
-                pylir::Parser parser(*m_document);
+                // Threads are only spawned on demand if the lexer decides that the file is large enough.
+                std::optional<llvm::ThreadPool> threadPool;
+                if (args.hasFlag(OPT_Xmulti_threaded, OPT_Xsingle_threaded, true))
+                {
+                    threadPool.emplace();
+                }
+                pylir::Parser parser(
+                    *m_document, 0, [](auto&&) {}, threadPool ? &*threadPool : nullptr);
                 auto tree = parser.parseFileInput();
                 if (!tree)
                 {
@@ -205,7 +333,62 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(llvm::opt::Arg* input
                 return mlir::success();
             }
             ensureMLIRContext(args);
-            mlirModule = pylir::codegen(&*m_mlirContext, *m_fileInput, *m_document);
+            pylir::CodeGenOptions codeGenOptions;
+            codeGenOptions.moduleName = args.getLastArgValue(OPT_fmodule_name_EQ, "__main__").str();
+            codeGenOptions.importPaths = args.getAllArgValues(OPT_I);
+            codeGenOptions.timeModuleInit = args.hasArg(OPT_ftime_module_init);
+            std::vector<std::string> importedFiles;
+            codeGenOptions.importedFiles = &importedFiles;
+            mlirModule = pylir::codegen(&*m_mlirContext, *m_fileInput, *m_document, std::move(codeGenOptions));
+            if (!mlirModule)
+            {
+                return mlir::failure();
+            }
+            bool useCompilationCache = !m_compilationCachePaths.empty();
+            if (!importedFiles.empty())
+            {
+                // The key computed from the source file does not cover the modules it imports from. The IR contains
+                // the declarations of everything imported and is therefore used as the only key.
+                m_compilationCachePaths.clear();
+            }
+            if (useCompilationCache)
+            {
+                // Edits of the source file that do not change the generated IR, such as changes to comments, can still
+                // reuse the object file of a previous compilation. Locations are part of the hash as they end up as
+                // debug info in the object file. The key is computed from the whole module: Any edit changing the IR of
+                // a single function causes the whole module to be recompiled.
+                auto irCachePath = getCompilationCachePath(commandLine, action,
+                                                           [&](llvm::MD5& hash)
+                                                           {
+                                                               llvm::raw_sha1_ostream stream;
+                                                               mlirModule->print(stream, mlir::OpPrintingFlags{}
+                                                                                             .assumeVerified()
+                                                                                             .enableDebugInfo());
+                                                               hash.update("ir");
+                                                               hash.update(stream.sha1());
+                                                           });
+                if (irCachePath)
+                {
+                    if (auto buffer = llvm::MemoryBuffer::getFile(*irCachePath))
+                    {
+                        if (commandLine.verbose())
+                        {
+                            llvm::errs() << "Using cached object file '" << *irCachePath << "' with identical IR\n";
+                        }
+                        if (mlir::failed(ensureOutputStream(args, action)))
+                        {
+                            return mlir::failure();
+                        }
+                        *m_output << (*buffer)->getBuffer();
+                        for (const auto& iter : m_compilationCachePaths)
+                        {
+                            writeToCompilationCache(iter, (*buffer)->getBuffer());
+                        }
+                        return mlir::success();
+                    }
+                    m_compilationCachePaths.push_back(std::move(*irCachePath));
+                }
+            }
             [[fallthrough]];
         }
         case FileType::MLIR:
@@ -220,6 +403,20 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(llvm::opt::Arg* input
                     return mlir::failure();
                 }
             }
+            // Linking at the Pylir IR level allows the optimizer to work on the whole program while Python type
+            // information is still present, unlike LTO at the LLVM level.
+            for (auto* arg : args.filtered(OPT_link_pylir_EQ))
+            {
+                auto other = mlir::parseSourceFile<mlir::ModuleOp>(arg->getValue(), &*m_mlirContext);
+                if (!other)
+                {
+                    return mlir::failure();
+                }
+                if (mlir::failed(pylir::Py::linkModules(*mlirModule, std::move(other))))
+                {
+                    return mlir::failure();
+                }
+            }
             mlir::PassManager manager(&*m_mlirContext);
             if (args.hasArg(OPT_Xstatistics))
             {
@@ -260,7 +457,11 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(llvm::opt::Arg* input
                 mlirModule->print(*m_output, mlir::OpPrintingFlags{}.assumeVerified().enableDebugInfo());
                 return finalizeOutputStream(mlir::success());
             }
-            addOptimizationPasses(args.getLastArgValue(OPT_O, "0"), manager);
+            // Unlike object files, results of optimization passes are keyed by the IR they were computed from
+            // and can therefore be shared between all compilations, regardless of action and options.
+            addOptimizationPasses(args.getLastArgValue(OPT_O, "0"), manager,
+                                  getCompilationCacheDirectory(args).value_or(""), args.hasArg(OPT_fprofile_generate),
+                                  args.getLastArgValue(OPT_fprofile_use_EQ));
             if (shouldOutput(OPT_emit_mlir))
             {
                 if (mlir::failed(manager.run(*mlirModule)))
@@ -413,10 +614,20 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(llvm::opt::Arg* input
                 return mlir::failure();
             }
 
+            // When caching, the object file is first emitted into a buffer, so that it can be written to both the
+            // output and the cache.
+            llvm::SmallString<0> objectBuffer;
+            std::optional<llvm::raw_svector_ostream> objectBufferStream;
+            llvm::raw_pwrite_stream* codeGenOutput = m_output;
+            if (!m_compilationCachePaths.empty())
+            {
+                codeGenOutput = &objectBufferStream.emplace(objectBuffer);
+            }
+
             llvm::legacy::PassManager codeGenPasses;
             codeGenPasses.add(llvm::createTargetTransformInfoWrapperPass(m_targetMachine->getTargetIRAnalysis()));
             if (m_targetMachine->addPassesToEmitFile(
-                    codeGenPasses, *m_output, nullptr,
+                    codeGenPasses, *codeGenOutput, nullptr,
                     action == pylir::CompilerInvocation::Assembly ? llvm::CGFT_AssemblyFile : llvm::CGFT_ObjectFile))
             {
                 std::string_view format = action == pylir::CompilerInvocation::Assembly ? "Assembly" : "Object file";
@@ -442,6 +653,14 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(llvm::opt::Arg* input
             }
 
             codeGenPasses.run(*llvmModule);
+            if (!m_compilationCachePaths.empty())
+            {
+                *m_output << objectBuffer;
+                for (const auto& iter : m_compilationCachePaths)
+                {
+                    writeToCompilationCache(iter, objectBuffer);
+                }
+            }
             break;
         }
     }
@@ -568,34 +787,73 @@ mlir::LogicalResult pylir::CompilerInvocation::finalizeOutputStream(mlir::Logica
     return mlir::success();
 }
 
-void pylir::CompilerInvocation::addOptimizationPasses(llvm::StringRef level, mlir::OpPassManager& manager)
+void pylir::CompilerInvocation::addOptimizationPasses(llvm::StringRef level, mlir::OpPassManager& manager,
+                                                      llvm::StringRef cacheDirectory, bool profileGenerate,
+                                                      llvm::StringRef profileUse)
 {
+    std::string monomorphCacheFile;
+    std::string trialInlinerCacheFile;
+    if (!cacheDirectory.empty())
+    {
+        llvm::SmallString<128> path(cacheDirectory);
+        llvm::sys::path::append(path, "monomorph-" PYLIR_VERSION ".mlir");
+        monomorphCacheFile = std::string(path);
+        path = cacheDirectory;
+        llvm::sys::path::append(path, "trial-inliner-" PYLIR_VERSION ".mlir");
+        trialInlinerCacheFile = std::string(path);
+    }
+
     mlir::OpPassManager* nested;
     manager.addPass(mlir::createCanonicalizerPass());
     if (level != "0")
     {
         manager.nestAny().addPass(pylir::Py::createHandleLoadStoreEliminationPass());
+        manager.addPass(pylir::Py::createSnapshotModuleInitPass());
         manager.addPass(pylir::Py::createFoldHandlesPass());
         manager.nestAny().addPass(mlir::createCSEPass());
-        manager.addPass(pylir::Py::createTrialInlinerPass());
+    }
+    // Call sites are identified by their position in the IR. Instrumentation and use of the profile must therefore
+    // happen at the same point in the pipeline.
+    if (profileGenerate)
+    {
+        manager.addPass(pylir::Py::createProfileInstrumentationPass());
+    }
+    if (!profileUse.empty())
+    {
+        manager.addPass(pylir::Py::createProfileUsePass(profileUse));
+    }
+    if (level != "0")
+    {
+        manager.addPass(pylir::Py::createTrialInlinerPass(trialInlinerCacheFile));
         manager.addPass(mlir::createSymbolDCEPass());
         nested = &manager.nestAny();
         nested->addPass(pylir::createLoadForwardingPass());
+        nested->addPass(pylir::createDeadStoreEliminationPass());
         nested->addPass(mlir::createSCCPPass());
-        manager.addPass(pylir::Py::createMonomorphPass());
-        manager.addPass(pylir::Py::createTrialInlinerPass());
+        manager.addPass(pylir::Py::createMonomorphPass(monomorphCacheFile));
+        manager.addPass(pylir::Py::createTrialInlinerPass(trialInlinerCacheFile));
         manager.addPass(mlir::createSymbolDCEPass());
     }
     manager.addPass(pylir::Py::createExpandPyDialectPass());
     if (level != "0")
     {
         nested = &manager.nestAny();
+        nested->addPass(pylir::Py::createUnboxingPass());
         nested->addPass(mlir::createCanonicalizerPass());
         nested->addPass(mlir::createCSEPass());
+        nested->addPass(pylir::Py::createLoopInvariantCodeMotionPass());
+        nested->addPass(mlir::createCanonicalizerPass());
+        nested->addPass(pylir::Py::createRangeCheckEliminationPass());
+        nested->addPass(mlir::createCanonicalizerPass());
         nested->addPass(pylir::createLoadForwardingPass());
+        nested->addPass(pylir::createDeadStoreEliminationPass());
         nested->addPass(mlir::createSCCPPass());
     }
     manager.addPass(pylir::createConvertPylirPyToPylirMemPass());
+    if (level != "0")
+    {
+        manager.addPass(pylir::Mem::createStackAllocationPass());
+    }
 }
 
 mlir::LogicalResult pylir::CompilerInvocation::ensureTargetMachine(const llvm::opt::InputArgList& args,
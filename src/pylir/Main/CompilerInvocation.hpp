@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "CommandLine.hpp"
 #include "Toolchain.hpp"
@@ -37,6 +38,8 @@ class CompilerInvocation
     std::optional<llvm::sys::fs::TempFile> m_outputFile;
     std::optional<llvm::raw_fd_ostream> m_outFileStream;
     std::string m_realOutputFilename;
+    // Keyed by the source file and, once generated, additionally by the IR.
+    std::vector<std::string> m_compilationCachePaths;
 
     enum FileType
     {
@@ -63,7 +66,8 @@ private:
 
     mlir::LogicalResult finalizeOutputStream(mlir::LogicalResult result);
 
-    void addOptimizationPasses(llvm::StringRef level, mlir::OpPassManager& manager);
+    void addOptimizationPasses(llvm::StringRef level, mlir::OpPassManager& manager, llvm::StringRef cacheDirectory,
+                               bool profileGenerate, llvm::StringRef profileUse);
 
     mlir::LogicalResult ensureTargetMachine(const llvm::opt::InputArgList& args, const cli::CommandLine& commandLine,
                                             const pylir::Toolchain& toolchain,
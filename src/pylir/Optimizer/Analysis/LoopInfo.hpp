@@ -87,7 +87,7 @@ public:
 
     iterator end()
     {
-        return m_subLoops.begin();
+        return m_subLoops.end();
     }
 
     bool contains(mlir::Block* block) const
@@ -186,7 +186,7 @@ struct GraphTraits<pylir::Loop*>
 
     static ChildIteratorType child_end(NodeRef node)
     {
-        return node->begin();
+        return node->end();
     }
 };
 
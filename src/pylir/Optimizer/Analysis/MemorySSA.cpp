@@ -375,6 +375,278 @@ pylir::MemorySSA::MemorySSA(mlir::Operation* operation, mlir::AnalysisManager& a
     optimizeUses(analysisManager);
 }
 
+namespace
+{
+mlir::Operation* getInstruction(mlir::Operation* access)
+{
+    return llvm::TypeSwitch<mlir::Operation*, mlir::Operation*>(access)
+        .Case<pylir::MemSSA::MemoryDefOp, pylir::MemSSA::MemoryUseOp>([](auto op) { return op.getInstruction(); })
+        .Default(nullptr);
+}
+
+/// Returns true if the chain of definitions starting at 'current' and leading to 'definition' contains 'def'.
+/// Conservatively returns true if 'definition' is not part of the chain at all.
+bool skipsDef(mlir::Value current, mlir::Value definition, mlir::Value def)
+{
+    while (current != definition)
+    {
+        if (current == def)
+        {
+            return true;
+        }
+        auto memDef = current.getDefiningOp<pylir::MemSSA::MemoryDefOp>();
+        if (!memDef)
+        {
+            return true;
+        }
+        current = memDef.getClobbered();
+    }
+    return false;
+}
+} // namespace
+
+mlir::Value pylir::MemorySSA::getReachingDef(mlir::Block* memBlock, mlir::Block::iterator iter)
+{
+    // Blocks without a block argument have the same reaching definition from all their predecessors. It is therefore
+    // sufficient to follow any predecessor until a definition is found.
+    llvm::SmallVector<std::pair<mlir::Block*, mlir::Block::iterator>> workList{{memBlock, iter}};
+    llvm::DenseSet<mlir::Block*> seen;
+    while (!workList.empty())
+    {
+        auto [block, end] = workList.pop_back_val();
+        for (auto& op : llvm::reverse(llvm::make_range(block->begin(), end)))
+        {
+            if (mlir::isa<MemSSA::MemoryDefOp, MemSSA::MemoryLiveOnEntryOp>(op))
+            {
+                return op.getResult(0);
+            }
+        }
+        if (block->getNumArguments() != 0)
+        {
+            return block->getArgument(0);
+        }
+        for (auto* pred : block->getPredecessors())
+        {
+            if (seen.insert(pred).second)
+            {
+                workList.emplace_back(pred, pred->getTerminator()->getIterator());
+            }
+        }
+    }
+    PYLIR_UNREACHABLE;
+}
+
+void pylir::MemorySSA::propagateDef(MemSSA::MemoryDefOp def, mlir::Value oldDef)
+{
+    // Replaces 'oldDef' with the reaching definition in every access following 'def', up until the next definition.
+    // Successors that had no block argument as 'oldDef' reached them from all predecessors get one inserted.
+    llvm::SmallVector<std::pair<mlir::Block::iterator, mlir::Value>> workList{
+        {std::next(def->getIterator()), def.getResult()}};
+    while (!workList.empty())
+    {
+        auto [iter, newDef] = workList.pop_back_val();
+        auto* block = iter->getBlock();
+        bool clobbered = false;
+        for (auto& op : llvm::make_range(iter, block->end()))
+        {
+            if (auto use = mlir::dyn_cast<MemSSA::MemoryUseOp>(op))
+            {
+                if (use.getDefinition() == oldDef)
+                {
+                    use.getDefinitionMutable().assign(newDef);
+                }
+                continue;
+            }
+            if (auto memDef = mlir::dyn_cast<MemSSA::MemoryDefOp>(op))
+            {
+                if (memDef != def)
+                {
+                    memDef.getClobberedMutable().assign(newDef);
+                }
+                clobbered = true;
+                break;
+            }
+        }
+        if (clobbered)
+        {
+            continue;
+        }
+
+        auto* terminator = block->getTerminator();
+        for (auto& operand : terminator->getOpOperands())
+        {
+            if (operand.get() == oldDef)
+            {
+                operand.set(newDef);
+            }
+        }
+        for (auto* succ : terminator->getSuccessors())
+        {
+            if (succ->getNumArguments() != 0)
+            {
+                continue;
+            }
+            if (succ->getSinglePredecessor())
+            {
+                workList.emplace_back(succ->begin(), newDef);
+                continue;
+            }
+            auto blockArg = succ->addArgument(newDef.getType(), newDef.getLoc());
+            for (auto pred = succ->pred_begin(); pred != succ->pred_end(); pred++)
+            {
+                auto branch = mlir::cast<mlir::BranchOpInterface>((*pred)->getTerminator());
+                branch.getSuccessorOperands(pred.getSuccessorIndex())
+                    .append(*pred == block ? newDef : getReachingDef(*pred, branch->getIterator()));
+            }
+            workList.emplace_back(succ->begin(), blockArg);
+        }
+    }
+}
+
+void pylir::MemorySSA::updateUses(MemSSA::MemoryDefOp def)
+{
+    // Optimized uses following 'def' may refer to a definition prior to it. These are reset to their reaching
+    // definition. Uses never skip over block arguments, making it sufficient to only visit blocks until one with a
+    // block argument is encountered.
+    llvm::SmallVector<std::pair<mlir::Block::iterator, mlir::Value>> workList{
+        {std::next(def->getIterator()), def.getResult()}};
+    llvm::DenseSet<mlir::Block*> seen{def->getBlock()};
+    while (!workList.empty())
+    {
+        auto [iter, current] = workList.pop_back_val();
+        auto* block = iter->getBlock();
+        for (auto& op : llvm::make_range(iter, block->end()))
+        {
+            if (auto use = mlir::dyn_cast<MemSSA::MemoryUseOp>(op))
+            {
+                if (skipsDef(current, use.getDefinition(), def))
+                {
+                    use.getDefinitionMutable().assign(current);
+                }
+                continue;
+            }
+            if (auto memDef = mlir::dyn_cast<MemSSA::MemoryDefOp>(op))
+            {
+                current = memDef;
+            }
+        }
+        for (auto* succ : block->getSuccessors())
+        {
+            if (succ->getNumArguments() == 0 && seen.insert(succ).second)
+            {
+                workList.emplace_back(succ->begin(), current);
+            }
+        }
+    }
+}
+
+mlir::Operation* pylir::MemorySSA::insertAccess(mlir::Operation* operation)
+{
+    mlir::Operation* previousAccess = nullptr;
+    for (auto* prev = operation->getPrevNode(); prev && !previousAccess; prev = prev->getPrevNode())
+    {
+        PYLIR_ASSERT(!mlir::isa<mlir::RegionBranchOpInterface>(prev)
+                     && "Inserting accesses after region branch ops is not yet supported");
+        previousAccess = getMemoryAccess(prev);
+    }
+
+    mlir::Block* memBlock;
+    mlir::Block::iterator insertionPoint;
+    if (previousAccess)
+    {
+        memBlock = previousAccess->getBlock();
+        insertionPoint = std::next(previousAccess->getIterator());
+    }
+    else
+    {
+        memBlock = m_blockMapping.lookup(operation->getBlock());
+        PYLIR_ASSERT(memBlock && "Block has to be known to the memory SSA");
+        insertionPoint = memBlock->begin();
+        if (mlir::isa<MemSSA::MemoryLiveOnEntryOp>(*insertionPoint))
+        {
+            insertionPoint++;
+        }
+    }
+
+    mlir::ImplicitLocOpBuilder builder(mlir::UnknownLoc::get(operation->getContext()), operation->getContext());
+    builder.setInsertionPoint(memBlock, insertionPoint);
+    auto lastDef = getReachingDef(memBlock, insertionPoint);
+    auto* access = maybeAddAccess(builder, *this, operation, lastDef);
+    if (!access)
+    {
+        return nullptr;
+    }
+    m_results.insert({operation, access});
+    if (auto def = mlir::dyn_cast<MemSSA::MemoryDefOp>(access))
+    {
+        propagateDef(def, lastDef);
+        updateUses(def);
+    }
+    return access;
+}
+
+void pylir::MemorySSA::removeAccess(mlir::Operation* operation)
+{
+    auto* access = m_results.lookup(operation);
+    if (!access)
+    {
+        return;
+    }
+    m_results.erase(operation);
+    if (auto def = mlir::dyn_cast<MemSSA::MemoryDefOp>(access))
+    {
+        def.replaceAllUsesWith(def.getClobbered());
+    }
+    access->erase();
+}
+
+void pylir::MemorySSA::replaceInstruction(mlir::Operation* operation, mlir::Operation* replacement)
+{
+    auto* access = m_results.lookup(operation);
+    if (!access)
+    {
+        return;
+    }
+    m_results.erase(operation);
+    m_results.insert({replacement, access});
+    auto instruction = MemSSA::InstructionAttr::get(replacement->getContext(), replacement);
+    if (auto def = mlir::dyn_cast<MemSSA::MemoryDefOp>(access))
+    {
+        def.setInstructionAttr(instruction);
+        return;
+    }
+    auto use = mlir::cast<MemSSA::MemoryUseOp>(access);
+    use.setInstructionAttr(instruction);
+    llvm::SmallVector<mlir::MemoryEffects::EffectInstance> effects;
+    mlir::cast<mlir::MemoryEffectOpInterface>(replacement).getEffects(effects);
+    auto* read = llvm::find_if(effects, [](const mlir::MemoryEffects::EffectInstance& effect)
+                               { return llvm::isa<mlir::MemoryEffects::Read>(effect.getEffect()); });
+    PYLIR_ASSERT(read != effects.end() && read->getValue());
+    use.setReadAttr(MemSSA::ReadAttr::get(replacement->getContext(), read->getValue()));
+}
+
+void pylir::MemorySSA::splitBlock(mlir::Block* block, mlir::Block* newBlock)
+{
+    PYLIR_ASSERT(llvm::none_of(*block, [](mlir::Operation& op) { return mlir::isa<mlir::RegionBranchOpInterface>(op); })
+                 && "Splitting blocks containing region branch ops is not yet supported");
+    auto* memBlock = m_blockMapping.lookup(block);
+    PYLIR_ASSERT(memBlock && "Block has to be known to the memory SSA");
+
+    // Accesses of all operations now part of 'newBlock' are at the very end of 'memBlock', followed by its terminator.
+    auto iter = llvm::find_if(memBlock->without_terminator(),
+                              [&](mlir::Operation& access)
+                              {
+                                  auto* instruction = getInstruction(&access);
+                                  return instruction && instruction->getBlock() == newBlock;
+                              });
+    auto* newMemBlock = memBlock->splitBlock(iter);
+    m_blockMapping[newBlock] = newMemBlock;
+
+    mlir::ImplicitLocOpBuilder builder(mlir::UnknownLoc::get(block->getParentOp()->getContext()),
+                                       mlir::OpBuilder::atBlockEnd(memBlock));
+    builder.create<MemSSA::MemoryBranchOp>(llvm::SmallVector<mlir::ValueRange>(1), mlir::BlockRange{newMemBlock});
+}
+
 void pylir::MemorySSA::dump() const
 {
     m_region.get()->dump();
@@ -37,11 +37,32 @@ class MemorySSA
 
     void optimizeUses(mlir::AnalysisManager& analysisManager);
 
+    mlir::Value getReachingDef(mlir::Block* memBlock, mlir::Block::iterator iter);
+
+    void propagateDef(MemSSA::MemoryDefOp def, mlir::Value oldDef);
+
+    void updateUses(MemSSA::MemoryDefOp def);
+
 public:
     explicit MemorySSA(mlir::Operation* operation, mlir::AnalysisManager& analysisManager);
 
     mlir::Operation* getMemoryAccess(mlir::Operation* operation);
 
+    /// Creates the memory access of 'operation', which has been newly inserted into the IR, and updates all accesses
+    /// following it. Returns the access created or null if 'operation' does not access memory. Uses affected by a
+    /// newly inserted definition are not optimized.
+    mlir::Operation* insertAccess(mlir::Operation* operation);
+
+    /// Removes the memory access of 'operation' if it has one. Has to be called before 'operation' is erased or moved.
+    void removeAccess(mlir::Operation* operation);
+
+    /// Transfers the memory access of 'operation' to 'replacement', which has to have the same effects on memory.
+    void replaceInstruction(mlir::Operation* operation, mlir::Operation* replacement);
+
+    /// Updates the memory SSA after 'block' has been split into 'block' and 'newBlock', where 'block' unconditionally
+    /// branches to 'newBlock'.
+    void splitBlock(mlir::Block* block, mlir::Block* newBlock);
+
     mlir::Region& getMemoryRegion()
     {
         return m_region->getBody();
@@ -487,6 +487,9 @@ public:
         pylir_dict_erase,
         pylir_print,
         pylir_raise,
+        pylir_profile_call,
+        pylir_module_init_start,
+        pylir_module_init_end,
     };
 
     mlir::Value createRuntimeCall(mlir::Location loc, mlir::OpBuilder& builder, Runtime func, mlir::ValueRange args)
@@ -537,6 +540,24 @@ public:
                 functionName = "pylir_raise";
                 passThroughAttributes = {"noreturn"};
                 break;
+            case Runtime::pylir_profile_call:
+                returnType = mlir::LLVM::LLVMVoidType::get(&getContext());
+                argumentTypes = {m_objectPtrType, m_objectPtrType};
+                functionName = "pylir_profile_call";
+                passThroughAttributes = {"gc-leaf-function", "nounwind"};
+                break;
+            case Runtime::pylir_module_init_start:
+                returnType = mlir::LLVM::LLVMVoidType::get(&getContext());
+                argumentTypes = {m_objectPtrType};
+                functionName = "pylir_module_init_start";
+                passThroughAttributes = {"gc-leaf-function", "nounwind"};
+                break;
+            case Runtime::pylir_module_init_end:
+                returnType = mlir::LLVM::LLVMVoidType::get(&getContext());
+                argumentTypes = {m_objectPtrType};
+                functionName = "pylir_module_init_end";
+                passThroughAttributes = {"gc-leaf-function", "nounwind"};
+                break;
             case Runtime::mp_init:
                 returnType = mlir::LLVM::LLVMVoidType::get(&getContext());
                 argumentTypes = {m_objectPtrType};
@@ -1458,6 +1479,71 @@ protected:
         return getTypeConverter()->getLayoutType(attr);
     }
 
+    /// Returns the size in bytes of instances of the type object 'typeObject' as well as their alignment if
+    /// 'typeObject' is a constant.
+    [[nodiscard]] llvm::Optional<std::pair<std::size_t, std::size_t>>
+        getConstantInstanceSize(mlir::Value typeObject) const
+    {
+        auto constant = typeObject.getDefiningOp<pylir::Py::ConstantOp>();
+        if (!constant)
+        {
+            return llvm::None;
+        }
+        auto ref = constant.getConstant().dyn_cast<mlir::FlatSymbolRefAttr>();
+        auto typeAttr = dereference<pylir::Py::TypeAttr>(constant.getConstant());
+        if (!typeAttr)
+        {
+            return llvm::None;
+        }
+
+        std::size_t slotLen = 0;
+        auto map = typeAttr.getSlots();
+        auto iter = map.get("__slots__");
+        if (iter)
+        {
+            slotLen = dereference<pylir::Py::TupleAttr>(iter).getValue().size();
+        }
+        mlir::Type instanceType;
+        if (ref)
+        {
+            instanceType = getBuiltinsInstanceType(getLayoutType(ref));
+        }
+        else
+        {
+            instanceType = getBuiltinsInstanceType(getLayoutType(typeAttr));
+        }
+        return std::pair{sizeOf(instanceType) + sizeOf(pointer()) * slotLen, alignOf(instanceType)};
+    }
+
+    /// Allocates 'size' bytes of zeroed memory for an object within the stack frame of the function containing 'op'.
+    /// The 'alloca' is placed in the entry block so that it is part of the fixed size stack frame.
+    mlir::Value createStackAllocation(mlir::Operation* op, mlir::ConversionPatternRewriter& rewriter, std::size_t size,
+                                      std::size_t alignment) const
+    {
+        auto* scope = op->getParentWithTrait<mlir::OpTrait::AutomaticAllocationScope>();
+        PYLIR_ASSERT(scope);
+        mlir::Value alloca;
+        {
+            mlir::OpBuilder::InsertionGuard guard{rewriter};
+            rewriter.setInsertionPointToStart(&scope->getRegion(0).front());
+            auto one = rewriter.create<mlir::LLVM::ConstantOp>(op->getLoc(), rewriter.getI32Type(),
+                                                               rewriter.getI32IntegerAttr(1));
+            alloca = rewriter.create<mlir::LLVM::AllocaOp>(
+                op->getLoc(), pointer(), mlir::LLVM::LLVMArrayType::get(rewriter.getI8Type(), size), one, alignment);
+        }
+        auto inBytes = createIndexConstant(rewriter, op->getLoc(), size);
+        auto zeroI8 =
+            rewriter.create<mlir::LLVM::ConstantOp>(op->getLoc(), rewriter.getI8Type(), rewriter.getI8IntegerAttr(0));
+        auto falseC =
+            rewriter.create<mlir::LLVM::ConstantOp>(op->getLoc(), rewriter.getI1Type(), rewriter.getBoolAttr(false));
+        rewriter.create<mlir::LLVM::MemsetOp>(op->getLoc(), alloca, zeroI8, inBytes, falseC);
+        // References to objects are pointers in the GC address space. Going through an integer instead of an
+        // 'addrspacecast' makes the result a base pointer for statepoint placement, which records it in the stack map
+        // like any other reference. The runtime recognizes it as living on the stack and traces its contents instead.
+        auto address = rewriter.create<mlir::LLVM::PtrToIntOp>(op->getLoc(), getIndexType(), alloca);
+        return rewriter.create<mlir::LLVM::IntToPtrOp>(op->getLoc(), pointer(REF_ADDRESS_SPACE), address);
+    }
+
     [[nodiscard]] mlir::StringAttr getRootSection() const
     {
         return getTypeConverter()->getRootSection();
@@ -2123,6 +2209,48 @@ struct PrintOpConversion : public ConvertPylirOpToLLVMPattern<pylir::Py::PrintOp
     }
 };
 
+struct ProfileCallOpConversion : public ConvertPylirOpToLLVMPattern<pylir::Py::ProfileCallOp>
+{
+    using ConvertPylirOpToLLVMPattern<pylir::Py::ProfileCallOp>::ConvertPylirOpToLLVMPattern;
+
+    mlir::LogicalResult matchAndRewrite(pylir::Py::ProfileCallOp op, OpAdaptor adaptor,
+                                        mlir::ConversionPatternRewriter& rewriter) const override
+    {
+        createRuntimeCall(op.getLoc(), rewriter, PylirTypeConverter::Runtime::pylir_profile_call,
+                          {adaptor.getFunction(), adaptor.getSite()});
+        rewriter.eraseOp(op);
+        return mlir::success();
+    }
+};
+
+struct ModuleInitStartOpConversion : public ConvertPylirOpToLLVMPattern<pylir::Py::ModuleInitStartOp>
+{
+    using ConvertPylirOpToLLVMPattern<pylir::Py::ModuleInitStartOp>::ConvertPylirOpToLLVMPattern;
+
+    mlir::LogicalResult matchAndRewrite(pylir::Py::ModuleInitStartOp op, OpAdaptor adaptor,
+                                        mlir::ConversionPatternRewriter& rewriter) const override
+    {
+        createRuntimeCall(op.getLoc(), rewriter, PylirTypeConverter::Runtime::pylir_module_init_start,
+                          adaptor.getModuleName());
+        rewriter.eraseOp(op);
+        return mlir::success();
+    }
+};
+
+struct ModuleInitEndOpConversion : public ConvertPylirOpToLLVMPattern<pylir::Py::ModuleInitEndOp>
+{
+    using ConvertPylirOpToLLVMPattern<pylir::Py::ModuleInitEndOp>::ConvertPylirOpToLLVMPattern;
+
+    mlir::LogicalResult matchAndRewrite(pylir::Py::ModuleInitEndOp op, OpAdaptor adaptor,
+                                        mlir::ConversionPatternRewriter& rewriter) const override
+    {
+        createRuntimeCall(op.getLoc(), rewriter, PylirTypeConverter::Runtime::pylir_module_init_end,
+                          adaptor.getModuleName());
+        rewriter.eraseOp(op);
+        return mlir::success();
+    }
+};
+
 struct GetSlotOpConstantConversion : public ConvertPylirOpToLLVMPattern<pylir::Py::GetSlotOp>
 {
     using ConvertPylirOpToLLVMPattern<pylir::Py::GetSlotOp>::ConvertPylirOpToLLVMPattern;
@@ -2550,39 +2678,15 @@ struct GCAllocObjectConstTypeConversion : public ConvertPylirOpToLLVMPattern<pyl
     mlir::LogicalResult matchAndRewrite(pylir::Mem::GCAllocObjectOp op, OpAdaptor adaptor,
                                         mlir::ConversionPatternRewriter& rewriter) const override
     {
-        auto constant = op.getTypeObject().getDefiningOp<pylir::Py::ConstantOp>();
-        if (!constant)
-        {
-            return mlir::failure();
-        }
-        pylir::Py::TypeAttr typeAttr;
-        auto ref = constant.getConstant().dyn_cast<mlir::FlatSymbolRefAttr>();
-        typeAttr = dereference<pylir::Py::TypeAttr>(constant.getConstant());
-        if (!typeAttr)
-        {
-            return mlir::failure();
-        }
-
-        std::size_t slotLen = 0;
-        auto map = typeAttr.getSlots();
-        auto iter = map.get("__slots__");
-        if (iter)
-        {
-            slotLen = dereference<pylir::Py::TupleAttr>(iter).getValue().size();
-        }
         // I could create GEP here to read the offset component of the type object, but LLVM is not aware that the size
         // component is const, even if the rest of the type isn't. So instead we calculate the size here again to have
         // it be a constant.
-        mlir::Type instanceType;
-        if (ref)
+        auto size = getConstantInstanceSize(op.getTypeObject());
+        if (!size)
         {
-            instanceType = getBuiltinsInstanceType(getLayoutType(ref));
-        }
-        else
-        {
-            instanceType = getBuiltinsInstanceType(getLayoutType(typeAttr));
+            return mlir::failure();
         }
-        auto inBytes = createIndexConstant(rewriter, op.getLoc(), sizeOf(instanceType) + sizeOf(pointer()) * slotLen);
+        auto inBytes = createIndexConstant(rewriter, op.getLoc(), size->first);
         auto memory = createRuntimeCall(op.getLoc(), rewriter, PylirTypeConverter::Runtime::pylir_gc_alloc, {inBytes});
         auto zeroI8 =
             rewriter.create<mlir::LLVM::ConstantOp>(op.getLoc(), rewriter.getI8Type(), rewriter.getI8IntegerAttr(0));
@@ -2595,6 +2699,40 @@ struct GCAllocObjectConstTypeConversion : public ConvertPylirOpToLLVMPattern<pyl
     }
 };
 
+struct StackAllocObjectOpConversion : public ConvertPylirOpToLLVMPattern<pylir::Mem::StackAllocObjectOp>
+{
+    using ConvertPylirOpToLLVMPattern<pylir::Mem::StackAllocObjectOp>::ConvertPylirOpToLLVMPattern;
+
+    mlir::LogicalResult matchAndRewrite(pylir::Mem::StackAllocObjectOp op, OpAdaptor adaptor,
+                                        mlir::ConversionPatternRewriter& rewriter) const override
+    {
+        auto size = getConstantInstanceSize(op.getTypeObject());
+        if (!size)
+        {
+            return mlir::failure();
+        }
+        auto memory = createStackAllocation(op, rewriter, size->first, size->second);
+        pyObjectModel(op.getLoc(), rewriter, memory).typePtr(op.getLoc()).store(op.getLoc(), adaptor.getTypeObject());
+        rewriter.replaceOp(op, memory);
+        return mlir::success();
+    }
+};
+
+struct StackAllocTupleOpConversion : public ConvertPylirOpToLLVMPattern<pylir::Mem::StackAllocTupleOp>
+{
+    using ConvertPylirOpToLLVMPattern<pylir::Mem::StackAllocTupleOp>::ConvertPylirOpToLLVMPattern;
+
+    mlir::LogicalResult matchAndRewrite(pylir::Mem::StackAllocTupleOp op, OpAdaptor adaptor,
+                                        mlir::ConversionPatternRewriter& rewriter) const override
+    {
+        auto inBytes = sizeOf(getPyTupleType()) + sizeOf(pointer()) * op.getLength().getZExtValue();
+        auto memory = createStackAllocation(op, rewriter, inBytes, alignOf(getPyTupleType()));
+        pyObjectModel(op.getLoc(), rewriter, memory).typePtr(op.getLoc()).store(op.getLoc(), adaptor.getTypeObject());
+        rewriter.replaceOp(op, memory);
+        return mlir::success();
+    }
+};
+
 struct GCAllocObjectOpConversion : public ConvertPylirOpToLLVMPattern<pylir::Mem::GCAllocObjectOp>
 {
     using ConvertPylirOpToLLVMPattern<pylir::Mem::GCAllocObjectOp>::ConvertPylirOpToLLVMPattern;
@@ -2953,6 +3091,25 @@ struct ArithmeticSelectOpConversion : public ConvertPylirOpToLLVMPattern<mlir::a
     }
 };
 
+struct CondBranchOpWeightsConversion : public ConvertPylirOpToLLVMPattern<mlir::cf::CondBranchOp>
+{
+    using ConvertPylirOpToLLVMPattern::ConvertPylirOpToLLVMPattern;
+
+    mlir::LogicalResult matchAndRewrite(mlir::cf::CondBranchOp op, OpAdaptor adaptor,
+                                        mlir::ConversionPatternRewriter& rewriter) const override
+    {
+        auto weights = op->getAttrOfType<mlir::DenseIntElementsAttr>(pylir::Py::branchWeightsAttr);
+        if (!weights)
+        {
+            return mlir::failure();
+        }
+        rewriter.replaceOpWithNewOp<mlir::LLVM::CondBrOp>(op, adaptor.getCondition(), adaptor.getTrueDestOperands(),
+                                                          adaptor.getFalseDestOperands(), weights, op.getTrueDest(),
+                                                          op.getFalseDest());
+        return mlir::success();
+    }
+};
+
 struct UnreachableOpConversion : public ConvertPylirOpToLLVMPattern<pylir::Py::UnreachableOp>
 {
     using ConvertPylirOpToLLVMPattern::ConvertPylirOpToLLVMPattern;
@@ -3025,6 +3182,8 @@ void ConvertPylirToLLVMPass::runOnOperation()
     patternSet.insert<SetSlotOpConversion>(converter);
     patternSet.insert<StrEqualOpConversion>(converter);
     patternSet.insert<GCAllocTupleConversion>(converter);
+    patternSet.insert<StackAllocObjectOpConversion>(converter);
+    patternSet.insert<StackAllocTupleOpConversion>(converter);
     patternSet.insert<GCAllocObjectOpConversion>(converter);
     patternSet.insert<GCAllocObjectConstTypeConversion>(converter, 2);
     patternSet.insert<InitObjectOpConversion>(converter);
@@ -3048,6 +3207,9 @@ void ConvertPylirToLLVMPass::runOnOperation()
     patternSet.insert<DictLenOpConversion>(converter);
     patternSet.insert<InitStrOpConversion>(converter);
     patternSet.insert<PrintOpConversion>(converter);
+    patternSet.insert<ProfileCallOpConversion>(converter);
+    patternSet.insert<ModuleInitStartOpConversion>(converter);
+    patternSet.insert<ModuleInitEndOpConversion>(converter);
     patternSet.insert<InitStrFromIntOpConversion>(converter);
     patternSet.insert<InvokeOpsConversion<pylir::Py::InvokeOp>>(converter);
     patternSet.insert<InvokeOpsConversion<pylir::Py::FunctionInvokeOp>>(converter);
@@ -3062,6 +3224,8 @@ void ConvertPylirToLLVMPass::runOnOperation()
     patternSet.insert<UnreachableOpConversion>(converter);
     patternSet.insert<TypeMROOpConversion>(converter);
     patternSet.insert<ArithmeticSelectOpConversion>(converter);
+    // Takes precedence over the upstream pattern, which does not know about branch weights.
+    patternSet.insert<CondBranchOpWeightsConversion>(converter, 2);
     patternSet.insert<TupleContainsOpConversion>(converter);
     patternSet.insert<InitTupleCopyOpConversion>(converter);
     if (mlir::failed(mlir::applyFullConversion(module, conversionTarget, std::move(patternSet))))
@@ -0,0 +1,9 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "StoreInterface.hpp"
+
+#include "pylir/Optimizer/Interfaces/StoreInterface.cpp.inc"
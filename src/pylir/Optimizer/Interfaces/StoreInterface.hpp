@@ -0,0 +1,11 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include <mlir/IR/OpDefinition.h>
+
+#include "pylir/Optimizer/Interfaces/StoreInterface.h.inc"
@@ -0,0 +1,20 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include <mlir/IR/BuiltinOps.h>
+#include <mlir/Pass/Pass.h>
+
+#include <pylir/Optimizer/PylirMem/IR/PylirMemDialect.hpp>
+
+#include "Passes.hpp"
+
+namespace
+{
+#define GEN_PASS_CLASSES
+#include <pylir/Optimizer/PylirMem/Transforms/Passes.h.inc>
+} // namespace
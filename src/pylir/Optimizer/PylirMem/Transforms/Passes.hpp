@@ -0,0 +1,20 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include <mlir/Pass/Pass.h>
+
+#include <memory>
+
+namespace pylir::Mem
+{
+std::unique_ptr<mlir::Pass> createStackAllocationPass();
+
+#define GEN_PASS_REGISTRATION
+#include "pylir/Optimizer/PylirMem/Transforms/Passes.h.inc"
+
+} // namespace pylir::Mem
@@ -0,0 +1,232 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/IR/FunctionInterfaces.h>
+#include <mlir/IR/Matchers.h>
+#include <mlir/IR/SymbolTable.h>
+#include <mlir/Interfaces/CallInterfaces.h>
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/TypeSwitch.h>
+
+#include <pylir/Optimizer/Interfaces/CaptureInterface.hpp>
+#include <pylir/Optimizer/PylirMem/IR/PylirMemOps.hpp>
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+#include <pylir/Optimizer/PylirPy/Util/Builtins.hpp>
+
+#include "PassDetail.hpp"
+
+namespace
+{
+
+/// Tuples with more elements than this are kept on the heap to bound the size of stack frames.
+constexpr std::size_t MAX_STACK_TUPLE_LENGTH = 64;
+
+class StackAllocationPass : public StackAllocationBase<StackAllocationPass>
+{
+protected:
+    void runOnOperation() override;
+};
+
+/// Interprocedural escape analysis. A value escapes if it may still be referenced after the function it was created
+/// in has returned. Returning it, passing it to a block argument, storing it into another object or using it in any
+/// op not known to be non-capturing conservatively counts as escaping. Passing it as argument to a call is only
+/// allowed if the callee is known and its corresponding argument does not escape either.
+class EscapeAnalysis
+{
+    mlir::SymbolTableCollection& m_collection;
+    /// Cached results for function arguments. Arguments are assumed to escape while they are being analysed, which
+    /// conservatively handles recursion.
+    llvm::DenseMap<mlir::Value, bool> m_argumentEscapes;
+
+    bool argumentEscapes(mlir::FunctionOpInterface function, unsigned index)
+    {
+        if (function.isExternal() || index >= function.getNumArguments())
+        {
+            return true;
+        }
+        mlir::Value argument = function.getArgument(index);
+        auto [iter, inserted] = m_argumentEscapes.insert({argument, true});
+        if (!inserted)
+        {
+            return iter->second;
+        }
+        bool result = escapes(argument);
+        m_argumentEscapes[argument] = result;
+        return result;
+    }
+
+public:
+    explicit EscapeAnalysis(mlir::SymbolTableCollection& collection) : m_collection(collection) {}
+
+    bool escapes(mlir::Value value)
+    {
+        for (auto& use : value.getUses())
+        {
+            auto* user = use.getOwner();
+            if (auto capture = mlir::dyn_cast<pylir::CaptureInterface>(user))
+            {
+                if (capture.capturesOperand(use.getOperandNumber()))
+                {
+                    return true;
+                }
+                continue;
+            }
+            auto call = mlir::dyn_cast<mlir::CallOpInterface>(user);
+            if (!call)
+            {
+                return true;
+            }
+            auto function = mlir::dyn_cast_or_null<mlir::FunctionOpInterface>(call.resolveCallable(&m_collection));
+            auto arguments = call.getArgOperands();
+            if (!function || arguments.empty() || use.getOperandNumber() < arguments.getBeginOperandIndex()
+                || use.getOperandNumber() >= arguments.getBeginOperandIndex() + arguments.size())
+            {
+                return true;
+            }
+            if (argumentEscapes(function, use.getOperandNumber() - arguments.getBeginOperandIndex()))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/// Returns true if objects whose type is 'typeObject' are known to not own any memory in the runtime. Stack
+/// allocated objects are never swept by the garbage collector, which would leak e.g. the buffers of integers, strings
+/// and dictionaries.
+bool isTriviallyDestructible(mlir::SymbolTableCollection& collection, mlir::Value typeObject)
+{
+    auto constant = typeObject.getDefiningOp<pylir::Py::ConstantOp>();
+    if (!constant)
+    {
+        return false;
+    }
+    auto ref = constant.getConstant().dyn_cast<mlir::FlatSymbolRefAttr>();
+    if (!ref)
+    {
+        return false;
+    }
+    auto global = collection.lookupNearestSymbolFrom<pylir::Py::GlobalValueOp>(constant, ref);
+    if (!global || !global.getInitializerAttr())
+    {
+        return false;
+    }
+    auto typeAttr = global.getInitializerAttr().dyn_cast<pylir::Py::TypeAttr>();
+    if (!typeAttr)
+    {
+        return false;
+    }
+    auto mro = typeAttr.getMroTuple().dyn_cast<pylir::Py::TupleAttr>();
+    if (!mro)
+    {
+        return false;
+    }
+    auto ownsMemory = [](mlir::Attribute attr)
+    {
+        auto base = attr.dyn_cast<mlir::FlatSymbolRefAttr>();
+        if (!base)
+        {
+            return true;
+        }
+        auto name = base.getValue();
+        return name == llvm::StringRef{pylir::Py::Builtins::Int.name}
+               || name == llvm::StringRef{pylir::Py::Builtins::Str.name}
+               || name == llvm::StringRef{pylir::Py::Builtins::Dict.name};
+    };
+    return !ownsMemory(ref) && llvm::none_of(mro.getValue(), ownsMemory);
+}
+
+/// Returns the op initializing the memory allocated by 'allocation' if it is its only use.
+mlir::Operation* getInitializer(mlir::Operation* allocation)
+{
+    auto memory = allocation->getResult(0);
+    if (!memory.hasOneUse())
+    {
+        return nullptr;
+    }
+    auto& use = *memory.getUses().begin();
+    if (use.getOperandNumber() != 0 || use.getOwner()->getNumResults() != 1)
+    {
+        return nullptr;
+    }
+    return use.getOwner();
+}
+
+void StackAllocationPass::runOnOperation()
+{
+    mlir::SymbolTableCollection collection;
+    EscapeAnalysis escapeAnalysis(collection);
+    bool changed = false;
+
+    llvm::SmallVector<pylir::Mem::GCAllocObjectOp> objects;
+    llvm::SmallVector<pylir::Mem::GCAllocTupleOp> tuples;
+    getOperation()->walk(
+        [&](mlir::Operation* op)
+        {
+            llvm::TypeSwitch<mlir::Operation*>(op)
+                .Case([&](pylir::Mem::GCAllocObjectOp allocOp) { objects.push_back(allocOp); })
+                .Case([&](pylir::Mem::GCAllocTupleOp allocOp) { tuples.push_back(allocOp); });
+        });
+
+    for (auto allocOp : objects)
+    {
+        auto* init = getInitializer(allocOp);
+        if (!init || !mlir::isa<pylir::Mem::InitObjectOp, pylir::Mem::InitListOp, pylir::Mem::InitFloatOp>(init))
+        {
+            continue;
+        }
+        if (!isTriviallyDestructible(collection, allocOp.getTypeObject())
+            || escapeAnalysis.escapes(init->getResult(0)))
+        {
+            continue;
+        }
+        mlir::OpBuilder builder(allocOp);
+        auto stackAlloc = builder.create<pylir::Mem::StackAllocObjectOp>(allocOp.getLoc(), allocOp.getTypeObject());
+        allocOp.getResult().replaceAllUsesWith(stackAlloc);
+        allocOp->erase();
+        m_objectsStackAllocated++;
+        changed = true;
+    }
+
+    for (auto allocOp : tuples)
+    {
+        auto* init = getInitializer(allocOp);
+        if (!init || !mlir::isa<pylir::Mem::InitTupleOp>(init))
+        {
+            continue;
+        }
+        mlir::IntegerAttr length;
+        if (!mlir::matchPattern(allocOp.getLength(), mlir::m_Constant(&length))
+            || length.getValue().ugt(MAX_STACK_TUPLE_LENGTH))
+        {
+            continue;
+        }
+        if (escapeAnalysis.escapes(init->getResult(0)))
+        {
+            continue;
+        }
+        mlir::OpBuilder builder(allocOp);
+        auto stackAlloc = builder.create<pylir::Mem::StackAllocTupleOp>(allocOp.getLoc(), allocOp.getTypeObject(),
+                                                                        builder.getIndexAttr(length.getInt()));
+        allocOp.getResult().replaceAllUsesWith(stackAlloc);
+        allocOp->erase();
+        m_tuplesStackAllocated++;
+        changed = true;
+    }
+
+    if (!changed)
+    {
+        markAllAnalysesPreserved();
+    }
+}
+} // namespace
+
+std::unique_ptr<mlir::Pass> pylir::Mem::createStackAllocationPass()
+{
+    return std::make_unique<StackAllocationPass>();
+}
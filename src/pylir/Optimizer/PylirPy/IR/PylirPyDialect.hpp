@@ -17,4 +17,8 @@ constexpr llvm::StringLiteral specializationOfAttr = "py.specialization_of";
 constexpr llvm::StringLiteral specializationTypeAttr = "py.specialization_args";
 
 constexpr llvm::StringLiteral alwaysBoundAttr = "py.always_bound";
+
+constexpr llvm::StringLiteral profileCountAttr = "py.profile_count";
+
+constexpr llvm::StringLiteral branchWeightsAttr = "py.branch_weights";
 } // namespace pylir::Py
@@ -639,39 +639,36 @@ mlir::LogicalResult pylir::Py::IntToIntegerOp::fold(::llvm::ArrayRef<::mlir::Att
     return mlir::success();
 }
 
-mlir::OpFoldResult pylir::Py::IsUnboundValueOp::fold(::llvm::ArrayRef<::mlir::Attribute> operands)
+bool pylir::Py::isAlwaysBound(mlir::Value value)
 {
-    if (operands[0])
+    if (auto blockArg = value.dyn_cast<mlir::BlockArgument>(); blockArg)
     {
-        return mlir::BoolAttr::get(getContext(), operands[0].isa<Py::UnboundAttr>());
+        return mlir::isa_and_nonnull<mlir::FunctionOpInterface>(blockArg.getOwner()->getParentOp())
+               && blockArg.getOwner()->isEntryBlock();
     }
-    if (auto blockArg = getValue().dyn_cast<mlir::BlockArgument>(); blockArg)
-    {
-        if (mlir::isa_and_nonnull<mlir::FunctionOpInterface>(blockArg.getOwner()->getParentOp())
-            && blockArg.getOwner()->isEntryBlock())
-        {
-            return mlir::BoolAttr::get(getContext(), false);
-        }
-        return nullptr;
-    }
-    // If the defining op has the AlwaysBound trait then it is false. Also manually sanction some ops from other
+    // If the defining op has the AlwaysBound trait then it is bound. Also manually sanction some ops from other
     // dialects
-    auto* op = getValue().getDefiningOp();
-    if (!op)
-    {
-        return nullptr;
-    }
+    auto* op = value.getDefiningOp();
     if (op->hasTrait<Py::AlwaysBound>() || op->hasAttr(Py::alwaysBoundAttr))
     {
-        return mlir::BoolAttr::get(getContext(), false);
+        return true;
     }
     auto callOpInterface = mlir::dyn_cast<mlir::CallOpInterface>(op);
     if (!callOpInterface)
     {
-        return nullptr;
+        return false;
     }
     auto func = mlir::dyn_cast_or_null<mlir::FunctionOpInterface>(callOpInterface.resolveCallable());
-    if (func && func.getResultAttr(getValue().cast<mlir::OpResult>().getResultNumber(), Py::alwaysBoundAttr))
+    return func && func.getResultAttr(value.cast<mlir::OpResult>().getResultNumber(), Py::alwaysBoundAttr);
+}
+
+mlir::OpFoldResult pylir::Py::IsUnboundValueOp::fold(::llvm::ArrayRef<::mlir::Attribute> operands)
+{
+    if (operands[0])
+    {
+        return mlir::BoolAttr::get(getContext(), operands[0].isa<Py::UnboundAttr>());
+    }
+    if (isAlwaysBound(getValue()))
     {
         return mlir::BoolAttr::get(getContext(), false);
     }
@@ -8,6 +8,7 @@
 
 #include <mlir/IR/Builders.h>
 #include <mlir/IR/BuiltinOps.h>
+#include <mlir/IR/Matchers.h>
 #include <mlir/IR/OpImplementation.h>
 
 #include <llvm/ADT/ScopeExit.h>
@@ -176,6 +177,80 @@ bool pylir::Py::ListSetItemOp::capturesOperand(unsigned int index)
     return static_cast<mlir::OperandRange>(getElementMutable()).getBeginOperandIndex() == index;
 }
 
+bool pylir::Py::DictSetItemOp::capturesOperand(unsigned int index)
+{
+    return static_cast<mlir::OperandRange>(getDictMutable()).getBeginOperandIndex() != index;
+}
+
+mlir::Value pylir::Py::SetSlotOp::getStoredLocation()
+{
+    return getObject();
+}
+
+bool pylir::Py::SetSlotOp::isOverwrittenBy(mlir::Operation* later)
+{
+    auto setSlotOp = mlir::dyn_cast<Py::SetSlotOp>(later);
+    return setSlotOp && setSlotOp.getObject() == getObject() && setSlotOp.getSlotAttr() == getSlotAttr();
+}
+
+mlir::Value pylir::Py::ListSetItemOp::getStoredLocation()
+{
+    return getList();
+}
+
+bool pylir::Py::ListSetItemOp::isOverwrittenBy(mlir::Operation* later)
+{
+    auto setItemOp = mlir::dyn_cast<Py::ListSetItemOp>(later);
+    return setItemOp && setItemOp.getList() == getList() && setItemOp.getIndex() == getIndex();
+}
+
+mlir::Value pylir::Py::DictSetItemOp::getStoredLocation()
+{
+    return getDict();
+}
+
+bool pylir::Py::DictSetItemOp::isOverwrittenBy(mlir::Operation* later)
+{
+    // Only valid for stores whose key is a builtin str or int constant, see 'isPureStore'. Hashing and comparing these
+    // can not execute user code, making the same key always refer to the same entry. Deleting the entry only
+    // overwrites it if nothing observes whether it existed.
+    return llvm::TypeSwitch<mlir::Operation*, bool>(later)
+        .Case([&](Py::DictSetItemOp op) { return op.getDict() == getDict() && op.getKey() == getKey(); })
+        .Case([&](Py::DictDelItemOp op)
+              { return op.getDict() == getDict() && op.getKey() == getKey() && op.getExisted().use_empty(); })
+        .Default(false);
+}
+
+bool pylir::Py::DictSetItemOp::isPureStore()
+{
+    // Any other key may have a '__hash__' or '__eq__' implementation executing arbitrary code.
+    mlir::Attribute attr;
+    if (!mlir::matchPattern(getKey(), mlir::m_Constant(&attr)))
+    {
+        return false;
+    }
+    if (auto str = attr.dyn_cast<Py::StrAttr>())
+    {
+        return str.getTypeObject().getValue() == llvm::StringRef{pylir::Py::Builtins::Str.name};
+    }
+    if (auto integer = attr.dyn_cast<Py::IntAttr>())
+    {
+        return integer.getTypeObject().getValue() == llvm::StringRef{pylir::Py::Builtins::Int.name};
+    }
+    return false;
+}
+
+mlir::Value pylir::Py::StoreOp::getStoredLocation()
+{
+    return nullptr;
+}
+
+bool pylir::Py::StoreOp::isOverwrittenBy(mlir::Operation* later)
+{
+    auto storeOp = mlir::dyn_cast<Py::StoreOp>(later);
+    return storeOp && storeOp.getHandleAttr() == getHandleAttr();
+}
+
 namespace
 {
 bool parseIterArguments(mlir::OpAsmParser& parser,
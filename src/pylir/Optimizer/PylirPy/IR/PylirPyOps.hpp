@@ -18,6 +18,7 @@
 
 #include <pylir/Optimizer/Interfaces/CaptureInterface.hpp>
 #include <pylir/Optimizer/Interfaces/MemoryFoldInterface.hpp>
+#include <pylir/Optimizer/Interfaces/StoreInterface.hpp>
 #include <pylir/Optimizer/PylirPy/IR/TypeRefineableInterface.hpp>
 #include <pylir/Optimizer/PylirPy/Interfaces/ExceptionHandlingInterface.hpp>
 
@@ -188,6 +189,9 @@ public:
     }
 };
 
+/// Returns true if 'value' is known to never be unbound.
+bool isAlwaysBound(mlir::Value value);
+
 } // namespace pylir::Py
 
 #include <pylir/Optimizer/PylirPy/IR/PylirPyOpsEnums.h.inc>
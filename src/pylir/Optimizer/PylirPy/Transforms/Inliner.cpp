@@ -185,6 +185,12 @@ protected:
         std::int32_t cost = getChildAnalysis<pylir::BodySize>(callableOpInterface).getSize();
         cost -= 1;                                       // Call instruction
         cost -= callOpInterface.getArgOperands().size(); // Call Arguments
+        // Calls that a profile has shown to be hot are given a larger budget.
+        if (auto count = callOpInterface->getAttrOfType<mlir::IntegerAttr>(pylir::Py::profileCountAttr);
+            count && count.getValue().getZExtValue() >= m_hotCallCount)
+        {
+            cost /= 2;
+        }
         return cost;
     }
 };
@@ -0,0 +1,509 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/Analysis/AliasAnalysis.h>
+#include <mlir/Dialect/ControlFlow/IR/ControlFlowOps.h>
+#include <mlir/IR/BlockAndValueMapping.h>
+#include <mlir/IR/Dominance.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+
+#include <llvm/ADT/DenseSet.h>
+
+#include <pylir/Optimizer/Analysis/AliasSetTracker.hpp>
+#include <pylir/Optimizer/Analysis/LoopInfo.hpp>
+#include <pylir/Optimizer/Analysis/MemorySSA.hpp>
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+#include <pylir/Optimizer/Transforms/Util/SSABuilder.hpp>
+
+#include "PassDetail.hpp"
+
+namespace
+{
+class LoopInvariantCodeMotion : public LoopInvariantCodeMotionBase<LoopInvariantCodeMotion>
+{
+    bool hoistInvariants(pylir::Loop& loop, mlir::Block* preheader, pylir::MemorySSA& memorySSA,
+                         mlir::AliasAnalysis& aliasAnalysis, mlir::DominanceInfo& dominanceInfo);
+
+    bool versionLoops(pylir::Loop& loop);
+
+protected:
+    void runOnOperation() override;
+};
+
+/// Returns the preheader of 'loop' or null if it has none. The preheader is the single predecessor of the header
+/// outside the loop, which unconditionally branches to the header.
+mlir::Block* getPreheader(pylir::Loop& loop)
+{
+    mlir::Block* preheader = nullptr;
+    for (auto* pred : loop.getHeader()->getPredecessors())
+    {
+        if (loop.contains(pred))
+        {
+            continue;
+        }
+        if (preheader && preheader != pred)
+        {
+            return nullptr;
+        }
+        preheader = pred;
+    }
+    if (!preheader || !mlir::isa<mlir::cf::BranchOp>(preheader->getTerminator()))
+    {
+        return nullptr;
+    }
+    return preheader;
+}
+
+/// Creates a new preheader for 'loop' and redirects all edges entering the loop to it.
+void createPreheader(pylir::Loop& loop)
+{
+    auto* header = loop.getHeader();
+    auto* preheader = new mlir::Block;
+    header->getParent()->getBlocks().insert(header->getIterator(), preheader);
+    llvm::SmallVector<mlir::Value> arguments;
+    for (auto iter : header->getArguments())
+    {
+        arguments.push_back(preheader->addArgument(iter.getType(), iter.getLoc()));
+    }
+    for (auto& use : llvm::make_early_inc_range(header->getUses()))
+    {
+        if (loop.contains(use.getOwner()->getBlock()))
+        {
+            continue;
+        }
+        use.getOwner()->setSuccessor(preheader, use.getOperandNumber());
+    }
+    auto builder = mlir::OpBuilder::atBlockEnd(preheader);
+    builder.create<mlir::cf::BranchOp>(header->front().getLoc(), header, arguments);
+}
+
+void collectLoops(pylir::Loop* loop, std::vector<pylir::Loop*>& loops)
+{
+    for (auto* iter : *loop)
+    {
+        collectLoops(iter, loops);
+    }
+    loops.push_back(loop);
+}
+
+/// Returns true if executing 'op' can never cause undefined behaviour, regardless of whether it'd have been executed
+/// in the original program.
+bool isSpeculatable(mlir::Operation* op)
+{
+    if (op->hasTrait<mlir::OpTrait::ConstantLike>() || mlir::isa<pylir::Py::IsOp, pylir::Py::IsUnboundValueOp>(op))
+    {
+        return true;
+    }
+    // Reading the type of an unbound object dereferences a null pointer. This is commonly guarded by a
+    // 'py.isUnboundValue' check within the loop, which it must not be hoisted above.
+    if (auto typeOf = mlir::dyn_cast<pylir::Py::TypeOfOp>(op))
+    {
+        return pylir::Py::isAlwaysBound(typeOf.getObject());
+    }
+    // These ops are only undefined if their input is not a type object or MRO tuple respectively. This can't be
+    // the case if they were computed by the ops below. A 'py.typeOf' outside the loop has necessarily executed prior
+    // to it, making its object bound.
+    if (auto typeMro = mlir::dyn_cast<pylir::Py::TypeMROOp>(op))
+    {
+        return typeMro.getTypeObject().getDefiningOp<pylir::Py::TypeOfOp>() != nullptr;
+    }
+    if (auto mroLookup = mlir::dyn_cast<pylir::Py::MROLookupOp>(op))
+    {
+        return mroLookup.getMroTuple().getDefiningOp<pylir::Py::TypeMROOp>() != nullptr;
+    }
+    return false;
+}
+
+/// Memory written to within a loop.
+class LoopClobbers
+{
+    pylir::AliasSetTracker m_tracker;
+    llvm::DenseSet<mlir::Value> m_written;
+    llvm::DenseSet<mlir::Attribute> m_storedHandles;
+    bool m_clobbersEverything = false;
+
+public:
+    LoopClobbers(pylir::Loop& loop, pylir::MemorySSA& memorySSA, mlir::AliasAnalysis& aliasAnalysis)
+        : m_tracker(aliasAnalysis)
+    {
+        for (auto* block : loop.getBlocks())
+        {
+            block->walk(
+                [&](mlir::Operation* op)
+                {
+                    if (!mlir::isa_and_nonnull<pylir::MemSSA::MemoryDefOp>(memorySSA.getMemoryAccess(op)))
+                    {
+                        return;
+                    }
+                    // Handles are not modelled by MemorySSA, which hence treats every load and store of a handle as
+                    // a def. They do however not write to any object.
+                    if (mlir::isa<pylir::Py::LoadOp>(op))
+                    {
+                        return;
+                    }
+                    if (auto storeOp = mlir::dyn_cast<pylir::Py::StoreOp>(op))
+                    {
+                        m_storedHandles.insert(storeOp.getHandleAttr());
+                        return;
+                    }
+                    llvm::SmallVector<mlir::MemoryEffects::EffectInstance> effects;
+                    if (auto memoryEffectOpInterface = mlir::dyn_cast<mlir::MemoryEffectOpInterface>(op))
+                    {
+                        memoryEffectOpInterface.getEffects(effects);
+                    }
+                    bool hasWrite = false;
+                    for (auto& iter : effects)
+                    {
+                        if (!llvm::isa<mlir::MemoryEffects::Write>(iter.getEffect()))
+                        {
+                            continue;
+                        }
+                        if (!iter.getValue())
+                        {
+                            m_clobbersEverything = true;
+                            return;
+                        }
+                        hasWrite = true;
+                        m_written.insert(iter.getValue());
+                        m_tracker.insert(iter.getValue());
+                    }
+                    // It is a def for reasons unknown to us, such as a call or capturing an object.
+                    if (!hasWrite)
+                    {
+                        m_clobbersEverything = true;
+                    }
+                });
+        }
+    }
+
+    /// Returns true if 'read' is not written to within the loop.
+    bool isInvariantRead(mlir::Value read)
+    {
+        if (m_clobbersEverything)
+        {
+            return false;
+        }
+        m_tracker.insert(read);
+        return llvm::none_of(m_tracker[read], [&](mlir::Value value) { return m_written.contains(value); });
+    }
+
+    /// Returns true if the handle loaded by 'loadOp' is not stored to within the loop.
+    bool isInvariantLoad(pylir::Py::LoadOp loadOp) const
+    {
+        return !m_clobbersEverything && !m_storedHandles.contains(loadOp.getHandleAttr());
+    }
+};
+
+bool LoopInvariantCodeMotion::hoistInvariants(pylir::Loop& loop, mlir::Block* preheader, pylir::MemorySSA& memorySSA,
+                                              mlir::AliasAnalysis& aliasAnalysis, mlir::DominanceInfo& dominanceInfo)
+{
+    LoopClobbers clobbers(loop, memorySSA, aliasAnalysis);
+
+    // Blocks that are guaranteed to be executed if the loop is entered are the ones dominating all latches and all
+    // blocks exiting the loop.
+    llvm::SmallVector<mlir::Block*> latchesAndExits;
+    for (auto* block : loop.getBlocks())
+    {
+        if (llvm::any_of(block->getSuccessors(),
+                         [&](mlir::Block* succ) { return succ == loop.getHeader() || !loop.contains(succ); }))
+        {
+            latchesAndExits.push_back(block);
+        }
+    }
+    auto isGuaranteedToExecute = [&](mlir::Block* block)
+    {
+        return llvm::all_of(latchesAndExits,
+                            [&](mlir::Block* latchOrExit) { return dominanceInfo.dominates(block, latchOrExit); });
+    };
+
+    auto isInvariant = [&](mlir::Operation* op)
+    {
+        if (op->getNumRegions() != 0 || op->hasTrait<mlir::OpTrait::IsTerminator>())
+        {
+            return false;
+        }
+        if (llvm::any_of(op->getOperands(), [&](mlir::Value value) { return loop.contains(value.getParentBlock()); }))
+        {
+            return false;
+        }
+        auto* access = memorySSA.getMemoryAccess(op);
+        if (auto loadOp = mlir::dyn_cast<pylir::Py::LoadOp>(op))
+        {
+            if (!clobbers.isInvariantLoad(loadOp))
+            {
+                return false;
+            }
+        }
+        else if (auto use = mlir::dyn_cast_or_null<pylir::MemSSA::MemoryUseOp>(access))
+        {
+            if (!clobbers.isInvariantRead(use.getRead()))
+            {
+                return false;
+            }
+        }
+        else if (access || !mlir::MemoryEffectOpInterface::hasNoEffect(op))
+        {
+            return false;
+        }
+        return isSpeculatable(op) || isGuaranteedToExecute(op->getBlock());
+    };
+
+    bool changed = false;
+    // Blocks are in reverse post order, making sure that operands are hoisted before their users.
+    for (auto* block : loop.getBlocks())
+    {
+        for (auto& op : llvm::make_early_inc_range(*block))
+        {
+            if (!isInvariant(&op))
+            {
+                continue;
+            }
+            // MemorySSA is kept up to date for the enclosing loops, which are processed later, and the passes after.
+            bool hasAccess = memorySSA.getMemoryAccess(&op) != nullptr;
+            if (hasAccess)
+            {
+                memorySSA.removeAccess(&op);
+            }
+            op.moveBefore(preheader->getTerminator());
+            if (hasAccess)
+            {
+                memorySSA.insertAccess(&op);
+            }
+            m_opsHoisted++;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/// Returns true if 'condition' is the result of checking the type of an object.
+bool isTypeGuard(mlir::Value condition)
+{
+    if (condition.getDefiningOp<pylir::Py::MROLookupOp>())
+    {
+        return true;
+    }
+    auto isOp = condition.getDefiningOp<pylir::Py::IsOp>();
+    if (!isOp)
+    {
+        return false;
+    }
+    return isOp.getLhs().getDefiningOp<pylir::Py::TypeOfOp>() || isOp.getRhs().getDefiningOp<pylir::Py::TypeOfOp>();
+}
+
+/// Replaces 'condBranchOp' with an unconditional branch to the successor taken if its condition is 'value'.
+void foldGuard(mlir::cf::CondBranchOp condBranchOp, bool value)
+{
+    mlir::OpBuilder builder(condBranchOp);
+    if (value)
+    {
+        builder.create<mlir::cf::BranchOp>(condBranchOp.getLoc(), condBranchOp.getTrueDest(),
+                                           condBranchOp.getTrueDestOperands());
+    }
+    else
+    {
+        builder.create<mlir::cf::BranchOp>(condBranchOp.getLoc(), condBranchOp.getFalseDest(),
+                                           condBranchOp.getFalseDestOperands());
+    }
+    condBranchOp.erase();
+}
+
+bool LoopInvariantCodeMotion::versionLoops(pylir::Loop& loop)
+{
+    mlir::cf::CondBranchOp guard;
+    std::size_t size = 0;
+    for (auto* block : loop.getBlocks())
+    {
+        block->walk([&](mlir::Operation*) { size++; });
+        auto condBranchOp = mlir::dyn_cast<mlir::cf::CondBranchOp>(block->getTerminator());
+        if (!guard && condBranchOp && !loop.contains(condBranchOp.getCondition().getParentBlock())
+            && isTypeGuard(condBranchOp.getCondition()))
+        {
+            guard = condBranchOp;
+        }
+    }
+
+    auto* preheader = getPreheader(loop);
+    if (!guard || !preheader || size > m_maxVersionedLoopSize)
+    {
+        bool changed = false;
+        for (auto* iter : loop)
+        {
+            changed = versionLoops(*iter) || changed;
+        }
+        return changed;
+    }
+
+    // Create the version of the loop in which the guard fails. Blocks are in reverse post order, making sure that
+    // any value has been mapped before its uses are cloned.
+    auto& region = *loop.getHeader()->getParent();
+    auto insertionPoint = loop.getHeader()->getIterator();
+    for (auto& iter : region)
+    {
+        if (loop.contains(&iter))
+        {
+            insertionPoint = iter.getIterator();
+        }
+    }
+    mlir::BlockAndValueMapping mapping;
+    llvm::DenseSet<mlir::Block*> clones;
+    for (auto* block : loop.getBlocks())
+    {
+        auto* clone = new mlir::Block;
+        insertionPoint = region.getBlocks().insertAfter(insertionPoint, clone);
+        for (auto iter : block->getArguments())
+        {
+            mapping.map(iter, clone->addArgument(iter.getType(), iter.getLoc()));
+        }
+        mapping.map(block, clone);
+        clones.insert(clone);
+    }
+    for (auto* block : loop.getBlocks())
+    {
+        auto builder = mlir::OpBuilder::atBlockEnd(mapping.lookup(block));
+        for (auto& op : *block)
+        {
+            builder.clone(op, mapping);
+        }
+    }
+
+    auto entry = mlir::cast<mlir::cf::BranchOp>(preheader->getTerminator());
+    {
+        mlir::OpBuilder builder(entry);
+        builder.create<mlir::cf::CondBranchOp>(guard.getLoc(), guard.getCondition(), loop.getHeader(),
+                                               entry.getDestOperands(), mapping.lookup(loop.getHeader()),
+                                               entry.getDestOperands());
+        entry.erase();
+    }
+
+    // Values defined within the loop may be used after the loop, which is now reached from either version of it.
+    pylir::SSABuilder ssaBuilder;
+    auto repairUses = [&](mlir::Value value)
+    {
+        llvm::SmallVector<mlir::OpOperand*> uses;
+        for (auto& use : value.getUses())
+        {
+            auto* block = region.findAncestorBlockInRegion(*use.getOwner()->getBlock());
+            if (!loop.contains(block) && !clones.contains(block))
+            {
+                uses.push_back(&use);
+            }
+        }
+        if (uses.empty())
+        {
+            return;
+        }
+        pylir::SSABuilder::DefinitionsMap definitions;
+        definitions[value.getParentBlock()] = value;
+        auto clone = mapping.lookup(value);
+        definitions[clone.getParentBlock()] = clone;
+        for (auto* use : uses)
+        {
+            auto* block = region.findAncestorBlockInRegion(*use->getOwner()->getBlock());
+            use->set(ssaBuilder.readVariable(value.getLoc(), value.getType(), definitions, block));
+        }
+    };
+    for (auto* block : loop.getBlocks())
+    {
+        for (auto iter : block->getArguments())
+        {
+            repairUses(iter);
+        }
+        for (auto& op : *block)
+        {
+            for (auto iter : op.getResults())
+            {
+                repairUses(iter);
+            }
+        }
+    }
+
+    auto cloneGuard = mlir::cast<mlir::cf::CondBranchOp>(mapping.lookup(guard->getBlock())->getTerminator());
+    foldGuard(guard, true);
+    foldGuard(cloneGuard, false);
+    m_loopsVersioned++;
+    return true;
+}
+
+void LoopInvariantCodeMotion::runOnOperation()
+{
+    if (getOperation()->getNumRegions() != 1 || getOperation()->getRegion(0).empty())
+    {
+        markAllAnalysesPreserved();
+        return;
+    }
+
+    bool changed = false;
+    {
+        auto& loopInfo = getAnalysis<pylir::LoopInfo>();
+        if (loopInfo.getTopLevelLoops().empty())
+        {
+            markAllAnalysesPreserved();
+            return;
+        }
+        std::vector<pylir::Loop*> loops;
+        for (auto* iter : loopInfo.getTopLevelLoops())
+        {
+            collectLoops(iter, loops);
+        }
+        for (auto* iter : loops)
+        {
+            if (!getPreheader(*iter))
+            {
+                createPreheader(*iter);
+                changed = true;
+            }
+        }
+    }
+    if (changed)
+    {
+        // Inserting preheaders changes the loop structure. Recompute all analyses.
+        getAnalysisManager().invalidate({});
+    }
+
+    auto& loopInfo = getAnalysis<pylir::LoopInfo>();
+    auto& memorySSA = getAnalysis<pylir::MemorySSA>();
+    auto& aliasAnalysis = getAnalysis<mlir::AliasAnalysis>();
+    auto& dominanceInfo = getAnalysis<mlir::DominanceInfo>();
+    std::vector<pylir::Loop*> loops;
+    for (auto* iter : loopInfo.getTopLevelLoops())
+    {
+        collectLoops(iter, loops);
+    }
+    // Loops are in post order, hoisting out of inner loops first. Their preheaders are part of the outer loop.
+    for (auto* iter : loops)
+    {
+        if (auto* preheader = getPreheader(*iter))
+        {
+            changed = hoistInvariants(*iter, preheader, memorySSA, aliasAnalysis, dominanceInfo) || changed;
+        }
+    }
+
+    // Type guards whose conditions are now outside the loop are moved in front of the loop by versioning the loop.
+    bool versioned = false;
+    for (auto* iter : loopInfo.getTopLevelLoops())
+    {
+        versioned = versionLoops(*iter) || versioned;
+    }
+
+    if (!changed && !versioned)
+    {
+        markAllAnalysesPreserved();
+        return;
+    }
+    // Hoisting does not change the CFG and updates MemorySSA. Any analyses invalidated due to inserting preheaders
+    // have been recomputed afterwards. Versioning on the other hand duplicates loops wholesale.
+    if (!versioned)
+    {
+        markAnalysesPreserved<mlir::DominanceInfo, pylir::LoopInfo, pylir::MemorySSA>();
+    }
+}
+} // namespace
+
+std::unique_ptr<mlir::Pass> pylir::Py::createLoopInvariantCodeMotionPass()
+{
+    return std::make_unique<LoopInvariantCodeMotion>();
+}
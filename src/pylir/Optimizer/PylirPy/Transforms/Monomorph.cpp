@@ -7,10 +7,18 @@
 #include <mlir/Analysis/Liveness.h>
 #include <mlir/IR/BlockAndValueMapping.h>
 #include <mlir/IR/Dominance.h>
+#include <mlir/IR/SubElementInterfaces.h>
+#include <mlir/IR/Threading.h>
+#include <mlir/Parser/Parser.h>
 
 #include <llvm/ADT/DepthFirstIterator.h>
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/TypeSwitch.h>
-#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/FileUtilities.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/raw_sha1_ostream.h>
 
 #include <pylir/Optimizer/Analysis/LoopInfo.hpp>
 #include <pylir/Optimizer/PylirPy/Analysis/TypeFlow.hpp>
@@ -23,6 +31,7 @@
 #include <pylir/Support/Macros.hpp>
 #include <pylir/Support/Variant.hpp>
 
+#include <mutex>
 #include <queue>
 #include <unordered_map>
 #include <utility>
@@ -37,6 +46,14 @@ class Monomorph : public MonomorphBase<Monomorph>
 {
 protected:
     void runOnOperation() override;
+
+public:
+    Monomorph() = default;
+
+    explicit Monomorph(llvm::StringRef cacheFile)
+    {
+        m_cacheFile = cacheFile.str();
+    }
 };
 
 using TypeFlowArgValue = llvm::PointerUnion<mlir::SymbolRefAttr, pylir::Py::ObjectTypeInterface>;
@@ -1020,13 +1037,542 @@ public:
 template <class F>
 FilteredDFIteratorSet(F) -> FilteredDFIteratorSet<typename llvm::function_traits<F>::template arg_t<0>, F>;
 
+/// SymbolTableCollection caches symbol tables when used and may therefore not be shared between threads. This class
+/// lazily creates a separate collection for every thread it is used on.
+class ThreadLocalSymbolTableCollection
+{
+    std::mutex m_mutex;
+    llvm::DenseMap<std::uint64_t, std::unique_ptr<mlir::SymbolTableCollection>> m_collections;
+
+public:
+    mlir::SymbolTableCollection& get()
+    {
+        std::lock_guard lock{m_mutex};
+        auto& collection = m_collections[llvm::get_threadid()];
+        if (!collection)
+        {
+            collection = std::make_unique<mlir::SymbolTableCollection>();
+        }
+        return *collection;
+    }
+};
+
+/// Results of the type flow analysis of a function specialization. Values and operations refer to the original function
+/// the specialization was created from.
+struct SpecializationResult
+{
+    std::vector<pylir::Py::ObjectTypeInterface> returnTypes;
+    std::vector<std::pair<mlir::Value, mlir::Attribute>> values;
+    llvm::DenseMap<mlir::Operation*, FunctionSpecialization> callSites;
+};
+
+/// Cache of specialization results that is persisted in a file across compilations. Entries are keyed by a hash of
+/// the argument types, the function and all symbols transitively referenced by either the function or the argument
+/// types. A change to any of these may change the results of the analysis. Values and call sites are stored by their
+/// position within the function.
+class MonomorphCache
+{
+    mlir::ModuleOp m_module;
+    mlir::SymbolTable& m_table;
+    std::string m_path;
+    llvm::StringMap<mlir::DictionaryAttr> m_entries;
+    llvm::DenseMap<mlir::Operation*, std::string> m_symbolHashes;
+    llvm::DenseMap<mlir::Operation*, std::string> m_closureHashes;
+    std::size_t m_hits = 0;
+
+    static constexpr llvm::StringLiteral cacheAttrName = "pylir.monomorph_cache";
+
+    const std::string& getSymbolHash(mlir::Operation* symbol)
+    {
+        auto [iter, inserted] = m_symbolHashes.insert({symbol, ""});
+        if (inserted)
+        {
+            llvm::raw_sha1_ostream stream;
+            symbol->print(stream, mlir::OpPrintingFlags{}.useLocalScope().assumeVerified());
+            iter->second = llvm::toHex(stream.sha1());
+        }
+        return iter->second;
+    }
+
+    /// Returns all symbols directly referenced by 'symbol'.
+    std::vector<mlir::Operation*> getReferencedSymbols(mlir::Operation* symbol)
+    {
+        llvm::SetVector<mlir::Operation*> result;
+        symbol->walk(
+            [&](mlir::Operation* op)
+            {
+                op->getAttrDictionary().cast<mlir::SubElementAttrInterface>().walkSubAttrs(
+                    [&](mlir::Attribute attr)
+                    {
+                        auto ref = attr.dyn_cast<mlir::SymbolRefAttr>();
+                        if (!ref)
+                        {
+                            return;
+                        }
+                        if (auto* referenced = m_table.lookup(ref.getRootReference()))
+                        {
+                            result.insert(referenced);
+                        }
+                    });
+            });
+        return result.takeVector();
+    }
+
+    /// Returns a hash of 'function' and all symbols transitively referenced by it. Symbols are hashed in strongly
+    /// connected components using Tarjan's algorithm: The hash of a component combines the hashes of its members with
+    /// the previously computed hashes of the components it references. Every symbol is therefore only printed and
+    /// traversed once, no matter how many closures it is part of. All members of a component share the same hash.
+    const std::string& getClosureHash(mlir::Operation* function)
+    {
+        if (auto result = m_closureHashes.find(function); result != m_closureHashes.end())
+        {
+            return result->second;
+        }
+
+        struct Frame
+        {
+            mlir::Operation* symbol;
+            std::size_t nextReference;
+        };
+        llvm::DenseMap<mlir::Operation*, std::vector<mlir::Operation*>> references;
+        llvm::DenseMap<mlir::Operation*, std::size_t> indices;
+        llvm::DenseMap<mlir::Operation*, std::size_t> lowLinks;
+        llvm::SetVector<mlir::Operation*> sccStack;
+        std::vector<Frame> frames;
+        auto push = [&](mlir::Operation* symbol)
+        {
+            auto index = indices.size();
+            indices[symbol] = index;
+            lowLinks[symbol] = index;
+            sccStack.insert(symbol);
+            references[symbol] = getReferencedSymbols(symbol);
+            frames.push_back({symbol, 0});
+        };
+
+        push(function);
+        while (!frames.empty())
+        {
+            auto* symbol = frames.back().symbol;
+            auto& symbolReferences = references[symbol];
+            if (frames.back().nextReference < symbolReferences.size())
+            {
+                auto* referenced = symbolReferences[frames.back().nextReference++];
+                if (m_closureHashes.count(referenced))
+                {
+                    continue;
+                }
+                if (!indices.count(referenced))
+                {
+                    push(referenced);
+                    continue;
+                }
+                if (sccStack.count(referenced))
+                {
+                    lowLinks[symbol] = std::min(lowLinks[symbol], indices[referenced]);
+                }
+                continue;
+            }
+
+            frames.pop_back();
+            if (!frames.empty())
+            {
+                auto& parentLowLink = lowLinks[frames.back().symbol];
+                parentLowLink = std::min(parentLowLink, lowLinks[symbol]);
+            }
+            if (lowLinks[symbol] != indices[symbol])
+            {
+                continue;
+            }
+
+            // 'symbol' is the root of a strongly connected component consisting of it and all symbols above it on the
+            // stack. Hashes are sorted to be independent of the order the component was traversed in.
+            llvm::SmallPtrSet<mlir::Operation*, 4> members;
+            mlir::Operation* member;
+            do
+            {
+                member = sccStack.pop_back_val();
+                members.insert(member);
+            } while (member != symbol);
+
+            std::vector<std::string> memberHashes;
+            std::vector<std::string> referencedHashes;
+            for (auto* iter : members)
+            {
+                memberHashes.push_back(getSymbolHash(iter));
+                for (auto* referenced : references[iter])
+                {
+                    if (!members.contains(referenced))
+                    {
+                        referencedHashes.push_back(m_closureHashes.find(referenced)->second);
+                    }
+                }
+            }
+            llvm::sort(memberHashes);
+            llvm::sort(referencedHashes);
+            referencedHashes.erase(std::unique(referencedHashes.begin(), referencedHashes.end()),
+                                   referencedHashes.end());
+
+            llvm::raw_sha1_ostream stream;
+            for (const auto& iter : memberHashes)
+            {
+                stream << iter;
+            }
+            stream << '\0';
+            for (const auto& iter : referencedHashes)
+            {
+                stream << iter;
+            }
+            auto hash = llvm::toHex(stream.sha1());
+            for (auto* iter : members)
+            {
+                m_closureHashes[iter] = hash;
+            }
+        }
+        return m_closureHashes.find(function)->second;
+    }
+
+    /// Adds the type objects referenced by 'type' and any types contained within it to 'refs'.
+    static void collectTypeObjects(pylir::Py::ObjectTypeInterface type,
+                                   llvm::SmallVectorImpl<mlir::FlatSymbolRefAttr>& refs)
+    {
+        if (auto typeObject = type.getTypeObject())
+        {
+            refs.push_back(typeObject);
+        }
+        llvm::TypeSwitch<mlir::Type>(type).Case<pylir::Py::TupleType, pylir::Py::VariantType>(
+            [&](auto type)
+            {
+                for (auto iter : type.getElements())
+                {
+                    collectTypeObjects(iter, refs);
+                }
+            });
+    }
+
+    static mlir::Attribute serialize(mlir::MLIRContext* context, TypeFlowArgValue value)
+    {
+        if (auto ref = value.dyn_cast<mlir::SymbolRefAttr>())
+        {
+            return ref;
+        }
+        if (auto type = value.dyn_cast<pylir::Py::ObjectTypeInterface>())
+        {
+            return mlir::TypeAttr::get(type);
+        }
+        return mlir::UnitAttr::get(context);
+    }
+
+    static TypeFlowArgValue deserializeArg(mlir::Attribute attr)
+    {
+        if (auto ref = attr.dyn_cast<mlir::SymbolRefAttr>())
+        {
+            return ref;
+        }
+        if (auto typeAttr = attr.dyn_cast<mlir::TypeAttr>())
+        {
+            return typeAttr.getValue().dyn_cast<pylir::Py::ObjectTypeInterface>();
+        }
+        return nullptr;
+    }
+
+    /// Returns all operations within 'function' in a deterministic order.
+    static std::vector<mlir::Operation*> getOperations(mlir::FunctionOpInterface function)
+    {
+        std::vector<mlir::Operation*> operations;
+        function->walk([&](mlir::Operation* op) { operations.push_back(op); });
+        return operations;
+    }
+
+    /// Returns the specialization stored in 'entry' or an empty optional if it is not contained in the module.
+    std::optional<FunctionSpecialization> getSpecialization(mlir::DictionaryAttr entry)
+    {
+        auto function = m_table.lookup<mlir::FunctionOpInterface>(
+            entry.getAs<mlir::FlatSymbolRefAttr>("function").getValue());
+        if (!function)
+        {
+            return std::nullopt;
+        }
+        std::vector<TypeFlowArgValue> argTypes;
+        llvm::transform(entry.getAs<mlir::ArrayAttr>("arguments"), std::back_inserter(argTypes), deserializeArg);
+        return FunctionSpecialization{function, std::move(argTypes)};
+    }
+
+    SpecializationResult deserialize(mlir::FunctionOpInterface function, mlir::DictionaryAttr entry,
+                                     const llvm::StringMap<FunctionSpecialization>& specializations)
+    {
+        SpecializationResult result;
+        for (auto iter : entry.getAs<mlir::ArrayAttr>("returns"))
+        {
+            pylir::Py::ObjectTypeInterface type;
+            if (auto typeAttr = iter.dyn_cast<mlir::TypeAttr>())
+            {
+                type = typeAttr.getValue().cast<pylir::Py::ObjectTypeInterface>();
+            }
+            result.returnTypes.push_back(type);
+        }
+
+        auto operations = getOperations(function);
+        for (auto iter : entry.getAs<mlir::ArrayAttr>("values").getAsRange<mlir::ArrayAttr>())
+        {
+            auto opIndex = iter[0].cast<mlir::IntegerAttr>().getInt();
+            auto index = iter[1].cast<mlir::IntegerAttr>().getInt();
+            auto value =
+                opIndex < 0 ? mlir::Value{function.getArgument(index)} : operations[opIndex]->getResult(index);
+            result.values.emplace_back(value, iter[2]);
+        }
+        for (auto iter : entry.getAs<mlir::ArrayAttr>("calls").getAsRange<mlir::ArrayAttr>())
+        {
+            auto* call = operations[iter[0].cast<mlir::IntegerAttr>().getInt()];
+            auto callee = iter[1].dyn_cast<mlir::StringAttr>();
+            result.callSites.insert({call, callee ? specializations.find(callee.getValue())->second :
+                                                    FunctionSpecialization{nullptr, {}}});
+        }
+        return result;
+    }
+
+public:
+    MonomorphCache(mlir::ModuleOp module, mlir::SymbolTable& table, llvm::StringRef path)
+        : m_module(module), m_table(table), m_path(path.str())
+    {
+        auto buffer = llvm::MemoryBuffer::getFile(m_path);
+        if (!buffer)
+        {
+            return;
+        }
+        // The cache is purely an optimization. A corrupt or outdated cache file is therefore simply ignored.
+        mlir::ScopedDiagnosticHandler handler(module.getContext(), [](mlir::Diagnostic&) { return mlir::success(); });
+        auto cache = mlir::parseSourceString<mlir::ModuleOp>((*buffer)->getBuffer(), module.getContext());
+        if (!cache)
+        {
+            return;
+        }
+        auto entries = (*cache)->getAttrOfType<mlir::DictionaryAttr>(cacheAttrName);
+        if (!entries)
+        {
+            return;
+        }
+        for (auto iter : entries)
+        {
+            auto entry = iter.getValue().dyn_cast<mlir::DictionaryAttr>();
+            if (!entry || !entry.getAs<mlir::FlatSymbolRefAttr>("function")
+                || !entry.getAs<mlir::ArrayAttr>("arguments") || !entry.getAs<mlir::ArrayAttr>("returns")
+                || !entry.getAs<mlir::ArrayAttr>("values") || !entry.getAs<mlir::ArrayAttr>("calls"))
+            {
+                continue;
+            }
+            m_entries[iter.getName().getValue()] = entry;
+        }
+    }
+
+    std::string getKey(const FunctionSpecialization& specialization)
+    {
+        llvm::raw_sha1_ostream stream;
+        // Functions within the same strongly connected component share their closure hash. The hash of the function
+        // itself distinguishes them.
+        stream << getSymbolHash(specialization.function);
+        stream << getClosureHash(specialization.function);
+        llvm::SmallVector<mlir::FlatSymbolRefAttr> refs;
+        for (auto iter : specialization.argTypes)
+        {
+            stream << '\0';
+            serialize(m_module.getContext(), iter).print(stream);
+            if (auto ref = iter.dyn_cast<mlir::SymbolRefAttr>())
+            {
+                refs.push_back(mlir::FlatSymbolRefAttr::get(ref.getRootReference()));
+            }
+            else if (auto type = iter.dyn_cast<pylir::Py::ObjectTypeInterface>())
+            {
+                collectTypeObjects(type, refs);
+            }
+        }
+        // Symbols only referenced by the argument types are not part of the closure of the function, but changes to
+        // them may change the results of the analysis all the same.
+        for (auto ref : refs)
+        {
+            if (auto* symbol = m_table.lookup(ref.getAttr()))
+            {
+                stream << '\0' << getClosureHash(symbol);
+            }
+        }
+        return llvm::toHex(stream.sha1());
+    }
+
+    /// Looks up 'specialization' in the cache and adds its result to 'results' on success. The results of all
+    /// specializations transitively called by 'specialization' are added as well.
+    bool lookup(const FunctionSpecialization& specialization,
+                llvm::MapVector<FunctionSpecialization, SpecializationResult>& results)
+    {
+        if (!specialization.function || m_entries.empty())
+        {
+            return false;
+        }
+        auto key = getKey(specialization);
+        if (!m_entries.count(key))
+        {
+            return false;
+        }
+
+        // Collect all entries required first to not add any results if one of the callees is missing.
+        llvm::StringMap<FunctionSpecialization> specializations;
+        specializations.insert({key, specialization});
+        std::vector<std::string> keys{key};
+        for (std::size_t i = 0; i < keys.size(); i++)
+        {
+            auto entry = m_entries.lookup(keys[i]);
+            for (auto iter : entry.getAs<mlir::ArrayAttr>("calls").getAsRange<mlir::ArrayAttr>())
+            {
+                auto callee = iter[1].dyn_cast<mlir::StringAttr>();
+                if (!callee || specializations.count(callee.getValue()))
+                {
+                    continue;
+                }
+                auto calleeEntry = m_entries.lookup(callee.getValue());
+                if (!calleeEntry)
+                {
+                    return false;
+                }
+                auto calleeSpecialization = getSpecialization(calleeEntry);
+                if (!calleeSpecialization)
+                {
+                    return false;
+                }
+                specializations.insert({callee.getValue(), std::move(*calleeSpecialization)});
+                keys.push_back(callee.getValue().str());
+            }
+        }
+
+        for (const auto& iter : keys)
+        {
+            const auto& current = specializations.find(iter)->second;
+            if (results.count(current))
+            {
+                continue;
+            }
+            results.insert({current, deserialize(current.function, m_entries.lookup(iter), specializations)});
+            m_hits++;
+        }
+        return true;
+    }
+
+    [[nodiscard]] std::size_t getHits() const
+    {
+        return m_hits;
+    }
+
+    void insert(const FunctionSpecialization& specialization, const SpecializationResult& result)
+    {
+        auto key = getKey(specialization);
+        if (m_entries.count(key))
+        {
+            return;
+        }
+
+        auto* context = m_module.getContext();
+        mlir::Builder builder(context);
+        auto operations = getOperations(specialization.function);
+        llvm::DenseMap<mlir::Operation*, std::int64_t> opIndices;
+        for (const auto& iter : llvm::enumerate(operations))
+        {
+            opIndices[iter.value()] = iter.index();
+        }
+
+        auto returns = llvm::to_vector(llvm::map_range(
+            result.returnTypes, [&](pylir::Py::ObjectTypeInterface type) { return serialize(context, type); }));
+        auto arguments = llvm::to_vector(
+            llvm::map_range(specialization.argTypes, [&](TypeFlowArgValue arg) { return serialize(context, arg); }));
+
+        // Values and call sites are collected in hash maps. They are sorted by their position to make the content of
+        // the cache file deterministic.
+        std::vector<std::pair<std::pair<std::int64_t, std::int64_t>, mlir::Attribute>> sortedValues;
+        for (auto [value, attr] : result.values)
+        {
+            std::int64_t opIndex = -1;
+            std::int64_t index;
+            if (auto blockArg = value.dyn_cast<mlir::BlockArgument>())
+            {
+                index = blockArg.getArgNumber();
+            }
+            else
+            {
+                opIndex = opIndices.lookup(value.getDefiningOp());
+                index = value.cast<mlir::OpResult>().getResultNumber();
+            }
+            sortedValues.push_back({{opIndex, index}, attr});
+        }
+        llvm::sort(sortedValues, llvm::less_first{});
+        llvm::SmallVector<mlir::Attribute> values;
+        for (auto [position, attr] : sortedValues)
+        {
+            values.push_back(builder.getArrayAttr(
+                {builder.getI64IntegerAttr(position.first), builder.getI64IntegerAttr(position.second), attr}));
+        }
+
+        std::vector<std::pair<std::int64_t, mlir::Attribute>> sortedCalls;
+        for (const auto& [call, callee] : result.callSites)
+        {
+            mlir::Attribute calleeKey = builder.getUnitAttr();
+            if (callee.function)
+            {
+                calleeKey = builder.getStringAttr(getKey(callee));
+            }
+            sortedCalls.emplace_back(opIndices.lookup(call), calleeKey);
+        }
+        llvm::sort(sortedCalls, llvm::less_first{});
+        llvm::SmallVector<mlir::Attribute> calls;
+        for (auto [opIndex, calleeKey] : sortedCalls)
+        {
+            calls.push_back(builder.getArrayAttr({builder.getI64IntegerAttr(opIndex), calleeKey}));
+        }
+
+        m_entries[key] = builder.getDictionaryAttr({
+            builder.getNamedAttr("function", mlir::FlatSymbolRefAttr::get(specialization.function)),
+            builder.getNamedAttr("arguments", builder.getArrayAttr(arguments)),
+            builder.getNamedAttr("returns", builder.getArrayAttr(returns)),
+            builder.getNamedAttr("values", builder.getArrayAttr(values)),
+            builder.getNamedAttr("calls", builder.getArrayAttr(calls)),
+        });
+    }
+
+    void save()
+    {
+        auto* context = m_module.getContext();
+        llvm::SmallVector<mlir::NamedAttribute> entries;
+        for (auto& iter : m_entries)
+        {
+            entries.emplace_back(mlir::StringAttr::get(context, iter.first()), iter.second);
+        }
+        mlir::OwningOpRef<mlir::ModuleOp> cache = mlir::ModuleOp::create(mlir::UnknownLoc::get(context));
+        (*cache)->setAttr(cacheAttrName, mlir::DictionaryAttr::get(context, entries));
+
+        std::string content;
+        llvm::raw_string_ostream stream(content);
+        cache->print(stream);
+
+        // Like the compilation cache, failing to write the cache is not an error.
+        if (llvm::sys::fs::create_directories(llvm::sys::path::parent_path(m_path)))
+        {
+            return;
+        }
+        if (auto error = llvm::writeFileAtomically(m_path + "-%%%%%%%%", m_path, stream.str()))
+        {
+            llvm::consumeError(std::move(error));
+        }
+    }
+};
+
 /// Responsible for managing Orchestrators and their execution.
 class Scheduler
 {
     llvm::DenseMap<mlir::FunctionOpInterface, std::unique_ptr<TypeFlowInstance>> m_typeFlowInstances;
     llvm::MapVector<FunctionSpecialization, std::unique_ptr<Orchestrator>> m_orchestrators;
 
-    using Queue = std::queue<std::pair<ExecutionFrame, InQueueCount>>;
+    ThreadLocalSymbolTableCollection m_collections;
+    MonomorphCache* m_cache;
+    llvm::MapVector<FunctionSpecialization, SpecializationResult> m_cachedResults;
+
+    using QueueItem = std::pair<ExecutionFrame, InQueueCount>;
+    using Queue = std::queue<QueueItem>;
+    using OrchestratorResult = std::variant<std::vector<ExecutionFrame>, FunctionCall>;
 
     std::unique_ptr<Orchestrator> createOrchestrator(mlir::FunctionOpInterface function,
                                                      mlir::AnalysisManager moduleManager)
@@ -1260,196 +1806,363 @@ class Scheduler
         }
     }
 
-public:
-    /// Run the typeflow analysis starting from the given root functions. These may not take any DynamicType function
-    /// arguments.
-    void run(llvm::ArrayRef<mlir::FunctionOpInterface> roots, mlir::AnalysisManager moduleManager)
+    /// Returns the results of 'specialization' if it is not being analysed and they are in the cache.
+    const SpecializationResult* lookupCache(const FunctionSpecialization& specialization)
     {
-        Queue queue;
-
-        for (auto iter : roots)
+        if (!m_cache || m_orchestrators.count(specialization))
         {
-            auto spec = FunctionSpecialization(iter, {});
-            auto function = spec.function;
-            auto& orchestrator =
-                m_orchestrators.insert({spec, createOrchestrator(function, moduleManager)}).first->second;
-            queue.emplace(ExecutionFrame(&orchestrator->getEntryBlock()->front()), orchestrator.get());
+            return nullptr;
         }
+        if (auto result = m_cachedResults.find(specialization); result != m_cachedResults.end())
+        {
+            return &result->second;
+        }
+        if (!m_cache->lookup(specialization, m_cachedResults))
+        {
+            return nullptr;
+        }
+        return &m_cachedResults.find(specialization)->second;
+    }
 
-        mlir::SymbolTableCollection collection;
+    /// Returns 'orch' and all orchestrators it is in a recursion with.
+    static llvm::SmallVector<Orchestrator*> collectRecursionSeeds(Orchestrator* orch)
+    {
+        llvm::SmallVector<Orchestrator*> seeds{orch};
+        for (const auto& info : orch->getRecursionInfos())
+        {
+            llvm::append_range(seeds, llvm::make_first_range(info->containedOrchsToCycleCalls));
+        }
+        return seeds;
+    }
+
+    /// Takes all frames out of 'queue' that can be executed concurrently. Frames of the same orchestrator or of
+    /// related orchestrators are never taken together. Related are all transitive callers and callees of an
+    /// orchestrator and of the ones it is in a recursion with. Processing the result of one might otherwise change the
+    /// state of the other orchestrator while it is executing. Only the first of such frames is taken, all others
+    /// remain in the queue in their original order. This makes the schedule independent of the amount of threads used.
+    static std::vector<QueueItem> takeIndependent(Queue& queue)
+    {
+        std::vector<QueueItem> batch;
+        Queue deferred;
+        llvm::SmallPtrSet<Orchestrator*, 8> seen;
+        // Transitive callees and callers of the orchestrators taken so far. As the relation is symmetric, a frame
+        // conflicts with the ones taken if its orchestrator or any it is in a recursion with is contained in either.
+        // The sets are shared by the traversals of all taken orchestrators, visiting every orchestrator at most once
+        // per direction and round.
+        llvm::df_iterator_default_set<Orchestrator*> callees;
+        llvm::df_iterator_default_set<Orchestrator*> callers;
         while (!queue.empty())
         {
             auto front = std::move(queue.front());
             queue.pop();
-            auto result = front.second->execute(front.first, collection);
-            if (auto* vec = std::get_if<std::vector<ExecutionFrame>>(&result))
+            auto* orch = front.second.get();
+            // If the orchestrator was seen before, it was either taken already or related to one that was.
+            if (!seen.insert(orch).second)
+            {
+                deferred.push(std::move(front));
+                continue;
+            }
+
+            auto seeds = collectRecursionSeeds(orch);
+            if (llvm::any_of(seeds, [&](Orchestrator* iter) { return callees.count(iter) || callers.count(iter); }))
             {
-                if (!vec->empty())
+                deferred.push(std::move(front));
+                continue;
+            }
+            for (auto* seed : seeds)
+            {
+                // Iterating marks the orchestrators as visited.
+                for (auto* iter : llvm::depth_first_ext(seed, callees))
                 {
-                    // Successor blocks and this execution round was definitely not the last one from the orchestrator.
-                    for (auto& iter : *vec)
-                    {
-                        queue.emplace(std::move(iter), front.second);
-                    }
-                    continue;
+                    (void)iter;
                 }
+                for (auto* iter : llvm::inverse_depth_first_ext(seed, callers))
+                {
+                    (void)iter;
+                }
+            }
+            batch.push_back(std::move(front));
+        }
+        queue = std::move(deferred);
+        return batch;
+    }
 
-                // Orchestrator returned without a successor and might have finished function execution of the whole
-                // function.
-                auto* orch = front.second.get();
-                if (front.second.release() != 0)
+    /// Schedules new frames based on the result of executing the frame in 'front'.
+    void handleResult(QueueItem front, OrchestratorResult result, Queue& queue, mlir::SymbolTableCollection& collection,
+                      mlir::AnalysisManager moduleManager)
+    {
+        if (auto* vec = std::get_if<std::vector<ExecutionFrame>>(&result))
+        {
+            if (!vec->empty())
+            {
+                // Successor blocks and this execution round was definitely not the last one from the orchestrator.
+                for (auto& iter : *vec)
                 {
-                    continue;
+                    queue.emplace(std::move(iter), front.second);
                 }
+                return;
+            }
+
+            // Orchestrator returned without a successor and might have finished function execution of the whole
+            // function.
+            auto* orch = front.second.get();
+            if (front.second.release() != 0)
+            {
+                return;
+            }
 
-                if (orch->inCalls())
+            if (orch->inCalls())
+            {
+                // May not be queued up anymore but there are still calls we are waiting for.
+                if (orch->inRecursions())
                 {
-                    // May not be queued up anymore but there are still calls we are waiting for.
-                    if (orch->inRecursions())
-                    {
-                        checkLastInRecursion(orch, queue);
-                    }
-                    continue;
+                    checkLastInRecursion(orch, queue);
                 }
+                return;
+            }
 
-                // Truly finished case.
-                // If not part of a recursion just schedule all waiting calls.
-                if (!orch->inRecursions())
+            // Truly finished case.
+            // If not part of a recursion just schedule all waiting calls.
+            if (!orch->inRecursions())
+            {
+                for (auto& iter : std::move(*orch).getWaitingCallers())
                 {
-                    for (auto& iter : std::move(*orch).getWaitingCallers())
+                    for (auto [dest, value] : llvm::zip(iter.resultValues, orch->getReturnTypes()))
                     {
-                        for (auto [dest, value] : llvm::zip(iter.resultValues, orch->getReturnTypes()))
-                        {
-                            iter.frame.getValues()[dest] = value;
-                        }
-                        queue.emplace(std::move(iter.frame), iter.orchestrator);
+                        iter.frame.getValues()[dest] = value;
                     }
-                    orch->retire();
-                    continue;
+                    queue.emplace(std::move(iter.frame), iter.orchestrator);
                 }
+                orch->retire();
+                return;
+            }
 
-                // Otherwise we schedule all the other calls part of the recursive cycle until we processed the whole
-                // cycle.
-                const auto& info = orch->getRecursionInfos().back();
-                if (info->broken != orch)
-                {
-                    scheduleWaitingCallsInRecursion(queue, info.get(), orch);
-                    continue;
-                }
+            // Otherwise we schedule all the other calls part of the recursive cycle until we processed the whole
+            // cycle.
+            const auto& info = orch->getRecursionInfos().back();
+            if (info->broken != orch)
+            {
+                scheduleWaitingCallsInRecursion(queue, info.get(), orch);
+                return;
+            }
 
-                // The return type has not changed and the recursion was properly resolved. Time to retire the whole
-                // recursion.
-                if (!info->seen.insert({orch->getReturnTypes().begin(), orch->getReturnTypes().end()}).second)
+            // The return type has not changed and the recursion was properly resolved. Time to retire the whole
+            // recursion.
+            if (!info->seen.insert({orch->getReturnTypes().begin(), orch->getReturnTypes().end()}).second)
+            {
+                std::shared_ptr<RecursionInfo> infoKeepAlive = info;
+                for (auto* retiringOrch : llvm::make_first_range(infoKeepAlive->containedOrchsToCycleCalls))
                 {
-                    std::shared_ptr<RecursionInfo> infoKeepAlive = info;
-                    for (auto* retiringOrch : llvm::make_first_range(infoKeepAlive->containedOrchsToCycleCalls))
+                    if (retiringOrch->getRecursionInfos().back() != infoKeepAlive)
                     {
-                        if (retiringOrch->getRecursionInfos().back() != infoKeepAlive)
-                        {
-                            continue;
-                        }
+                        continue;
+                    }
 
-                        for (auto& iter : std::move(*retiringOrch).getWaitingCallers())
+                    for (auto& iter : std::move(*retiringOrch).getWaitingCallers())
+                    {
+                        for (auto [dest, value] : llvm::zip(iter.resultValues, retiringOrch->getReturnTypes()))
                         {
-                            for (auto [dest, value] : llvm::zip(iter.resultValues, retiringOrch->getReturnTypes()))
-                            {
-                                iter.frame.getValues()[dest] = value;
-                            }
-                            queue.emplace(std::move(iter.frame), iter.orchestrator);
+                            iter.frame.getValues()[dest] = value;
                         }
-                        retiringOrch->retire();
+                        queue.emplace(std::move(iter.frame), iter.orchestrator);
                     }
-                    continue;
+                    retiringOrch->retire();
                 }
+                return;
+            }
 
-                for (auto& [cycleOrch, calls] : info->containedOrchsToCycleCalls)
+            for (auto& [cycleOrch, calls] : info->containedOrchsToCycleCalls)
+            {
+                for (auto& call : calls)
                 {
-                    for (auto& call : calls)
-                    {
-                        cycleOrch->addWaitingCall(call.callWaiting);
-                        call.callWaiting.orchestrator->installLoopState(
-                            call.callWaiting.frame.getNextExecutedOp().getBlock(), call.loopState);
-                    }
+                    cycleOrch->addWaitingCall(call.callWaiting);
+                    call.callWaiting.orchestrator->installLoopState(
+                        call.callWaiting.frame.getNextExecutedOp().getBlock(), call.loopState);
                 }
-                scheduleWaitingCallsInRecursion(queue, info.get(), info->broken);
-                continue;
             }
-            auto& call = pylir::get<FunctionCall>(result);
-            auto [existing, inserted] = m_orchestrators.insert({std::move(call.functionSpecialization), nullptr});
-            if (inserted)
+            scheduleWaitingCallsInRecursion(queue, info.get(), info->broken);
+            return;
+        }
+        auto& call = pylir::get<FunctionCall>(result);
+        if (const auto* cached = lookupCache(call.functionSpecialization))
+        {
+            for (auto [dest, value] : llvm::zip(call.resultValues, cached->returnTypes))
             {
-                existing->second = createOrchestrator(existing->first.function, moduleManager);
+                front.first.getValues()[dest] = value;
             }
-            else if (existing->second->finishedExecution() || existing->second->hasPreliminaryReturnTypes())
+            queue.emplace(std::move(front));
+            return;
+        }
+
+        auto [existing, inserted] = m_orchestrators.insert({std::move(call.functionSpecialization), nullptr});
+        if (inserted)
+        {
+            existing->second = createOrchestrator(existing->first.function, moduleManager);
+        }
+        else if (existing->second->finishedExecution() || existing->second->hasPreliminaryReturnTypes())
+        {
+            // This orchestrator has already finished execution and there is no need to wait.
+            for (auto [dest, value] : llvm::zip(call.resultValues, existing->second->getReturnTypes()))
             {
-                // This orchestrator has already finished execution and there is no need to wait.
-                for (auto [dest, value] : llvm::zip(call.resultValues, existing->second->getReturnTypes()))
-                {
-                    front.first.getValues()[dest] = value;
-                }
-                queue.emplace(std::move(front));
-                continue;
+                front.first.getValues()[dest] = value;
             }
+            queue.emplace(std::move(front));
+            return;
+        }
 
-            auto* orch = front.second.get();
-            if (!call.resultValues.empty())
+        auto* orch = front.second.get();
+        if (!call.resultValues.empty())
+        {
+            existing->second->addWaitingCall(std::move(front.first), orch, call.resultValues);
+            if (orch != existing->second.get())
             {
-                existing->second->addWaitingCall(std::move(front.first), orch, call.resultValues);
-                if (orch != existing->second.get())
-                {
-                    if (auto cycle = addEdge(orch, existing->second.get()); !cycle.empty())
-                    {
-                        handleRecursion(cycle, queue, collection);
-                    }
-                }
-                else
+                if (auto cycle = addEdge(orch, existing->second.get()); !cycle.empty())
                 {
-                    handleRecursion(llvm::SmallPtrSet<Orchestrator*, 1>{orch}, queue, collection);
+                    handleRecursion(cycle, queue, collection);
                 }
             }
             else
             {
-                // No need to wait for the call if it has no results for us.
-                queue.emplace(std::move(front.first), front.second);
+                handleRecursion(llvm::SmallPtrSet<Orchestrator*, 1>{orch}, queue, collection);
             }
+        }
+        else
+        {
+            // No need to wait for the call if it has no results for us.
+            queue.emplace(std::move(front.first), front.second);
+        }
 
-            // This is not the first call to that function, it has not yet finished execution, and we have already
-            // registered ourselves as dependent. There is nothing more to do but wait for its completion.
-            if (!inserted)
+        // This is not the first call to that function, it has not yet finished execution, and we have already
+        // registered ourselves as dependent. There is nothing more to do but wait for its completion.
+        if (!inserted)
+        {
+            // If this isn't the last queue item, or we are not part of a recursion there is nothing to do but wait
+            // for the calls to finish.
+            if (front.second.release() != 0 || !orch->inRecursions())
             {
-                // If this isn't the last queue item, or we are not part of a recursion there is nothing to do but wait
-                // for the calls to finish.
-                if (front.second.release() != 0 || !orch->inRecursions())
-                {
-                    continue;
-                }
+                return;
+            }
+
+            checkLastInRecursion(orch, queue);
+            return;
+        }
+
+        // First call, set up the function arguments.
+        llvm::DenseMap<mlir::Value, pylir::Py::TypeAttrUnion> entryValues;
+        for (auto [arg, value] :
+             llvm::zip(existing->second->getEntryBlock()->getArguments(), existing->first.argTypes))
+        {
+            if (auto ref = value.dyn_cast<mlir::SymbolRefAttr>())
+            {
+                entryValues[arg] = ref;
+            }
+            else if (auto type = value.dyn_cast<pylir::Py::ObjectTypeInterface>())
+            {
+                entryValues[arg] = type;
+            }
+        }
+        queue.emplace(ExecutionFrame(&existing->second->getEntryBlock()->front(), std::move(entryValues)),
+                      existing->second.get());
+    }
+
+public:
+    /// Creates a scheduler that takes the results of specializations from 'cache' if possible. 'cache' may be null.
+    explicit Scheduler(MonomorphCache* cache) : m_cache(cache) {}
+
+    /// Run the typeflow analysis starting from the given root functions. These may not take any DynamicType function
+    /// arguments.
+    ///
+    /// Frames of independent orchestrators are executed concurrently. Their results are processed sequentially in queue
+    /// order afterwards, making the results deterministic.
+    void run(llvm::ArrayRef<mlir::FunctionOpInterface> roots, mlir::AnalysisManager moduleManager)
+    {
+        if (roots.empty())
+        {
+            return;
+        }
 
-                checkLastInRecursion(orch, queue);
+        Queue queue;
+        for (auto iter : roots)
+        {
+            auto spec = FunctionSpecialization(iter, {});
+            if (lookupCache(spec))
+            {
                 continue;
             }
+            auto function = spec.function;
+            auto& orchestrator =
+                m_orchestrators.insert({spec, createOrchestrator(function, moduleManager)}).first->second;
+            queue.emplace(ExecutionFrame(&orchestrator->getEntryBlock()->front()), orchestrator.get());
+        }
+
+        auto* context = roots.front()->getContext();
+        auto& collection = m_collections.get();
+        while (!queue.empty())
+        {
+            auto batch = takeIndependent(queue);
+            std::vector<OrchestratorResult> results(batch.size());
+            mlir::parallelForEach(context, llvm::seq<std::size_t>(0, batch.size()),
+                                  [&](std::size_t index)
+                                  {
+                                      auto& [frame, count] = batch[index];
+                                      results[index] = count->execute(frame, m_collections.get());
+                                  });
+            for (auto [item, result] : llvm::zip(batch, results))
+            {
+                handleResult(std::move(item), std::move(result), queue, collection, moduleManager);
+            }
+        }
+    }
 
-            // First call, set up the function arguments.
-            llvm::DenseMap<mlir::Value, pylir::Py::TypeAttrUnion> entryValues;
-            for (auto [arg, value] :
-                 llvm::zip(existing->second->getEntryBlock()->getArguments(), existing->first.argTypes))
+    /// Returns the results of all specializations that were either analysed or taken from the cache.
+    llvm::MapVector<FunctionSpecialization, SpecializationResult> takeResults()
+    {
+        llvm::MapVector<FunctionSpecialization, SpecializationResult> results = std::move(m_cachedResults);
+        for (auto& [specialization, orchestrator] : m_orchestrators)
+        {
+            // Specializations may have been both analysed and taken from the cache as callee of a cached
+            // specialization. Both results are identical.
+            auto [iter, inserted] = results.insert({specialization, SpecializationResult{}});
+            if (!inserted)
             {
-                if (auto ref = value.dyn_cast<mlir::SymbolRefAttr>())
+                continue;
+            }
+            SpecializationResult& result = iter->second;
+            result.returnTypes.assign(orchestrator->getReturnTypes().begin(), orchestrator->getReturnTypes().end());
+            result.callSites = orchestrator->getCallSites();
+            for (const auto& [key, value] : orchestrator->getValues())
+            {
+                auto attr = value.dyn_cast_or_null<mlir::Attribute>();
+                if (!attr)
                 {
-                    entryValues[arg] = ref;
+                    continue;
                 }
-                else if (auto type = value.dyn_cast<pylir::Py::ObjectTypeInterface>())
+
+                mlir::Value instrValue;
+                if (auto blockArg = key.dyn_cast<mlir::BlockArgument>())
                 {
-                    entryValues[arg] = type;
+                    if (!blockArg.getOwner()->isEntryBlock())
+                    {
+                        continue;
+                    }
+                    auto dynamicArgIndex = blockArg.getArgNumber();
+                    auto filter = llvm::make_filter_range(specialization.function.getArguments(), [](mlir::Value val)
+                                                          { return val.getType().isa<pylir::Py::DynamicType>(); });
+                    instrValue = *std::next(filter.begin(), dynamicArgIndex);
+                }
+                else
+                {
+                    auto mapping = key.getDefiningOp<pylir::TypeFlow::TypeFlowValueMappingInterface>();
+                    if (!mapping)
+                    {
+                        continue;
+                    }
+                    instrValue = mapping.mapValue(key);
                 }
+                result.values.emplace_back(instrValue, attr);
             }
-            queue.emplace(ExecutionFrame(&existing->second->getEntryBlock()->front(), std::move(entryValues)),
-                          existing->second.get());
         }
-    }
-
-    llvm::MapVector<FunctionSpecialization, std::unique_ptr<Orchestrator>>& getResults()
-    {
-        return m_orchestrators;
+        return results;
     }
 };
 
@@ -1512,11 +2225,29 @@ void Monomorph::runOnOperation()
         }
     }
 
-    llvm::MapVector<FunctionSpecialization, std::unique_ptr<Orchestrator>> results;
+    mlir::SymbolTable table(getOperation());
+    std::optional<MonomorphCache> cache;
+    if (!m_cacheFile.empty())
+    {
+        cache.emplace(getOperation(), table, m_cacheFile);
+    }
+
+    llvm::MapVector<FunctionSpecialization, SpecializationResult> results;
     {
-        Scheduler scheduler;
+        Scheduler scheduler(cache ? &*cache : nullptr);
         scheduler.run(roots.getArrayRef(), getAnalysisManager());
-        results = std::move(scheduler.getResults());
+        results = scheduler.takeResults();
+    }
+
+    // The keys of the cache are computed from the IR and must therefore be computed before any changes are made.
+    if (cache)
+    {
+        for (auto& [func, result] : results)
+        {
+            cache->insert(func, result);
+        }
+        cache->save();
+        m_cacheHits = cache->getHits();
     }
 
     struct Clone
@@ -1526,43 +2257,14 @@ void Monomorph::runOnOperation()
     };
 
     bool changed = false;
-    mlir::SymbolTable table(getOperation());
     llvm::DenseMap<FunctionSpecialization, Clone> clones;
-    for (auto& [func, orchestrator] : results)
+    for (auto& [func, result] : results)
     {
         auto& clone = clones[func];
         clone.function = func.function;
         bool isRoot = roots.contains(func.function);
-        for (const auto& [key, value] : orchestrator->getValues())
+        for (auto [instrValue, attr] : result.values)
         {
-            auto attr = value.dyn_cast_or_null<mlir::Attribute>();
-            if (!attr)
-            {
-                continue;
-            }
-
-            mlir::Value instrValue;
-            if (auto blockArg = key.dyn_cast<mlir::BlockArgument>())
-            {
-                if (!blockArg.getOwner()->isEntryBlock())
-                {
-                    continue;
-                }
-                auto dynamicArgIndex = blockArg.getArgNumber();
-                auto filter = llvm::make_filter_range(func.function.getArguments(), [](mlir::Value val)
-                                                      { return val.getType().isa<pylir::Py::DynamicType>(); });
-                instrValue = *std::next(filter.begin(), dynamicArgIndex);
-            }
-            else
-            {
-                auto mapping = key.getDefiningOp<pylir::TypeFlow::TypeFlowValueMappingInterface>();
-                if (!mapping)
-                {
-                    continue;
-                }
-                instrValue = mapping.mapValue(key);
-            }
-
             // Cloning of a function body is done lazily for the case where no value has changed.
             // Roots are not cloned but updated in place.
             if (clone.function == func.function && !isRoot)
@@ -1609,11 +2311,11 @@ void Monomorph::runOnOperation()
     do
     {
         cloneOccurred = false;
-        for (auto& [thisFunc, orchestrator] : results)
+        for (auto& [thisFunc, result] : results)
         {
             bool isRoot = roots.contains(thisFunc.function);
             auto& thisClone = clones[thisFunc];
-            for (const auto& [origCall, func] : orchestrator->getCallSites())
+            for (const auto& [origCall, func] : result.callSites)
             {
                 auto calcCall = [&, &origCall = origCall, &thisFunc = thisFunc]
                 {
@@ -1678,3 +2380,8 @@ std::unique_ptr<mlir::Pass> pylir::Py::createMonomorphPass()
 {
     return std::make_unique<Monomorph>();
 }
+
+std::unique_ptr<mlir::Pass> pylir::Py::createMonomorphPass(llvm::StringRef cacheFile)
+{
+    return std::make_unique<Monomorph>(cacheFile);
+}
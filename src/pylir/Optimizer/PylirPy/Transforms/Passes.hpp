@@ -19,16 +19,34 @@ std::unique_ptr<mlir::Pass> createFoldHandlesPass();
 
 std::unique_ptr<mlir::Pass> createHandleLoadStoreEliminationPass();
 
+std::unique_ptr<mlir::Pass> createSnapshotModuleInitPass();
+
 std::unique_ptr<mlir::Pass> createMonomorphPass();
 
+std::unique_ptr<mlir::Pass> createMonomorphPass(llvm::StringRef cacheFile);
+
 std::unique_ptr<mlir::Pass> createTypeFlowMonomorphPass();
 
 std::unique_ptr<mlir::Pass> createInlinerPass();
 
 std::unique_ptr<mlir::Pass> createTrialInlinerPass();
 
+std::unique_ptr<mlir::Pass> createTrialInlinerPass(llvm::StringRef cacheFile);
+
 std::unique_ptr<mlir::Pass> createSROAPass();
 
+std::unique_ptr<mlir::Pass> createUnboxingPass();
+
+std::unique_ptr<mlir::Pass> createLoopInvariantCodeMotionPass();
+
+std::unique_ptr<mlir::Pass> createRangeCheckEliminationPass();
+
+std::unique_ptr<mlir::Pass> createProfileInstrumentationPass();
+
+std::unique_ptr<mlir::Pass> createProfileUsePass();
+
+std::unique_ptr<mlir::Pass> createProfileUsePass(llvm::StringRef profileFile);
+
 #define GEN_PASS_REGISTRATION
 #include "pylir/Optimizer/PylirPy/Transforms/Passes.h.inc"
 
@@ -0,0 +1,36 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+
+#include "PassDetail.hpp"
+#include "Passes.hpp"
+#include "Util/ProfileUtil.hpp"
+
+namespace
+{
+class ProfileInstrumentation : public ProfileInstrumentationBase<ProfileInstrumentation>
+{
+protected:
+    void runOnOperation() override
+    {
+        for (auto& [op, site] : pylir::Py::collectProfiledCallSites(getOperation()))
+        {
+            auto function = mlir::cast<mlir::CallOpInterface>(op).getCallableForCallee().get<mlir::Value>();
+            mlir::OpBuilder builder(op);
+            auto siteName = builder.create<pylir::Py::ConstantOp>(op->getLoc(),
+                                                                  pylir::Py::StrAttr::get(&getContext(), site));
+            builder.create<pylir::Py::ProfileCallOp>(op->getLoc(), function, siteName);
+            m_callSitesInstrumented++;
+        }
+    }
+};
+} // namespace
+
+std::unique_ptr<mlir::Pass> pylir::Py::createProfileInstrumentationPass()
+{
+    return std::make_unique<ProfileInstrumentation>();
+}
@@ -0,0 +1,233 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/Dialect/ControlFlow/IR/ControlFlowOps.h>
+#include <mlir/IR/Matchers.h>
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+
+#include <limits>
+
+#include "PassDetail.hpp"
+#include "Passes.hpp"
+#include "Util/ProfileUtil.hpp"
+
+namespace
+{
+class ProfileUse : public ProfileUseBase<ProfileUse>
+{
+    /// Call counts of every function called at a call site, keyed by the call site and the qualified name of the
+    /// function.
+    llvm::StringMap<llvm::StringMap<std::uint64_t>> m_profile;
+
+    mlir::LogicalResult readProfile();
+
+    void speculate(mlir::Operation* call, pylir::Py::GlobalValueOp global, mlir::FlatSymbolRefAttr impl,
+                   std::uint64_t hotCount, std::uint64_t coldCount);
+
+protected:
+    void runOnOperation() override;
+
+public:
+    ProfileUse() = default;
+
+    explicit ProfileUse(llvm::StringRef profileFile)
+    {
+        m_profileFile = profileFile.str();
+    }
+};
+
+mlir::LogicalResult ProfileUse::readProfile()
+{
+    m_profile.clear();
+    auto buffer = llvm::MemoryBuffer::getFile(m_profileFile);
+    if (!buffer)
+    {
+        getOperation()->emitError("Failed to open profile '")
+            << m_profileFile << "': " << buffer.getError().message();
+        return mlir::failure();
+    }
+    // Every line of the profile consists of the call site, the qualified name of the function called and the amount
+    // of times it was called, separated by tabs.
+    llvm::SmallVector<llvm::StringRef> lines;
+    (*buffer)->getBuffer().split(lines, '\n', -1, false);
+    for (auto line : lines)
+    {
+        auto [site, rest] = line.rtrim('\r').split('\t');
+        auto [qualifiedName, countString] = rest.split('\t');
+        std::uint64_t count;
+        if (countString.getAsInteger(10, count))
+        {
+            getOperation()->emitError("Malformed line in profile '") << m_profileFile << "': " << line;
+            return mlir::failure();
+        }
+        m_profile[site][qualifiedName] += count;
+    }
+    return mlir::success();
+}
+
+void ProfileUse::speculate(mlir::Operation* call, pylir::Py::GlobalValueOp global, mlir::FlatSymbolRefAttr impl,
+                           std::uint64_t hotCount, std::uint64_t coldCount)
+{
+    auto loc = call->getLoc();
+    auto callee = mlir::cast<mlir::CallOpInterface>(call).getCallableForCallee().get<mlir::Value>();
+    auto* block = call->getBlock();
+    auto* continueBlock = block->splitBlock(call);
+    auto* fastPath = new mlir::Block;
+    auto* slowPath = new mlir::Block;
+    fastPath->insertBefore(continueBlock);
+    slowPath->insertBefore(continueBlock);
+
+    // LLVM only accepts 32 bit branch weights. Scale both counts down while keeping their ratio.
+    constexpr auto maxWeight = static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max());
+    auto hotWeight = hotCount;
+    auto coldWeight = coldCount;
+    while (hotWeight > maxWeight || coldWeight > maxWeight)
+    {
+        hotWeight /= 2;
+        coldWeight /= 2;
+    }
+
+    mlir::OpBuilder builder = mlir::OpBuilder::atBlockEnd(block);
+    mlir::Value function = builder.create<pylir::Py::ConstantOp>(loc, mlir::FlatSymbolRefAttr::get(global));
+    auto isHot = builder.create<pylir::Py::IsOp>(loc, callee, function);
+    auto branch = builder.create<mlir::cf::CondBranchOp>(loc, isHot, fastPath, slowPath);
+    branch->setAttr(pylir::Py::branchWeightsAttr, builder.getI32VectorAttr({static_cast<std::int32_t>(hotWeight),
+                                                                             static_cast<std::int32_t>(coldWeight)}));
+
+    auto result = continueBlock->addArgument(builder.getType<pylir::Py::DynamicType>(), loc);
+    call->getResult(0).replaceAllUsesWith(result);
+    call->moveBefore(slowPath, slowPath->end());
+
+    auto operands = llvm::to_vector(llvm::map_range(mlir::cast<mlir::CallOpInterface>(call).getArgOperands(),
+                                                    [&](mlir::Value value)
+                                                    { return value == callee ? function : value; }));
+    builder.setInsertionPointToStart(fastPath);
+    mlir::Operation* directCall;
+    auto invoke = mlir::dyn_cast<pylir::Py::FunctionInvokeOp>(call);
+    if (!invoke)
+    {
+        directCall =
+            builder.create<pylir::Py::CallOp>(loc, builder.getType<pylir::Py::DynamicType>(), impl, operands);
+        builder.create<mlir::cf::BranchOp>(loc, continueBlock, directCall->getResult(0));
+        builder.setInsertionPointToEnd(slowPath);
+        builder.create<mlir::cf::BranchOp>(loc, continueBlock, call->getResult(0));
+    }
+    else
+    {
+        // The results of an invoke are only available in its happy path. Both invokes therefore get their own happy
+        // path, passing the result to the continue block, which then branches to the original happy path.
+        auto* fastContinue = new mlir::Block;
+        auto* slowContinue = new mlir::Block;
+        fastContinue->insertBefore(continueBlock);
+        slowContinue->insertBefore(continueBlock);
+        directCall = builder.create<pylir::Py::InvokeOp>(
+            loc, builder.getType<pylir::Py::DynamicType>(), impl, operands, mlir::ValueRange{},
+            invoke.getUnwindDestOperands(), fastContinue, invoke.getExceptionPath());
+
+        builder.setInsertionPointToStart(fastContinue);
+        builder.create<mlir::cf::BranchOp>(loc, continueBlock, directCall->getResult(0));
+        builder.setInsertionPointToStart(slowContinue);
+        builder.create<mlir::cf::BranchOp>(loc, continueBlock, invoke.getResult());
+        builder.setInsertionPointToStart(continueBlock);
+        builder.create<mlir::cf::BranchOp>(loc, invoke.getHappyPath(), invoke.getNormalDestOperands());
+
+        invoke.getNormalDestOperandsMutable().clear();
+        invoke->setSuccessor(slowContinue, 0);
+    }
+    directCall->setAttr(pylir::Py::alwaysBoundAttr, builder.getUnitAttr());
+    directCall->setAttr(pylir::Py::profileCountAttr, builder.getI64IntegerAttr(hotCount));
+}
+
+void ProfileUse::runOnOperation()
+{
+    if (mlir::failed(readProfile()))
+    {
+        signalPassFailure();
+        return;
+    }
+
+    // Functions that are speculated on need to be global values so that they can be referenced in the guard. Qualified
+    // names that are not unique are mapped to a null op, as it is unknown which of the functions was called.
+    llvm::StringMap<pylir::Py::GlobalValueOp> functions;
+    for (auto global : getOperation().getOps<pylir::Py::GlobalValueOp>())
+    {
+        if (global.isDeclaration())
+        {
+            continue;
+        }
+        auto functionAttr = global.getInitializerAttr().dyn_cast<pylir::Py::FunctionAttr>();
+        if (!functionAttr)
+        {
+            continue;
+        }
+        auto qualName = functionAttr.getQualName().dyn_cast<pylir::Py::StrAttr>();
+        if (!qualName)
+        {
+            continue;
+        }
+        auto [iter, inserted] = functions.insert({qualName.getValue(), global});
+        if (!inserted)
+        {
+            iter->second = nullptr;
+        }
+    }
+
+    for (auto& [call, site] : pylir::Py::collectProfiledCallSites(getOperation()))
+    {
+        auto targets = m_profile.find(site);
+        if (targets == m_profile.end())
+        {
+            continue;
+        }
+        std::uint64_t total = 0;
+        const llvm::StringMapEntry<std::uint64_t>* hottest = nullptr;
+        for (auto& entry : targets->second)
+        {
+            total += entry.second;
+            if (!hottest || entry.second > hottest->second)
+            {
+                hottest = &entry;
+            }
+        }
+        if (total < m_minCallCount || hottest->second * 100 < total * m_minTargetPercentage)
+        {
+            continue;
+        }
+        auto global = functions.lookup(hottest->first());
+        if (!global)
+        {
+            continue;
+        }
+        auto callee = mlir::cast<mlir::CallOpInterface>(call).getCallableForCallee().get<mlir::Value>();
+        if (mlir::matchPattern(callee, mlir::m_Constant()))
+        {
+            continue;
+        }
+        if (auto invoke = mlir::dyn_cast<pylir::Py::FunctionInvokeOp>(call);
+            invoke && !invoke.getHappyPath()->getSinglePredecessor())
+        {
+            continue;
+        }
+        speculate(call, global, global.getInitializerAttr().cast<pylir::Py::FunctionAttr>().getValue(),
+                  hottest->second, total - hottest->second);
+        m_callSitesSpeculated++;
+    }
+}
+} // namespace
+
+std::unique_ptr<mlir::Pass> pylir::Py::createProfileUsePass()
+{
+    return std::make_unique<ProfileUse>();
+}
+
+std::unique_ptr<mlir::Pass> pylir::Py::createProfileUsePass(llvm::StringRef profileFile)
+{
+    return std::make_unique<ProfileUse>(profileFile);
+}
@@ -0,0 +1,657 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/Dialect/Arithmetic/IR/Arithmetic.h>
+#include <mlir/Dialect/ControlFlow/IR/ControlFlowOps.h>
+#include <mlir/IR/Dominance.h>
+#include <mlir/IR/RegionGraphTraits.h>
+#include <mlir/Interfaces/ControlFlowInterfaces.h>
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/PostOrderIterator.h>
+#include <llvm/ADT/TypeSwitch.h>
+
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+
+#include <limits>
+#include <optional>
+
+#include "PassDetail.hpp"
+
+namespace
+{
+/// Possible outcomes of comparing two integers. Used as bits in a mask.
+enum Outcome : std::uint8_t
+{
+    Less = 0b001,
+    Equal = 0b010,
+    Greater = 0b100,
+    Any = Less | Equal | Greater,
+};
+
+/// Swaps the 'Less' and 'Greater' bits of 'mask', turning it into the mask of the comparison with swapped operands.
+std::uint8_t swapOutcomes(std::uint8_t mask)
+{
+    return (mask & Equal) | ((mask & Less) ? Greater : 0) | ((mask & Greater) ? Less : 0);
+}
+
+/// Comparison of two integers, independent of the op it originates from. 'mask' contains all outcomes for which the
+/// comparison is true.
+struct Comparison
+{
+    enum Kind
+    {
+        Unsigned,
+        Signed,
+        PyInt,
+    } kind;
+    std::uint8_t mask;
+    mlir::Value lhs;
+    mlir::Value rhs;
+};
+
+/// Returns the comparison computing 'condition' or an empty optional if it is not computed by a comparison.
+std::optional<Comparison> getComparison(mlir::Value condition)
+{
+    auto* op = condition.getDefiningOp();
+    if (auto cmpOp = mlir::dyn_cast_or_null<mlir::arith::CmpIOp>(op))
+    {
+        std::uint8_t mask;
+        auto kind = Comparison::Unsigned;
+        switch (cmpOp.getPredicate())
+        {
+            case mlir::arith::CmpIPredicate::eq: mask = Equal; break;
+            case mlir::arith::CmpIPredicate::ne: mask = Less | Greater; break;
+            case mlir::arith::CmpIPredicate::slt: kind = Comparison::Signed; [[fallthrough]];
+            case mlir::arith::CmpIPredicate::ult: mask = Less; break;
+            case mlir::arith::CmpIPredicate::sle: kind = Comparison::Signed; [[fallthrough]];
+            case mlir::arith::CmpIPredicate::ule: mask = Less | Equal; break;
+            case mlir::arith::CmpIPredicate::sgt: kind = Comparison::Signed; [[fallthrough]];
+            case mlir::arith::CmpIPredicate::ugt: mask = Greater; break;
+            case mlir::arith::CmpIPredicate::sge: kind = Comparison::Signed; [[fallthrough]];
+            case mlir::arith::CmpIPredicate::uge: mask = Greater | Equal; break;
+        }
+        return Comparison{kind, mask, cmpOp.getLhs(), cmpOp.getRhs()};
+    }
+    if (auto cmpOp = mlir::dyn_cast_or_null<pylir::Py::IntCmpOp>(op))
+    {
+        std::uint8_t mask;
+        switch (cmpOp.getPred())
+        {
+            case pylir::Py::IntCmpKind::eq: mask = Equal; break;
+            case pylir::Py::IntCmpKind::ne: mask = Less | Greater; break;
+            case pylir::Py::IntCmpKind::lt: mask = Less; break;
+            case pylir::Py::IntCmpKind::le: mask = Less | Equal; break;
+            case pylir::Py::IntCmpKind::gt: mask = Greater; break;
+            case pylir::Py::IntCmpKind::ge: mask = Greater | Equal; break;
+        }
+        return Comparison{Comparison::PyInt, mask, cmpOp.getLhs(), cmpOp.getRhs()};
+    }
+    return std::nullopt;
+}
+
+/// Inclusive range of values an integer may take, interpreted as unsigned. A range whose minimum is larger than its
+/// maximum is empty and denotes a value that has not yet been reached during the analysis.
+/// A maximum of 'unbounded' is treated as infinity, as python integers are of arbitrary precision and integers may
+/// take any value of their width.
+struct Range
+{
+    constexpr static auto unbounded = std::numeric_limits<std::uint64_t>::max();
+
+    std::uint64_t min;
+    std::uint64_t max;
+
+    static Range empty()
+    {
+        return {1, 0};
+    }
+
+    [[nodiscard]] bool isEmpty() const
+    {
+        return min > max;
+    }
+
+    bool operator==(const Range& rhs) const
+    {
+        return min == rhs.min && max == rhs.max;
+    }
+
+    bool operator!=(const Range& rhs) const
+    {
+        return !(rhs == *this);
+    }
+};
+
+/// Range of a value. An empty optional denotes a python integer that may be negative or is not known to be an integer
+/// at all.
+using Lattice = std::optional<Range>;
+
+Lattice join(Lattice lhs, Lattice rhs)
+{
+    if (!lhs || !rhs)
+    {
+        return std::nullopt;
+    }
+    if (lhs->isEmpty())
+    {
+        return rhs;
+    }
+    if (rhs->isEmpty())
+    {
+        return lhs;
+    }
+    return Range{std::min(lhs->min, rhs->min), std::max(lhs->max, rhs->max)};
+}
+
+/// Returns the largest value representable by 'type' or an empty optional if 'type' is not an integer-like of at most
+/// 64 bits. The index type is assumed to be 64 bit wide.
+std::optional<std::uint64_t> getMaxValue(mlir::Type type)
+{
+    if (type.isa<mlir::IndexType>())
+    {
+        return Range::unbounded;
+    }
+    auto integerType = type.dyn_cast<mlir::IntegerType>();
+    if (!integerType || integerType.getWidth() > 64)
+    {
+        return std::nullopt;
+    }
+    if (integerType.getWidth() == 64)
+    {
+        return Range::unbounded;
+    }
+    return (std::uint64_t{1} << integerType.getWidth()) - 1;
+}
+
+/// Returns the range of a value of 'type' of which nothing else is known.
+Lattice getDefaultRange(mlir::Type type)
+{
+    if (auto max = getMaxValue(type))
+    {
+        return Range{0, *max};
+    }
+    return std::nullopt;
+}
+
+/// Returns the value passed to 'argument' by the terminator of the predecessor 'pred' or a null value if unknown.
+mlir::Value getIncoming(mlir::BlockArgument argument, mlir::Block::pred_iterator pred)
+{
+    auto branchOp = mlir::dyn_cast<mlir::BranchOpInterface>((*pred)->getTerminator());
+    if (!branchOp)
+    {
+        return nullptr;
+    }
+    return branchOp.getSuccessorOperands(pred.getSuccessorIndex())[argument.getArgNumber()];
+}
+
+/// Returns the outcomes possible when comparing a value within 'lhs' with a value within 'rhs'.
+std::uint8_t possibleOutcomes(const Range& lhs, const Range& rhs)
+{
+    std::uint8_t result = 0;
+    if (lhs.min < rhs.max || rhs.max == Range::unbounded)
+    {
+        result |= Less;
+    }
+    if (lhs.min <= rhs.max && rhs.min <= lhs.max)
+    {
+        result |= Equal;
+    }
+    if (lhs.max > rhs.min || lhs.max == Range::unbounded)
+    {
+        result |= Greater;
+    }
+    return result;
+}
+
+class RangeCheckElimination : public RangeCheckEliminationBase<RangeCheckElimination>
+{
+    llvm::DenseMap<mlir::Value, Lattice> m_ranges;
+    llvm::DenseMap<mlir::Block*, llvm::SmallVector<Comparison>> m_facts;
+    mlir::DominanceInfo* m_dominanceInfo = nullptr;
+
+    Lattice getRange(mlir::Value value);
+
+    Lattice getRangeAt(mlir::Value value, mlir::Block* block);
+
+    llvm::ArrayRef<Comparison> getFacts(mlir::Block* block);
+
+    Lattice transfer(mlir::Operation* op, mlir::Value result);
+
+    void computeRanges(mlir::Region& region);
+
+    std::optional<bool> evaluate(const Comparison& comparison, mlir::Block* block);
+
+protected:
+    void runOnOperation() override;
+};
+
+/// Returns the range of 'value' without taking any dominating conditions into account.
+Lattice RangeCheckElimination::getRange(mlir::Value value)
+{
+    if (auto iter = m_ranges.find(value); iter != m_ranges.end())
+    {
+        return iter->second;
+    }
+    return getDefaultRange(value.getType());
+}
+
+/// Returns the conditions known to hold within 'block'. These are the branch conditions of all edges leading to a
+/// dominator of 'block', which is the only way to enter said dominator.
+llvm::ArrayRef<Comparison> RangeCheckElimination::getFacts(mlir::Block* block)
+{
+    auto [iter, inserted] = m_facts.try_emplace(block);
+    if (!inserted || !m_dominanceInfo || !m_dominanceInfo->isReachableFromEntry(block))
+    {
+        return iter->second;
+    }
+    llvm::SmallVector<Comparison> facts;
+    for (auto* node = m_dominanceInfo->getNode(block); node; node = node->getIDom())
+    {
+        auto* dominator = node->getBlock();
+        auto* pred = dominator->getSinglePredecessor();
+        if (!pred)
+        {
+            continue;
+        }
+        auto condBr = mlir::dyn_cast<mlir::cf::CondBranchOp>(pred->getTerminator());
+        if (!condBr || condBr.getTrueDest() == condBr.getFalseDest())
+        {
+            continue;
+        }
+        auto comparison = getComparison(condBr.getCondition());
+        if (!comparison)
+        {
+            continue;
+        }
+        if (condBr.getFalseDest() == dominator)
+        {
+            comparison->mask = Any & ~comparison->mask;
+        }
+        facts.push_back(*comparison);
+    }
+    iter->second = std::move(facts);
+    return iter->second;
+}
+
+/// Returns the range of 'value' within 'block', refined by the conditions known to hold within 'block'.
+Lattice RangeCheckElimination::getRangeAt(mlir::Value value, mlir::Block* block)
+{
+    auto range = getRange(value);
+    if (!range || range->isEmpty())
+    {
+        return range;
+    }
+    for (const auto& fact : getFacts(block))
+    {
+        if (fact.kind == Comparison::Signed || fact.lhs == fact.rhs)
+        {
+            continue;
+        }
+        mlir::Value other;
+        std::uint8_t mask;
+        if (fact.lhs == value)
+        {
+            other = fact.rhs;
+            mask = fact.mask;
+        }
+        else if (fact.rhs == value)
+        {
+            other = fact.lhs;
+            mask = swapOutcomes(fact.mask);
+        }
+        else
+        {
+            continue;
+        }
+        auto otherRange = getRange(other);
+        if (!otherRange || otherRange->isEmpty())
+        {
+            continue;
+        }
+        if (!(mask & Greater) && otherRange->max != Range::unbounded)
+        {
+            range->max = std::min(range->max, (mask & Equal) ? otherRange->max : otherRange->max - 1);
+        }
+        if (!(mask & Less))
+        {
+            auto min = otherRange->min;
+            if (!(mask & Equal) && min != Range::unbounded)
+            {
+                min++;
+            }
+            range->min = std::max(range->min, min);
+        }
+    }
+    return range;
+}
+
+/// Calculates the range of 'result' of 'op' from the ranges of its operands. Operands are refined by the conditions
+/// known to hold within the block of 'op'.
+Lattice RangeCheckElimination::transfer(mlir::Operation* op, mlir::Value result)
+{
+    auto* block = op->getBlock();
+    return llvm::TypeSwitch<mlir::Operation*, Lattice>(op)
+        .Case(
+            [&](mlir::arith::ConstantOp constantOp) -> Lattice
+            {
+                auto integer = constantOp.getValue().dyn_cast<mlir::IntegerAttr>();
+                if (!integer || !getMaxValue(integer.getType()))
+                {
+                    return getDefaultRange(result.getType());
+                }
+                auto value = integer.getValue().getZExtValue();
+                return Range{value, value};
+            })
+        .Case(
+            [&](mlir::arith::AddIOp addOp) -> Lattice
+            {
+                auto lhs = getRangeAt(addOp.getLhs(), block);
+                auto rhs = getRangeAt(addOp.getRhs(), block);
+                auto max = getMaxValue(addOp.getType());
+                if (!lhs || !rhs || !max)
+                {
+                    return getDefaultRange(result.getType());
+                }
+                if (lhs->isEmpty() || rhs->isEmpty())
+                {
+                    return Range::empty();
+                }
+                // Integer additions wrap around on overflow.
+                if (lhs->max > *max - rhs->max)
+                {
+                    return Range{0, *max};
+                }
+                return Range{lhs->min + rhs->min, lhs->max + rhs->max};
+            })
+        .Case(
+            [&](mlir::arith::SubIOp subOp) -> Lattice
+            {
+                auto lhs = getRangeAt(subOp.getLhs(), block);
+                auto rhs = getRangeAt(subOp.getRhs(), block);
+                auto max = getMaxValue(subOp.getType());
+                if (!lhs || !rhs || !max)
+                {
+                    return getDefaultRange(result.getType());
+                }
+                if (lhs->isEmpty() || rhs->isEmpty())
+                {
+                    return Range::empty();
+                }
+                if (lhs->min < rhs->max || lhs->max == Range::unbounded)
+                {
+                    return Range{0, *max};
+                }
+                return Range{lhs->min - rhs->max, lhs->max - rhs->min};
+            })
+        .Case(
+            [&](pylir::Py::ConstantOp constantOp) -> Lattice
+            {
+                auto integer = constantOp.getConstant().dyn_cast<pylir::Py::IntAttrInterface>();
+                if (!integer || integer.getIntegerValue().isNegative())
+                {
+                    return std::nullopt;
+                }
+                auto value = integer.getIntegerValue().tryGetInteger<std::uint64_t>();
+                if (!value || *value == Range::unbounded)
+                {
+                    return Range{Range::unbounded, Range::unbounded};
+                }
+                return Range{*value, *value};
+            })
+        .Case([&](pylir::Py::IntFromIntegerOp fromIntegerOp) -> Lattice
+              { return getRangeAt(fromIntegerOp.getInput(), block); })
+        .Case(
+            [&](pylir::Py::IntAddOp addOp) -> Lattice
+            {
+                auto lhs = getRangeAt(addOp.getLhs(), block);
+                auto rhs = getRangeAt(addOp.getRhs(), block);
+                if (!lhs || !rhs)
+                {
+                    return std::nullopt;
+                }
+                if (lhs->isEmpty() || rhs->isEmpty())
+                {
+                    return Range::empty();
+                }
+                // Python integers are of arbitrary precision. Sums exceeding the range of 'Range' saturate to
+                // 'unbounded'.
+                auto saturatingAdd = [](std::uint64_t lhs, std::uint64_t rhs)
+                {
+                    if (lhs > Range::unbounded - rhs)
+                    {
+                        return Range::unbounded;
+                    }
+                    return lhs + rhs;
+                };
+                return Range{saturatingAdd(lhs->min, rhs->min), saturatingAdd(lhs->max, rhs->max)};
+            })
+        .Default([&](auto) { return getDefaultRange(result.getType()); });
+}
+
+void RangeCheckElimination::computeRanges(mlir::Region& region)
+{
+    llvm::ReversePostOrderTraversal<mlir::Block*> rpot(&region.front());
+    // All values are initially unreached.
+    for (auto* block : rpot)
+    {
+        if (!block->isEntryBlock())
+        {
+            for (auto arg : block->getArguments())
+            {
+                m_ranges[arg] = Range::empty();
+            }
+        }
+        for (auto& op : *block)
+        {
+            for (auto result : op.getResults())
+            {
+                m_ranges[result] = Range::empty();
+            }
+        }
+    }
+
+    // Ranges only ever grow. Block arguments are additionally widened on every change after their first, guaranteeing
+    // termination: Every bound can at most be widened once before the range becomes unknown.
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (auto* block : rpot)
+        {
+            if (!block->isEntryBlock())
+            {
+                for (auto arg : block->getArguments())
+                {
+                    Lattice range = Range::empty();
+                    for (auto pred = block->pred_begin(); pred != block->pred_end(); pred++)
+                    {
+                        auto incoming = getIncoming(arg, pred);
+                        if (!incoming)
+                        {
+                            range = getDefaultRange(arg.getType());
+                            break;
+                        }
+                        range = join(range, getRangeAt(incoming, *pred));
+                    }
+
+                    auto& old = m_ranges[arg];
+                    range = join(old, range);
+                    if (old == range)
+                    {
+                        continue;
+                    }
+                    changed = true;
+                    if (range && old && !old->isEmpty())
+                    {
+                        if (range->min < old->min)
+                        {
+                            range->min = 0;
+                        }
+                        if (range->max > old->max)
+                        {
+                            range->max = getMaxValue(arg.getType()).value_or(Range::unbounded);
+                        }
+                    }
+                    old = range;
+                }
+            }
+            for (auto& op : *block)
+            {
+                for (auto result : op.getResults())
+                {
+                    auto& old = m_ranges[result];
+                    auto range = join(old, transfer(&op, result));
+                    if (old != range)
+                    {
+                        old = range;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Evaluates 'comparison' within 'block'. Returns an empty optional if the result is not known.
+std::optional<bool> RangeCheckElimination::evaluate(const Comparison& comparison, mlir::Block* block)
+{
+    std::uint8_t possible = Any;
+    auto lhs = getRangeAt(comparison.lhs, block);
+    auto rhs = getRangeAt(comparison.rhs, block);
+    if (lhs && rhs && !lhs->isEmpty() && !rhs->isEmpty())
+    {
+        switch (comparison.kind)
+        {
+            case Comparison::Unsigned:
+            case Comparison::PyInt: possible = possibleOutcomes(*lhs, *rhs); break;
+            case Comparison::Signed:
+            {
+                // Signed and unsigned comparisons agree if neither value has the sign bit set.
+                auto max = getMaxValue(comparison.lhs.getType());
+                if (max && lhs->max <= *max / 2 && rhs->max <= *max / 2)
+                {
+                    possible = possibleOutcomes(*lhs, *rhs);
+                }
+                break;
+            }
+        }
+    }
+
+    for (const auto& fact : getFacts(block))
+    {
+        // Equality is the same regardless of the kind of comparison.
+        auto isEquality = [](std::uint8_t mask) { return mask == Equal || mask == (Less | Greater); };
+        if (fact.kind != comparison.kind && !isEquality(fact.mask) && !isEquality(comparison.mask))
+        {
+            continue;
+        }
+        if (fact.lhs == comparison.lhs && fact.rhs == comparison.rhs)
+        {
+            possible &= fact.mask;
+        }
+        else if (fact.lhs == comparison.rhs && fact.rhs == comparison.lhs)
+        {
+            possible &= swapOutcomes(fact.mask);
+        }
+    }
+
+    // No outcome being possible means the block is unreachable.
+    if (!possible)
+    {
+        return std::nullopt;
+    }
+    if ((possible & comparison.mask) == possible)
+    {
+        return true;
+    }
+    if (!(possible & comparison.mask))
+    {
+        return false;
+    }
+    return std::nullopt;
+}
+
+void RangeCheckElimination::runOnOperation()
+{
+    if (getOperation()->getNumRegions() != 1 || getOperation()->getRegion(0).empty())
+    {
+        markAllAnalysesPreserved();
+        return;
+    }
+    auto& region = getOperation()->getRegion(0);
+
+    m_ranges.clear();
+    m_facts.clear();
+    // DominanceInfo does not allow fetching a dominator tree of a single block region. Such a region has no branches
+    // and therefore no conditions known to hold either.
+    m_dominanceInfo = region.hasOneBlock() ? nullptr : &getAnalysis<mlir::DominanceInfo>();
+    computeRanges(region);
+
+    mlir::Value constants[2];
+    auto getConstant = [&](bool value)
+    {
+        if (!constants[value])
+        {
+            auto builder = mlir::OpBuilder::atBlockBegin(&region.front());
+            constants[value] =
+                builder.create<mlir::arith::ConstantOp>(getOperation()->getLoc(), builder.getBoolAttr(value));
+        }
+        return constants[value];
+    };
+
+    bool changed = false;
+    for (auto& block : region)
+    {
+        for (auto& op : llvm::make_early_inc_range(block))
+        {
+            if (op.getNumResults() != 1)
+            {
+                continue;
+            }
+            auto comparison = getComparison(op.getResult(0));
+            if (!comparison)
+            {
+                continue;
+            }
+            bool replaced = false;
+            // Every use is evaluated separately, as uses in blocks dominated by a branch on the comparison know its
+            // result.
+            for (auto& use : llvm::make_early_inc_range(op.getUses()))
+            {
+                auto* useBlock = region.findAncestorBlockInRegion(*use.getOwner()->getBlock());
+                if (!useBlock)
+                {
+                    continue;
+                }
+                auto result = evaluate(*comparison, useBlock);
+                if (!result)
+                {
+                    continue;
+                }
+                use.set(getConstant(*result));
+                replaced = true;
+                m_checksEliminated++;
+            }
+            if (replaced && op.use_empty())
+            {
+                op.erase();
+            }
+            changed = changed || replaced;
+        }
+    }
+    if (!changed)
+    {
+        markAllAnalysesPreserved();
+        return;
+    }
+    markAnalysesPreserved<mlir::DominanceInfo>();
+}
+} // namespace
+
+std::unique_ptr<mlir::Pass> pylir::Py::createRangeCheckEliminationPass()
+{
+    return std::make_unique<RangeCheckElimination>();
+}
@@ -0,0 +1,236 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/IR/Dominance.h>
+#include <mlir/IR/Matchers.h>
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/TypeSwitch.h>
+
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+#include <pylir/Optimizer/PylirPy/Util/Builtins.hpp>
+#include <pylir/Optimizer/PylirPy/Util/PyBuilder.hpp>
+
+#include "PassDetail.hpp"
+#include "Passes.hpp"
+
+namespace
+{
+struct SnapshotModuleInitPass : public SnapshotModuleInitBase<SnapshotModuleInitPass>
+{
+    void runOnOperation() override;
+};
+
+llvm::Optional<llvm::SmallVector<mlir::Attribute>> getConstantOperands(mlir::ValueRange values)
+{
+    llvm::SmallVector<mlir::Attribute> result;
+    for (auto iter : values)
+    {
+        mlir::Attribute attr;
+        if (!mlir::matchPattern(iter, mlir::m_Constant(&attr))
+            || !attr.isa<pylir::Py::ObjectAttrInterface, mlir::SymbolRefAttr>())
+        {
+            return llvm::None;
+        }
+        result.push_back(attr);
+    }
+    return result;
+}
+
+/// Returns true if 'attr' is an exact 'str' or 'int' constant. Hashing and comparing these at runtime calls no user
+/// code and can't raise, making it safe to insert them into a dict at compile time. Symbol references are excluded,
+/// as their type and therefore their '__hash__' and '__eq__' implementations are unknown.
+bool isSnapshottableKey(mlir::Attribute attr)
+{
+    if (auto str = attr.dyn_cast<pylir::Py::StrAttr>())
+    {
+        return str.getTypeObject().getValue() == llvm::StringRef{pylir::Py::Builtins::Str.name};
+    }
+    if (auto integer = attr.dyn_cast<pylir::Py::IntAttr>())
+    {
+        return integer.getTypeObject().getValue() == llvm::StringRef{pylir::Py::Builtins::Int.name};
+    }
+    return false;
+}
+
+/// Compares two keys accepted by 'isSnapshottableKey' the way the '__eq__' implementations of 'str' and 'int' would.
+bool pythonKeysEqual(mlir::Attribute lhs, mlir::Attribute rhs)
+{
+    if (auto lhsStr = lhs.dyn_cast<pylir::Py::StrAttr>())
+    {
+        auto rhsStr = rhs.dyn_cast<pylir::Py::StrAttr>();
+        return rhsStr && lhsStr.getValue() == rhsStr.getValue();
+    }
+    auto lhsInt = lhs.cast<pylir::Py::IntAttr>();
+    auto rhsInt = rhs.dyn_cast<pylir::Py::IntAttr>();
+    return rhsInt && lhsInt.getValue() == rhsInt.getValue();
+}
+
+/// Returns an attribute equal to the object that 'op' creates if it can be computed at compile time. Returns a null
+/// attribute otherwise.
+pylir::Py::ObjectAttrInterface snapshotObject(mlir::Operation* op)
+{
+    return llvm::TypeSwitch<mlir::Operation*, pylir::Py::ObjectAttrInterface>(op)
+        .Case([](pylir::Py::ConstantOp constantOp) -> pylir::Py::ObjectAttrInterface
+              { return constantOp.getConstant().dyn_cast<pylir::Py::ObjectAttrInterface>(); })
+        .Case([](pylir::Py::MakeFuncOp makeFuncOp) -> pylir::Py::ObjectAttrInterface
+              { return pylir::Py::FunctionAttr::get(makeFuncOp.getContext(), makeFuncOp.getFunctionAttr()); })
+        .Case(
+            [](pylir::Py::MakeListOp makeListOp) -> pylir::Py::ObjectAttrInterface
+            {
+                if (!makeListOp.getIterExpansion().empty())
+                {
+                    return nullptr;
+                }
+                auto elements = getConstantOperands(makeListOp.getArguments());
+                if (!elements)
+                {
+                    return nullptr;
+                }
+                return pylir::Py::ListAttr::get(makeListOp.getContext(), *elements);
+            })
+        .Case(
+            [](pylir::Py::MakeDictOp makeDictOp) -> pylir::Py::ObjectAttrInterface
+            {
+                if (!makeDictOp.getMappingExpansion().empty())
+                {
+                    return nullptr;
+                }
+                auto keys = getConstantOperands(makeDictOp.getKeys());
+                if (!keys || !llvm::all_of(*keys, isSnapshottableKey))
+                {
+                    return nullptr;
+                }
+                auto values = getConstantOperands(makeDictOp.getValues());
+                if (!values)
+                {
+                    return nullptr;
+                }
+                // Inserting a key equal to a previous one keeps the previous key object, but replaces its value.
+                std::vector<std::pair<mlir::Attribute, mlir::Attribute>> entries;
+                for (auto [key, value] : llvm::zip(*keys, *values))
+                {
+                    auto existing = llvm::find_if(entries, [key = key](const auto& entry)
+                                                  { return pythonKeysEqual(entry.first, key); });
+                    if (existing != entries.end())
+                    {
+                        existing->second = value;
+                        continue;
+                    }
+                    entries.emplace_back(key, value);
+                }
+                return pylir::Py::DictAttr::get(makeDictOp.getContext(), entries);
+            })
+        .Default({});
+}
+
+void SnapshotModuleInitPass::runOnOperation()
+{
+    auto module = getOperation();
+    auto initFunc = module.lookupSymbol<mlir::func::FuncOp>(m_initFunction);
+    if (!initFunc || initFunc.isDeclaration())
+    {
+        markAllAnalysesPreserved();
+        return;
+    }
+
+    mlir::SymbolTableCollection collection;
+    mlir::SymbolUserMap userMap(collection, module);
+    // The entry block of the init function is executed exactly once, as long as no one within the module calls it
+    // again. Objects created within it are therefore unique and can be replaced by global values.
+    if (!userMap.getUsers(initFunc).empty())
+    {
+        markAllAnalysesPreserved();
+        return;
+    }
+    mlir::Block* entryBlock = &initFunc.getBody().front();
+
+    bool changed = false;
+    for (auto handle : llvm::make_early_inc_range(module.getOps<pylir::Py::GlobalHandleOp>()))
+    {
+        if (handle.isPublic())
+        {
+            continue;
+        }
+        // Loading from a handle before storing to it is undefined behaviour. If there is only a single store, every
+        // load is therefore guaranteed to return the stored object.
+        pylir::Py::StoreOp singleStore;
+        bool hasSingleStore = true;
+        auto users = userMap.getUsers(handle);
+        for (auto* op : users)
+        {
+            if (mlir::isa<pylir::Py::LoadOp>(op))
+            {
+                continue;
+            }
+            auto storeOp = mlir::dyn_cast<pylir::Py::StoreOp>(op);
+            if (!storeOp || singleStore)
+            {
+                hasSingleStore = false;
+                break;
+            }
+            singleStore = storeOp;
+        }
+        if (!singleStore || !hasSingleStore)
+        {
+            continue;
+        }
+
+        auto* creationOp = singleStore.getValue().getDefiningOp();
+        if (!creationOp || creationOp->getBlock() != entryBlock)
+        {
+            continue;
+        }
+        auto attr = snapshotObject(creationOp);
+        if (!attr)
+        {
+            continue;
+        }
+
+        auto symbolRef = mlir::FlatSymbolRefAttr::get(handle);
+        for (auto* op : users)
+        {
+            if (op == singleStore)
+            {
+                continue;
+            }
+            pylir::Py::PyBuilder builder(op);
+            auto newOp = builder.createConstant(symbolRef);
+            op->replaceAllUsesWith(newOp);
+            op->erase();
+        }
+        singleStore->erase();
+        // Any other uses of the created object, such as setting its slots, now refer to the global value instead.
+        // Constants are left alone since they are immutable and may be used independently of the handle.
+        if (!mlir::isa<pylir::Py::ConstantOp>(creationOp))
+        {
+            pylir::Py::PyBuilder builder(creationOp);
+            auto newOp = builder.createConstant(symbolRef);
+            creationOp->replaceAllUsesWith(newOp);
+            creationOp->erase();
+        }
+
+        pylir::Py::PyBuilder builder(handle);
+        auto globalValue = builder.createGlobalValue(handle.getSymName(), false, attr);
+        globalValue.setVisibility(handle.getVisibility());
+        handle->erase();
+        m_objectsSnapshotted++;
+        changed = true;
+    }
+    if (!changed)
+    {
+        markAllAnalysesPreserved();
+        return;
+    }
+    markAnalysesPreserved<mlir::DominanceInfo>();
+}
+
+} // namespace
+
+std::unique_ptr<mlir::Pass> pylir::Py::createSnapshotModuleInitPass()
+{
+    return std::make_unique<SnapshotModuleInitPass>();
+}
@@ -4,10 +4,18 @@
 // See https://llvm.org/LICENSE.txt for license information.
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+#include <mlir/IR/BuiltinOps.h>
 #include <mlir/IR/Threading.h>
+#include <mlir/Parser/Parser.h>
 #include <mlir/Pass/PassManager.h>
 
 #include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/FileUtilities.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_sha1_ostream.h>
 
 #include <pylir/Optimizer/Analysis/BodySize.hpp>
 #include <pylir/Optimizer/PylirPy/Transforms/Util/InlinerUtil.hpp>
@@ -27,10 +35,12 @@ struct CallingContext
 {
     mlir::StringAttr callee;
     std::vector<llvm::Optional<std::pair<mlir::OperationName, std::size_t>>> callArguments;
+    bool hot = false;
 
     explicit CallingContext(mlir::StringAttr callee) : callee(callee) {}
 
-    CallingContext(mlir::StringAttr callee, mlir::OperandRange values) : callee(callee), callArguments(values.size())
+    CallingContext(mlir::StringAttr callee, mlir::OperandRange values, bool hot)
+        : callee(callee), callArguments(values.size()), hot(hot)
     {
         for (auto [src, dest] : llvm::zip(values, callArguments))
         {
@@ -43,7 +53,7 @@ struct CallingContext
 
     bool operator==(const CallingContext& rhs) const
     {
-        return std::tie(callee, callArguments) == std::tie(rhs.callee, rhs.callArguments);
+        return std::tie(callee, callArguments, hot) == std::tie(rhs.callee, rhs.callArguments, rhs.hot);
     }
 
     bool operator!=(const CallingContext& rhs) const
@@ -70,7 +80,8 @@ struct llvm::DenseMapInfo<CallingContext>
     static inline unsigned getHashValue(const CallingContext& value)
     {
         return llvm::hash_combine(value.callee,
-                                  llvm::hash_combine_range(value.callArguments.begin(), value.callArguments.end()));
+                                  llvm::hash_combine_range(value.callArguments.begin(), value.callArguments.end()),
+                                  value.hot);
     }
 
     static inline bool isEqual(const CallingContext& lhs, const CallingContext& rhs)
@@ -82,15 +93,126 @@ struct llvm::DenseMapInfo<CallingContext>
 namespace
 {
 
+/// Database of inlining decisions shared between all threads. It can optionally be persisted in a file to share
+/// decisions across compilations. Persisted decisions are keyed by a hash of the callee and the calling context.
+/// Inlining a call is always correct, hence an outdated decision at worst leads to a less profitable result.
 class TrialDataBase
 {
     llvm::DenseMap<CallingContext, std::shared_future<bool>> m_decisions;
     mutable std::mutex mutex;
+    llvm::DenseMap<mlir::StringAttr, std::string> m_calleeHashes;
+    llvm::StringMap<bool> m_persisted;
+
+    static constexpr llvm::StringLiteral cacheAttrName = "pylir.trial_inliner_cache";
+
+    llvm::Optional<std::string> getKey(const CallingContext& context) const
+    {
+        auto hash = m_calleeHashes.find(context.callee);
+        if (hash == m_calleeHashes.end())
+        {
+            return llvm::None;
+        }
+        llvm::raw_sha1_ostream stream;
+        stream << hash->second;
+        for (const auto& iter : context.callArguments)
+        {
+            stream << '\0';
+            if (iter)
+            {
+                stream << iter->first.getStringRef() << ':' << iter->second;
+            }
+        }
+        if (context.hot)
+        {
+            stream << '\0' << "hot";
+        }
+        return llvm::toHex(stream.sha1());
+    }
 
 public:
+    /// Sets the hash used to identify 'callee' in the persisted database. Calls to callees without a hash are never
+    /// persisted. Must not be called concurrently with any other method.
+    void setCalleeHash(mlir::StringAttr callee, std::string hash)
+    {
+        m_calleeHashes[callee] = std::move(hash);
+    }
+
+    /// Loads previously persisted decisions from 'path'. Must not be called concurrently with any other method.
+    void load(llvm::StringRef path, mlir::MLIRContext* context)
+    {
+        auto buffer = llvm::MemoryBuffer::getFile(path);
+        if (!buffer)
+        {
+            return;
+        }
+        // The database is purely an optimization. A corrupt or outdated file is therefore simply ignored.
+        mlir::ScopedDiagnosticHandler handler(context, [](mlir::Diagnostic&) { return mlir::success(); });
+        auto module = mlir::parseSourceString<mlir::ModuleOp>((*buffer)->getBuffer(), context);
+        if (!module)
+        {
+            return;
+        }
+        auto entries = (*module)->getAttrOfType<mlir::DictionaryAttr>(cacheAttrName);
+        if (!entries)
+        {
+            return;
+        }
+        for (auto iter : entries)
+        {
+            if (auto decision = iter.getValue().dyn_cast<mlir::BoolAttr>())
+            {
+                m_persisted[iter.getName().getValue()] = decision.getValue();
+            }
+        }
+    }
+
+    /// Saves all decisions, including previously loaded ones, to 'path'. Must only be called once all decisions have
+    /// been made.
+    void save(llvm::StringRef path, mlir::MLIRContext* context)
+    {
+        for (auto& [callingContext, decision] : m_decisions)
+        {
+            if (auto key = getKey(callingContext))
+            {
+                m_persisted[*key] = decision.get();
+            }
+        }
+
+        // Sorted to keep the file deterministic.
+        auto keys = llvm::to_vector(m_persisted.keys());
+        llvm::sort(keys);
+        llvm::SmallVector<mlir::NamedAttribute> entries;
+        for (auto key : keys)
+        {
+            entries.emplace_back(mlir::StringAttr::get(context, key),
+                                 mlir::BoolAttr::get(context, m_persisted.lookup(key)));
+        }
+        mlir::OwningOpRef<mlir::ModuleOp> module = mlir::ModuleOp::create(mlir::UnknownLoc::get(context));
+        (*module)->setAttr(cacheAttrName, mlir::DictionaryAttr::get(context, entries));
+
+        std::string content;
+        llvm::raw_string_ostream stream(content);
+        module->print(stream);
+
+        // Like the compilation cache, failing to write the database is not an error.
+        if (llvm::sys::fs::create_directories(llvm::sys::path::parent_path(path)))
+        {
+            return;
+        }
+        if (auto error = llvm::writeFileAtomically(path + "-%%%%%%%%", path, stream.str()))
+        {
+            llvm::consumeError(std::move(error));
+        }
+    }
+
     std::variant<std::promise<bool>, bool> lookup(CallingContext context)
     {
         std::unique_lock lock{mutex};
+        llvm::Optional<std::string> key;
+        if (!m_persisted.empty())
+        {
+            key = getKey(context);
+        }
         auto [iter, inserted] = m_decisions.try_emplace(std::move(context), std::shared_future<bool>{});
         if (!inserted)
         {
@@ -98,6 +220,16 @@ public:
             lock.unlock();
             return copy.get();
         }
+        if (key)
+        {
+            if (auto persisted = m_persisted.find(*key); persisted != m_persisted.end())
+            {
+                std::promise<bool> promise;
+                promise.set_value(persisted->second);
+                iter->second = promise.get_future().share();
+                return persisted->second;
+            }
+        }
         std::promise<bool> promise;
         iter->second = promise.get_future().share();
         return promise;
@@ -184,7 +316,7 @@ class TrialInliner : public TrialInlinerBase<TrialInliner>
     mlir::FailureOr<bool> performTrial(mlir::FunctionOpInterface functionOpInterface,
                                        mlir::CallOpInterface callOpInterface,
                                        mlir::CallableOpInterface callableOpInterface, std::size_t calleeSize,
-                                       mlir::OpPassManager& passManager)
+                                       bool hot, mlir::OpPassManager& passManager)
     {
         mlir::OwningOpRef<mlir::FunctionOpInterface> rollback = functionOpInterface.clone();
         auto callerSize = pylir::BodySize(functionOpInterface).getSize();
@@ -199,7 +331,8 @@ class TrialInliner : public TrialInlinerBase<TrialInliner>
         auto delta =
             static_cast<std::ptrdiff_t>(callerSize + calleeSize) - static_cast<std::ptrdiff_t>(newCombinedSize);
         auto reduction = 1.0 - (static_cast<std::ptrdiff_t>(calleeSize) - delta) / static_cast<double>(calleeSize);
-        if (reduction >= m_minCalleeSizeReduction / 100.0)
+        // Calls that a profile has shown to be hot only need to achieve half of the size reduction.
+        if (reduction >= m_minCalleeSizeReduction / (hot ? 200.0 : 100.0))
         {
             m_callsInlined++;
             return true;
@@ -286,7 +419,9 @@ class TrialInliner : public TrialInlinerBase<TrialInliner>
                     {
                         return mlir::WalkResult::advance();
                     }
-                    auto result = dataBase.lookup({ref.getAttr(), callOpInterface.getArgOperands()});
+                    auto count = callOpInterface->getAttrOfType<mlir::IntegerAttr>(pylir::Py::profileCountAttr);
+                    bool hot = count && count.getValue().getZExtValue() >= m_hotCallCount;
+                    auto result = dataBase.lookup({ref.getAttr(), callOpInterface.getArgOperands(), hot});
                     if (auto* maybeBool = std::get_if<bool>(&result))
                     {
                         m_cacheHits++;
@@ -306,7 +441,7 @@ class TrialInliner : public TrialInlinerBase<TrialInliner>
                     m_cacheMisses++;
                     auto trialResult =
                         performTrial(functionOpInterface, callOpInterface, inlineable->second.getCallable(),
-                                     inlineable->second.getCalleeSize(), passManager);
+                                     inlineable->second.getCalleeSize(), hot, passManager);
                     if (mlir::failed(trialResult))
                     {
                         failed = true;
@@ -360,6 +495,22 @@ protected:
         }
 
         TrialDataBase dataBase;
+        if (!m_cacheFile.empty())
+        {
+            // The decisions depend on the options of the pass as well, hence they are part of the hash.
+            std::string options;
+            llvm::raw_string_ostream optionsStream(options);
+            optionsStream << m_optimizationPipeline << '\0' << m_minCalleeSizeReduction << '\0';
+            for (auto& [name, inlineable] : originalCallables)
+            {
+                llvm::raw_sha1_ostream stream;
+                stream << optionsStream.str();
+                inlineable.getCallable()->print(stream, mlir::OpPrintingFlags{}.useLocalScope().assumeVerified());
+                dataBase.setCalleeHash(name, llvm::toHex(stream.sha1()));
+            }
+            dataBase.load(m_cacheFile, &getContext());
+        }
+
         if (mlir::failed(mlir::failableParallelForEach(&getContext(), functions,
                                                        [&](const auto& iter)
                                                        {
@@ -370,6 +521,11 @@ protected:
             signalPassFailure();
             return;
         }
+
+        if (!m_cacheFile.empty())
+        {
+            dataBase.save(m_cacheFile, &getContext());
+        }
     }
 
     mlir::LogicalResult initialize(mlir::MLIRContext*) override
@@ -378,6 +534,13 @@ protected:
     }
 
 public:
+    TrialInliner() = default;
+
+    explicit TrialInliner(llvm::StringRef cacheFile)
+    {
+        m_cacheFile = cacheFile.str();
+    }
+
     void getDependentDialects(mlir::DialectRegistry& registry) const override
     {
         TrialInlinerBase::getDependentDialects(registry);
@@ -397,3 +560,8 @@ std::unique_ptr<mlir::Pass> pylir::Py::createTrialInlinerPass()
 {
     return std::make_unique<TrialInliner>();
 }
+
+std::unique_ptr<mlir::Pass> pylir::Py::createTrialInlinerPass(llvm::StringRef cacheFile)
+{
+    return std::make_unique<TrialInliner>(cacheFile);
+}
@@ -0,0 +1,787 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/Dialect/Arithmetic/IR/Arithmetic.h>
+#include <mlir/Dialect/ControlFlow/IR/ControlFlowOps.h>
+#include <mlir/IR/SymbolTable.h>
+#include <mlir/Interfaces/ControlFlowInterfaces.h>
+#include <mlir/Interfaces/DataLayoutInterfaces.h>
+
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/MapVector.h>
+#include <llvm/ADT/SetVector.h>
+#include <llvm/ADT/TypeSwitch.h>
+
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+#include <pylir/Optimizer/PylirPy/IR/TypeRefineableInterface.hpp>
+#include <pylir/Optimizer/PylirPy/Util/Builtins.hpp>
+#include <pylir/Optimizer/PylirPy/Util/PyBuilder.hpp>
+#include <pylir/Support/Macros.hpp>
+
+#include "PassDetail.hpp"
+
+namespace
+{
+class Unboxing : public UnboxingBase<Unboxing>
+{
+protected:
+    void runOnOperation() override;
+};
+
+/// Unboxed representation of a python integer. Integers within the range of an unsigned 64 bit integer, which is the
+/// range supported by the runtime for conversions from and to integers, are kept in 'small' and 'boxed' is an unbound
+/// value. All other integers are kept in 'boxed', in which case the value of 'small' is unspecified.
+struct UnboxedInt
+{
+    mlir::Value small;
+    mlir::Value boxed;
+};
+
+/// Returns the python type of 'value' as calculated by 'TypeRefineableInterface' if it is known exactly.
+mlir::FlatSymbolRefAttr getExactType(mlir::Value value, mlir::SymbolTableCollection& collection)
+{
+    auto result = value.dyn_cast<mlir::OpResult>();
+    if (!result)
+    {
+        return nullptr;
+    }
+    auto refineable = mlir::dyn_cast<pylir::Py::TypeRefineableInterface>(result.getOwner());
+    if (!refineable)
+    {
+        return nullptr;
+    }
+    llvm::SmallVector<pylir::Py::TypeAttrUnion> operandTypes(refineable->getNumOperands(), nullptr);
+    llvm::SmallVector<pylir::Py::ObjectTypeInterface> resultTypes;
+    if (refineable.refineTypes(operandTypes, resultTypes, collection) != pylir::Py::TypeRefineResult::Success)
+    {
+        return nullptr;
+    }
+    auto type = resultTypes[result.getResultNumber()];
+    if (!type)
+    {
+        return nullptr;
+    }
+    return type.getTypeObject();
+}
+
+/// Returns the value passed to 'argument' by the terminator of the predecessor 'pred' or a null value if unknown.
+mlir::Value getIncoming(mlir::BlockArgument argument, mlir::Block::pred_iterator pred)
+{
+    auto branchOp = mlir::dyn_cast<mlir::BranchOpInterface>((*pred)->getTerminator());
+    if (!branchOp)
+    {
+        return nullptr;
+    }
+    return branchOp.getSuccessorOperands(pred.getSuccessorIndex())[argument.getArgNumber()];
+}
+
+/// Unboxes integers and booleans within a single region. Values are unboxed if they are known to be exactly of type
+/// 'builtins.int' or 'builtins.bool' and are used by an operation that can make use of the native value. The unboxed
+/// values are then propagated through block arguments and arithmetic. Boxing only occurs where a boxed value escapes.
+class RegionUnboxer
+{
+    mlir::Region& m_region;
+    mlir::SymbolTableCollection& m_collection;
+    pylir::Py::PyBuilder m_builder;
+    unsigned m_indexBitWidth;
+
+    llvm::DenseSet<mlir::Value> m_intBlockArgs;
+    llvm::DenseSet<mlir::Value> m_boolBlockArgs;
+    llvm::SetVector<mlir::Value> m_markedInts;
+    llvm::SetVector<mlir::Value> m_markedBools;
+
+    llvm::DenseMap<mlir::Value, UnboxedInt> m_unboxedInts;
+    llvm::DenseMap<mlir::Value, mlir::Value> m_unboxedBools;
+    std::vector<mlir::Operation*> m_deadOps;
+
+    std::size_t m_valuesUnboxed = 0;
+    std::size_t m_opsUnboxed = 0;
+
+    bool isExactly(mlir::Value value, llvm::StringRef typeName)
+    {
+        auto type = getExactType(value, m_collection);
+        return type && type.getValue() == typeName;
+    }
+
+    /// Returns the width of 'type' or 'llvm::None' if it is wider than the 64 bit native representation.
+    llvm::Optional<unsigned> getNativeWidth(mlir::Type type) const
+    {
+        unsigned width = type.isa<mlir::IndexType>() ? m_indexBitWidth : type.getIntOrFloatBitWidth();
+        if (width > 64)
+        {
+            return llvm::None;
+        }
+        return width;
+    }
+
+    /// Returns true if 'value' can be unboxed without calling into the runtime.
+    bool isUnboxableInt(mlir::Value value)
+    {
+        if (m_intBlockArgs.contains(value))
+        {
+            return true;
+        }
+        auto* op = value.getDefiningOp();
+        if (!op)
+        {
+            return false;
+        }
+        return llvm::TypeSwitch<mlir::Operation*, bool>(op)
+            .Case([](pylir::Py::IntAddOp) { return true; })
+            .Case([&](pylir::Py::IntFromIntegerOp fromInteger)
+                  { return getNativeWidth(fromInteger.getInput().getType()).hasValue(); })
+            .Case(
+                [](pylir::Py::ConstantOp constant)
+                {
+                    auto intAttr = constant.getConstant().dyn_cast<pylir::Py::IntAttr>();
+                    return intAttr && !intAttr.getValue().isNegative()
+                           && intAttr.getValue().tryGetInteger<std::uint64_t>();
+                })
+            .Default(false);
+    }
+
+    bool isUnboxableBool(mlir::Value value)
+    {
+        if (m_boolBlockArgs.contains(value))
+        {
+            return true;
+        }
+        if (value.getDefiningOp<pylir::Py::BoolFromI1Op>())
+        {
+            return true;
+        }
+        auto constant = value.getDefiningOp<pylir::Py::ConstantOp>();
+        return constant && constant.getConstant().isa<pylir::Py::BoolAttr>();
+    }
+
+    /// Calculates the block arguments whose incoming values are all unboxable. Starts out optimistically, assuming
+    /// every block argument qualifies and then removes all those that do not until a fixpoint is reached.
+    void collectBlockArgs(llvm::DenseSet<mlir::Value>& blockArgs, llvm::function_ref<bool(mlir::Value)> unboxable)
+    {
+        for (auto& block : llvm::drop_begin(m_region))
+        {
+            for (auto arg : block.getArguments())
+            {
+                if (!arg.getType().isa<pylir::Py::DynamicType>())
+                {
+                    continue;
+                }
+                if (llvm::all_of(block.getPredecessors(), [](mlir::Block* pred)
+                                 { return mlir::isa<mlir::BranchOpInterface>(pred->getTerminator()); }))
+                {
+                    blockArgs.insert(arg);
+                }
+            }
+        }
+
+        bool changed;
+        do
+        {
+            changed = false;
+            for (auto value : llvm::to_vector(blockArgs))
+            {
+                auto arg = value.cast<mlir::BlockArgument>();
+                for (auto pred = arg.getOwner()->pred_begin(); pred != arg.getOwner()->pred_end(); pred++)
+                {
+                    auto incoming = getIncoming(arg, pred);
+                    if (incoming && unboxable(incoming))
+                    {
+                        continue;
+                    }
+                    blockArgs.erase(arg);
+                    changed = true;
+                    break;
+                }
+            }
+        } while (changed);
+    }
+
+    /// Marks all values that should be unboxed. These are the operands of ops that can make use of the unboxed values
+    /// as well as all values flowing into them.
+    void markValues()
+    {
+        std::vector<mlir::Value> intWorkList;
+        std::vector<mlir::Value> boolWorkList;
+        for (auto& block : m_region)
+        {
+            for (auto& op : block)
+            {
+                llvm::TypeSwitch<mlir::Operation*>(&op)
+                    .Case(
+                        [&](pylir::Py::IntCmpOp cmpOp)
+                        {
+                            if (isUnboxableInt(cmpOp.getLhs()) && isUnboxableInt(cmpOp.getRhs()))
+                            {
+                                intWorkList.push_back(cmpOp.getLhs());
+                                intWorkList.push_back(cmpOp.getRhs());
+                            }
+                        })
+                    .Case(
+                        [&](pylir::Py::IntToIntegerOp toIntegerOp)
+                        {
+                            if (isUnboxableInt(toIntegerOp.getInput())
+                                && getNativeWidth(toIntegerOp.getResult().getType()))
+                            {
+                                intWorkList.push_back(toIntegerOp.getInput());
+                            }
+                        })
+                    .Case(
+                        [&](pylir::Py::BoolToI1Op toI1Op)
+                        {
+                            if (m_boolBlockArgs.contains(toI1Op.getInput()))
+                            {
+                                boolWorkList.push_back(toI1Op.getInput());
+                            }
+                        });
+            }
+        }
+
+        auto pushIncoming = [](mlir::Value value, std::vector<mlir::Value>& workList)
+        {
+            auto arg = value.cast<mlir::BlockArgument>();
+            for (auto pred = arg.getOwner()->pred_begin(); pred != arg.getOwner()->pred_end(); pred++)
+            {
+                workList.push_back(getIncoming(arg, pred));
+            }
+        };
+
+        while (!intWorkList.empty())
+        {
+            auto value = intWorkList.back();
+            intWorkList.pop_back();
+            if (!m_markedInts.insert(value))
+            {
+                continue;
+            }
+            if (m_intBlockArgs.contains(value))
+            {
+                pushIncoming(value, intWorkList);
+            }
+            else if (auto addOp = value.getDefiningOp<pylir::Py::IntAddOp>())
+            {
+                intWorkList.push_back(addOp.getLhs());
+                intWorkList.push_back(addOp.getRhs());
+            }
+        }
+
+        while (!boolWorkList.empty())
+        {
+            auto value = boolWorkList.back();
+            boolWorkList.pop_back();
+            if (!m_markedBools.insert(value))
+            {
+                continue;
+            }
+            if (m_boolBlockArgs.contains(value))
+            {
+                pushIncoming(value, boolWorkList);
+            }
+        }
+    }
+
+    void setInsertionPointAfterValue(mlir::Value value)
+    {
+        if (auto* op = value.getDefiningOp())
+        {
+            m_builder.setInsertionPointAfter(op);
+        }
+        else
+        {
+            m_builder.setInsertionPointToStart(value.cast<mlir::BlockArgument>().getOwner());
+        }
+        m_builder.setLoc(value.getLoc());
+    }
+
+    mlir::Value createUnbound()
+    {
+        return m_builder.createConstant(pylir::Py::UnboundAttr::get(m_builder.getContext()));
+    }
+
+    mlir::Value zeroExtendToI64(mlir::Value value)
+    {
+        auto width = *getNativeWidth(value.getType());
+        if (value.getType().isa<mlir::IndexType>())
+        {
+            value = m_builder.create<mlir::arith::IndexCastOp>(m_builder.getIntegerType(width), value);
+        }
+        if (width == 64)
+        {
+            return value;
+        }
+        return m_builder.create<mlir::arith::ExtUIOp>(m_builder.getI64Type(), value);
+    }
+
+    mlir::Value createBothSmall(const UnboxedInt& lhs, const UnboxedInt& rhs)
+    {
+        auto lhsSmall = m_builder.createIsUnboundValue(lhs.boxed);
+        auto rhsSmall = m_builder.createIsUnboundValue(rhs.boxed);
+        return m_builder.create<mlir::arith::AndIOp>(lhsSmall, rhsSmall);
+    }
+
+    /// Splits the current block at the insertion point and returns the block containing all operations after it.
+    /// The current block is left without a terminator.
+    mlir::Block* splitAtInsertionPoint()
+    {
+        auto* block = m_builder.getInsertionBlock();
+        auto* continuation = block->splitBlock(m_builder.getInsertionPoint());
+        m_builder.setInsertionPointToEnd(block);
+        return continuation;
+    }
+
+    /// Creates the boxed python integer of 'unboxed' at the current insertion point. Boxing only occurs if the integer
+    /// is actually small.
+    mlir::Value box(const UnboxedInt& unboxed)
+    {
+        if (auto constant = unboxed.boxed.getDefiningOp<pylir::Py::ConstantOp>();
+            constant && constant.getConstant().isa<pylir::Py::UnboundAttr>())
+        {
+            return m_builder.createIntFromInteger(unboxed.small);
+        }
+
+        auto isSmall = m_builder.createIsUnboundValue(unboxed.boxed);
+        auto* continuation = splitAtInsertionPoint();
+        auto result = continuation->addArgument(m_builder.getType<pylir::Py::DynamicType>(), m_builder.getCurrentLoc());
+        auto* boxBlock = new mlir::Block;
+        boxBlock->insertBefore(continuation);
+        m_builder.create<mlir::cf::CondBranchOp>(isSmall, boxBlock, mlir::ValueRange{}, continuation,
+                                                 mlir::ValueRange{unboxed.boxed});
+
+        m_builder.setInsertionPointToStart(boxBlock);
+        auto boxed = m_builder.createIntFromInteger(unboxed.small);
+        m_builder.create<mlir::cf::BranchOp>(continuation, mlir::ValueRange{boxed});
+
+        m_builder.setInsertionPointToStart(continuation);
+        return result;
+    }
+
+    UnboxedInt getUnboxedInt(mlir::Value value)
+    {
+        if (auto result = m_unboxedInts.find(value); result != m_unboxedInts.end())
+        {
+            return result->second;
+        }
+
+        if (auto addOp = value.getDefiningOp<pylir::Py::IntAddOp>(); addOp && m_markedInts.contains(value))
+        {
+            auto result = unboxAdd(addOp);
+            m_unboxedInts[value] = result;
+            return result;
+        }
+
+        setInsertionPointAfterValue(value);
+        UnboxedInt result;
+        if (auto fromInteger = value.getDefiningOp<pylir::Py::IntFromIntegerOp>();
+            fromInteger && getNativeWidth(fromInteger.getInput().getType()))
+        {
+            result = {zeroExtendToI64(fromInteger.getInput()), createUnbound()};
+        }
+        else if (auto constant = value.getDefiningOp<pylir::Py::ConstantOp>(); constant && isUnboxableInt(value))
+        {
+            auto integer = *constant.getConstant().cast<pylir::Py::IntAttr>().getValue().tryGetInteger<std::uint64_t>();
+            result = {m_builder.create<mlir::arith::ConstantIntOp>(integer, 64), createUnbound()};
+        }
+        else
+        {
+            // Integers that are not cheap to unbox are simply treated as large integers.
+            result = {m_builder.create<mlir::arith::ConstantIntOp>(0, 64), value};
+        }
+        m_unboxedInts[value] = result;
+        return result;
+    }
+
+    mlir::Value getUnboxedBool(mlir::Value value)
+    {
+        if (auto result = m_unboxedBools.find(value); result != m_unboxedBools.end())
+        {
+            return result->second;
+        }
+        if (auto fromI1 = value.getDefiningOp<pylir::Py::BoolFromI1Op>())
+        {
+            return fromI1.getInput();
+        }
+        setInsertionPointAfterValue(value);
+        auto constant = value.getDefiningOp<pylir::Py::ConstantOp>();
+        PYLIR_ASSERT(constant);
+        mlir::Value result = m_builder.create<mlir::arith::ConstantOp>(
+            m_builder.getBoolAttr(constant.getConstant().cast<pylir::Py::BoolAttr>().getValue()));
+        m_unboxedBools[value] = result;
+        return result;
+    }
+
+    /// Replaces 'addOp' with an addition of the native integers, guarded by an overflow check. If either of the
+    /// operands are large or the addition overflows the original boxed addition is executed instead.
+    UnboxedInt unboxAdd(pylir::Py::IntAddOp addOp)
+    {
+        auto lhs = getUnboxedInt(addOp.getLhs());
+        auto rhs = getUnboxedInt(addOp.getRhs());
+        m_builder.setInsertionPoint(addOp);
+        m_builder.setLoc(addOp.getLoc());
+        auto bothSmall = createBothSmall(lhs, rhs);
+        auto sum = m_builder.create<mlir::arith::AddIOp>(lhs.small, rhs.small);
+        auto noOverflow = m_builder.create<mlir::arith::CmpIOp>(mlir::arith::CmpIPredicate::uge, sum, lhs.small);
+        auto fastPath = m_builder.create<mlir::arith::AndIOp>(bothSmall, noOverflow);
+        auto unbound = createUnbound();
+
+        auto* continuation = splitAtInsertionPoint();
+        auto small = continuation->addArgument(m_builder.getI64Type(), addOp.getLoc());
+        auto boxed = continuation->addArgument(m_builder.getType<pylir::Py::DynamicType>(), addOp.getLoc());
+        auto* slowPath = new mlir::Block;
+        slowPath->insertBefore(continuation);
+        m_builder.create<mlir::cf::CondBranchOp>(fastPath, continuation, mlir::ValueRange{sum, unbound}, slowPath,
+                                                 mlir::ValueRange{});
+
+        m_builder.setInsertionPointToStart(slowPath);
+        auto lhsBoxed = box(lhs);
+        auto rhsBoxed = box(rhs);
+        auto result = m_builder.createIntAdd(lhsBoxed, rhsBoxed);
+        auto zero = m_builder.create<mlir::arith::ConstantIntOp>(0, 64);
+        m_builder.create<mlir::cf::BranchOp>(continuation, mlir::ValueRange{zero, result});
+
+        // The op is kept until all escaping uses of its result have been replaced.
+        addOp->dropAllReferences();
+        m_deadOps.push_back(addOp);
+        m_opsUnboxed++;
+        return {small, boxed};
+    }
+
+    static mlir::arith::CmpIPredicate toUnsignedPredicate(pylir::Py::IntCmpKind kind)
+    {
+        switch (kind)
+        {
+            case pylir::Py::IntCmpKind::eq: return mlir::arith::CmpIPredicate::eq;
+            case pylir::Py::IntCmpKind::ne: return mlir::arith::CmpIPredicate::ne;
+            case pylir::Py::IntCmpKind::lt: return mlir::arith::CmpIPredicate::ult;
+            case pylir::Py::IntCmpKind::le: return mlir::arith::CmpIPredicate::ule;
+            case pylir::Py::IntCmpKind::gt: return mlir::arith::CmpIPredicate::ugt;
+            case pylir::Py::IntCmpKind::ge: return mlir::arith::CmpIPredicate::uge;
+        }
+        PYLIR_UNREACHABLE;
+    }
+
+    void unboxCmp(pylir::Py::IntCmpOp cmpOp)
+    {
+        auto lhs = getUnboxedInt(cmpOp.getLhs());
+        auto rhs = getUnboxedInt(cmpOp.getRhs());
+        m_builder.setInsertionPoint(cmpOp);
+        m_builder.setLoc(cmpOp.getLoc());
+        auto bothSmall = createBothSmall(lhs, rhs);
+        auto fastResult =
+            m_builder.create<mlir::arith::CmpIOp>(toUnsignedPredicate(cmpOp.getPred()), lhs.small, rhs.small);
+
+        auto* continuation = splitAtInsertionPoint();
+        auto result = continuation->addArgument(m_builder.getI1Type(), cmpOp.getLoc());
+        auto* slowPath = new mlir::Block;
+        slowPath->insertBefore(continuation);
+        m_builder.create<mlir::cf::CondBranchOp>(bothSmall, continuation, mlir::ValueRange{fastResult}, slowPath,
+                                                 mlir::ValueRange{});
+
+        m_builder.setInsertionPointToStart(slowPath);
+        auto lhsBoxed = box(lhs);
+        auto rhsBoxed = box(rhs);
+        auto slowResult = m_builder.createIntCmp(cmpOp.getPred(), lhsBoxed, rhsBoxed);
+        m_builder.create<mlir::cf::BranchOp>(continuation, mlir::ValueRange{slowResult});
+
+        cmpOp.replaceAllUsesWith(result);
+        cmpOp->erase();
+        m_opsUnboxed++;
+    }
+
+    void unboxToInteger(pylir::Py::IntToIntegerOp toIntegerOp)
+    {
+        auto input = getUnboxedInt(toIntegerOp.getInput());
+        m_builder.setInsertionPoint(toIntegerOp);
+        m_builder.setLoc(toIntegerOp.getLoc());
+        auto isSmall = m_builder.createIsUnboundValue(input.boxed);
+
+        // Mirrors the semantics of the runtime implementation: Conversions to 64 bit integers always succeed, while
+        // narrower integers are only able to represent values up to and including 2^(width - 1).
+        auto type = toIntegerOp.getResult().getType();
+        auto width = *getNativeWidth(type);
+        mlir::Value fastResult = input.small;
+        mlir::Value fastSuccess;
+        if (width == 64)
+        {
+            fastSuccess = m_builder.create<mlir::arith::ConstantOp>(m_builder.getBoolAttr(true));
+        }
+        else
+        {
+            auto max = m_builder.create<mlir::arith::ConstantIntOp>(1uLL << (width - 1), 64);
+            fastSuccess = m_builder.create<mlir::arith::CmpIOp>(mlir::arith::CmpIPredicate::ule, input.small, max);
+            fastResult = m_builder.create<mlir::arith::TruncIOp>(m_builder.getIntegerType(width), fastResult);
+        }
+        if (type.isa<mlir::IndexType>())
+        {
+            fastResult = m_builder.create<mlir::arith::IndexCastOp>(type, fastResult);
+        }
+
+        auto* continuation = splitAtInsertionPoint();
+        auto result = continuation->addArgument(type, toIntegerOp.getLoc());
+        auto success = continuation->addArgument(m_builder.getI1Type(), toIntegerOp.getLoc());
+        auto* slowPath = new mlir::Block;
+        slowPath->insertBefore(continuation);
+        m_builder.create<mlir::cf::CondBranchOp>(isSmall, continuation, mlir::ValueRange{fastResult, fastSuccess},
+                                                 slowPath, mlir::ValueRange{});
+
+        m_builder.setInsertionPointToStart(slowPath);
+        auto slow = m_builder.createIntToInteger(type, input.boxed);
+        m_builder.create<mlir::cf::BranchOp>(continuation, slow->getResults());
+
+        toIntegerOp->replaceAllUsesWith(mlir::ValueRange{result, success});
+        toIntegerOp->erase();
+        m_opsUnboxed++;
+    }
+
+    /// Appends the unboxed incoming values of all block arguments in 'arguments' to the branch operands of every
+    /// predecessor.
+    template <class F>
+    void addIncomingValues(llvm::ArrayRef<mlir::BlockArgument> arguments, F getUnboxed)
+    {
+        llvm::MapVector<mlir::Block*, llvm::SmallVector<mlir::BlockArgument>> perBlock;
+        for (auto arg : arguments)
+        {
+            perBlock[arg.getOwner()].push_back(arg);
+        }
+        for (auto& [block, args] : perBlock)
+        {
+            llvm::SmallVector<std::pair<mlir::BranchOpInterface, unsigned>> predecessors;
+            for (auto pred = block->pred_begin(); pred != block->pred_end(); pred++)
+            {
+                predecessors.emplace_back(mlir::cast<mlir::BranchOpInterface>((*pred)->getTerminator()),
+                                          pred.getSuccessorIndex());
+            }
+            for (auto [branchOp, index] : predecessors)
+            {
+                llvm::SmallVector<mlir::Value> values;
+                for (auto arg : args)
+                {
+                    llvm::append_range(values, getUnboxed(branchOp.getSuccessorOperands(index)[arg.getArgNumber()]));
+                }
+                branchOp.getSuccessorOperands(index).append(values);
+            }
+        }
+    }
+
+    /// Returns true if 'use' is a branch operand to a block argument that is going to be removed.
+    bool isRemovedBranchOperand(mlir::OpOperand& use)
+    {
+        auto branchOp = mlir::dyn_cast<mlir::BranchOpInterface>(use.getOwner());
+        if (!branchOp)
+        {
+            return false;
+        }
+        auto arg = branchOp.getSuccessorBlockArgument(use.getOperandNumber());
+        if (!arg)
+        {
+            return false;
+        }
+        return (m_intBlockArgs.contains(*arg) && m_markedInts.contains(*arg))
+               || (m_boolBlockArgs.contains(*arg) && m_markedBools.contains(*arg));
+    }
+
+    void removeBlockArguments(llvm::ArrayRef<mlir::BlockArgument> arguments)
+    {
+        auto sorted = llvm::to_vector(arguments);
+        llvm::sort(sorted, [](mlir::BlockArgument lhs, mlir::BlockArgument rhs)
+                   { return lhs.getArgNumber() > rhs.getArgNumber(); });
+        for (auto arg : sorted)
+        {
+            auto* block = arg.getOwner();
+            for (auto pred = block->pred_begin(); pred != block->pred_end(); pred++)
+            {
+                mlir::cast<mlir::BranchOpInterface>((*pred)->getTerminator())
+                    .getSuccessorOperands(pred.getSuccessorIndex())
+                    .erase(arg.getArgNumber());
+            }
+            block->eraseArgument(arg.getArgNumber());
+        }
+    }
+
+public:
+    RegionUnboxer(mlir::Region& region, mlir::SymbolTableCollection& collection)
+        : m_region(region),
+          m_collection(collection),
+          m_builder(region.getContext()),
+          m_indexBitWidth(
+              mlir::DataLayout::closest(region.getParentOp()).getTypeSizeInBits(m_builder.getIndexType()))
+    {
+    }
+
+    void run()
+    {
+        collectBlockArgs(m_intBlockArgs,
+                         [&](mlir::Value value)
+                         { return m_intBlockArgs.contains(value) || isExactly(value, pylir::Py::Builtins::Int.name); });
+        collectBlockArgs(m_boolBlockArgs, [&](mlir::Value value) { return isUnboxableBool(value); });
+        markValues();
+
+        llvm::SmallVector<mlir::BlockArgument> intArgs;
+        llvm::SmallVector<mlir::BlockArgument> boolArgs;
+        for (auto value : m_markedInts)
+        {
+            if (!m_intBlockArgs.contains(value))
+            {
+                continue;
+            }
+            auto arg = value.cast<mlir::BlockArgument>();
+            intArgs.push_back(arg);
+            auto small = arg.getOwner()->addArgument(m_builder.getI64Type(), arg.getLoc());
+            auto boxed = arg.getOwner()->addArgument(arg.getType(), arg.getLoc());
+            m_unboxedInts[arg] = {small, boxed};
+        }
+        for (auto value : m_markedBools)
+        {
+            if (!m_boolBlockArgs.contains(value))
+            {
+                continue;
+            }
+            auto arg = value.cast<mlir::BlockArgument>();
+            boolArgs.push_back(arg);
+            m_unboxedBools[arg] = arg.getOwner()->addArgument(m_builder.getI1Type(), arg.getLoc());
+        }
+
+        llvm::SmallVector<mlir::Operation*> ops;
+        for (auto& block : m_region)
+        {
+            for (auto& op : block)
+            {
+                llvm::TypeSwitch<mlir::Operation*>(&op)
+                    .Case(
+                        [&](pylir::Py::IntCmpOp cmpOp)
+                        {
+                            if (m_markedInts.contains(cmpOp.getLhs()) && m_markedInts.contains(cmpOp.getRhs()))
+                            {
+                                ops.push_back(cmpOp);
+                            }
+                        })
+                    .Case(
+                        [&](pylir::Py::IntToIntegerOp toIntegerOp)
+                        {
+                            if (m_markedInts.contains(toIntegerOp.getInput())
+                                && getNativeWidth(toIntegerOp.getResult().getType()))
+                            {
+                                ops.push_back(toIntegerOp);
+                            }
+                        })
+                    .Case(
+                        [&](pylir::Py::BoolToI1Op toI1Op)
+                        {
+                            if (m_markedBools.contains(toI1Op.getInput()))
+                            {
+                                ops.push_back(toI1Op);
+                            }
+                        });
+            }
+        }
+
+        for (auto* op : ops)
+        {
+            llvm::TypeSwitch<mlir::Operation*>(op)
+                .Case([&](pylir::Py::IntCmpOp cmpOp) { unboxCmp(cmpOp); })
+                .Case([&](pylir::Py::IntToIntegerOp toIntegerOp) { unboxToInteger(toIntegerOp); })
+                .Case(
+                    [&](pylir::Py::BoolToI1Op toI1Op)
+                    {
+                        toI1Op.replaceAllUsesWith(m_unboxedBools[toI1Op.getInput()]);
+                        toI1Op->erase();
+                        m_opsUnboxed++;
+                    });
+        }
+
+        addIncomingValues(intArgs,
+                          [&](mlir::Value value)
+                          {
+                              auto unboxed = getUnboxedInt(value);
+                              return std::array<mlir::Value, 2>{unboxed.small, unboxed.boxed};
+                          });
+        addIncomingValues(boolArgs, [&](mlir::Value value) { return std::array{getUnboxedBool(value)}; });
+
+        // Box all remaining uses of values that are about to be removed. These are the escape points of the unboxed
+        // values.
+        for (auto value : m_markedInts)
+        {
+            if (!m_intBlockArgs.contains(value) && !value.getDefiningOp<pylir::Py::IntAddOp>())
+            {
+                continue;
+            }
+            auto uses = llvm::to_vector(llvm::map_range(value.getUses(), [](mlir::OpOperand& use) { return &use; }));
+            for (auto* use : uses)
+            {
+                if (isRemovedBranchOperand(*use))
+                {
+                    continue;
+                }
+                m_builder.setInsertionPoint(use->getOwner());
+                m_builder.setLoc(use->getOwner()->getLoc());
+                use->set(box(m_unboxedInts[value]));
+            }
+        }
+        for (auto arg : boolArgs)
+        {
+            auto uses = llvm::to_vector(llvm::map_range(arg.getUses(), [](mlir::OpOperand& use) { return &use; }));
+            mlir::Value boxed;
+            for (auto* use : uses)
+            {
+                if (isRemovedBranchOperand(*use))
+                {
+                    continue;
+                }
+                if (!boxed)
+                {
+                    m_builder.setInsertionPointToStart(arg.getOwner());
+                    m_builder.setLoc(arg.getLoc());
+                    boxed = m_builder.createBoolFromI1(m_unboxedBools[arg]);
+                }
+                use->set(boxed);
+            }
+        }
+
+        removeBlockArguments(intArgs);
+        removeBlockArguments(boolArgs);
+        for (auto* op : m_deadOps)
+        {
+            op->erase();
+        }
+        m_valuesUnboxed += intArgs.size() + boolArgs.size();
+    }
+
+    [[nodiscard]] std::size_t getValuesUnboxed() const
+    {
+        return m_valuesUnboxed;
+    }
+
+    [[nodiscard]] std::size_t getOpsUnboxed() const
+    {
+        return m_opsUnboxed;
+    }
+};
+
+void Unboxing::runOnOperation()
+{
+    mlir::SymbolTableCollection collection;
+    bool changed = false;
+    for (auto& region : getOperation()->getRegions())
+    {
+        if (region.empty())
+        {
+            continue;
+        }
+        RegionUnboxer unboxer(region, collection);
+        unboxer.run();
+        m_valuesUnboxed += unboxer.getValuesUnboxed();
+        m_opsUnboxed += unboxer.getOpsUnboxed();
+        changed = changed || unboxer.getOpsUnboxed() != 0;
+    }
+    if (!changed)
+    {
+        markAllAnalysesPreserved();
+    }
+}
+} // namespace
+
+std::unique_ptr<mlir::Pass> pylir::Py::createUnboxingPass()
+{
+    return std::make_unique<Unboxing>();
+}
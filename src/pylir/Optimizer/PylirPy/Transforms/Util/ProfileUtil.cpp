@@ -0,0 +1,32 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "ProfileUtil.hpp"
+
+#include <mlir/IR/FunctionInterfaces.h>
+#include <mlir/IR/SymbolTable.h>
+
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+
+std::vector<std::pair<mlir::Operation*, std::string>> pylir::Py::collectProfiledCallSites(mlir::ModuleOp module)
+{
+    std::vector<std::pair<mlir::Operation*, std::string>> result;
+    for (auto function : module.getOps<mlir::FunctionOpInterface>())
+    {
+        auto name = mlir::SymbolTable::getSymbolName(function).getValue();
+        std::size_t index = 0;
+        function->walk(
+            [&](mlir::Operation* op)
+            {
+                if (!mlir::isa<pylir::Py::FunctionCallOp, pylir::Py::FunctionInvokeOp>(op))
+                {
+                    return;
+                }
+                result.emplace_back(op, (name + "#" + llvm::Twine(index++)).str());
+            });
+    }
+    return result;
+}
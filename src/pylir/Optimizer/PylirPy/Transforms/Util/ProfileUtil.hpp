@@ -0,0 +1,21 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include <mlir/IR/BuiltinOps.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pylir::Py
+{
+/// Returns all call sites within 'module' whose callees are recorded by instrumented builds, together with the name
+/// identifying the call site within a profile. Call sites are named after the function they are contained in and their
+/// position within it. Names are therefore only stable across compilations of the same source with the same options.
+std::vector<std::pair<mlir::Operation*, std::string>> collectProfiledCallSites(mlir::ModuleOp module);
+} // namespace pylir::Py
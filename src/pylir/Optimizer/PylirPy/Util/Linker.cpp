@@ -0,0 +1,166 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "Linker.hpp"
+
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/IR/OperationSupport.h>
+#include <mlir/IR/SymbolTable.h>
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+
+namespace
+{
+/// Renames 'symbol', which is contained in 'table', to a name that is unused in both 'table' and 'other'. All uses
+/// within the operation of 'table' are updated as well.
+mlir::LogicalResult renameUnique(mlir::Operation* symbol, mlir::SymbolTable& table, mlir::SymbolTable& other)
+{
+    auto oldName = mlir::SymbolTable::getSymbolName(symbol);
+    std::size_t counter = 0;
+    std::string newName;
+    do
+    {
+        newName = (oldName.getValue() + "$" + llvm::Twine(counter++)).str();
+    } while (table.lookup(newName) || other.lookup(newName));
+
+    auto newNameAttr = mlir::StringAttr::get(symbol->getContext(), newName);
+    if (mlir::failed(mlir::SymbolTable::replaceAllSymbolUses(symbol, newNameAttr, table.getOp())))
+    {
+        return symbol->emitError("failed to rename symbol '") << oldName.getValue() << "'";
+    }
+    table.remove(symbol);
+    mlir::SymbolTable::setSymbolName(symbol, newNameAttr);
+    table.insert(symbol);
+    return mlir::success();
+}
+
+/// Returns true if 'lhs' and 'rhs' are definitions that are identical, including the operations within their regions.
+/// This is the case for the builtins that every module generated from Python source contains.
+bool isIdenticalDefinition(mlir::Operation* lhs, mlir::Operation* rhs)
+{
+    // Values of 'lhs' are mapped to the values of 'rhs' at the same position. A value may be used before the operation
+    // defining it has been compared, which is why both uses and definitions may create the mapping.
+    llvm::DenseMap<mlir::Value, mlir::Value> valueMapping;
+    auto mapValues = [&](mlir::Value lhsValue, mlir::Value rhsValue)
+    {
+        auto [iter, inserted] = valueMapping.try_emplace(lhsValue, rhsValue);
+        return mlir::success(inserted || iter->second == rhsValue);
+    };
+    return mlir::OperationEquivalence::isEquivalentTo(lhs, rhs, mapValues, mapValues,
+                                                      mlir::OperationEquivalence::IgnoreLocations);
+}
+
+constexpr llvm::StringLiteral moduleInitializer = "__init__";
+
+} // namespace
+
+mlir::LogicalResult pylir::Py::linkModules(mlir::ModuleOp destination, mlir::OwningOpRef<mlir::ModuleOp> source)
+{
+    mlir::SymbolTable destinationTable(destination);
+    mlir::SymbolTable sourceTable(*source);
+
+    // Decide on how to resolve every clash before modifying any of the modules. This is required as renaming private
+    // symbols changes the attributes referring to them, making otherwise identical global values compare unequal.
+    llvm::SmallVector<mlir::Operation*> sourceDuplicates;
+    llvm::SmallVector<mlir::Operation*> replacedDeclarations;
+    llvm::SmallVector<mlir::Operation*> sourceRenames;
+    llvm::SmallVector<mlir::Operation*> destinationRenames;
+    mlir::func::FuncOp sourceInitializer;
+    for (auto symbol : source->getOps<mlir::SymbolOpInterface>())
+    {
+        auto* existing = destinationTable.lookup(symbol.getName());
+        if (!existing)
+        {
+            continue;
+        }
+        auto existingSymbol = mlir::cast<mlir::SymbolOpInterface>(existing);
+        // Declarations refer to a public symbol defined in another module, which is why they are resolved by name
+        // even if private, as is required for declarations of functions. Private definitions are invisible to other
+        // modules and therefore never bound to a declaration.
+        if (symbol.isDeclaration())
+        {
+            if (!existingSymbol.isDeclaration() && existingSymbol.isPrivate())
+            {
+                destinationRenames.push_back(existing);
+                continue;
+            }
+            sourceDuplicates.push_back(symbol);
+            continue;
+        }
+        if (existingSymbol.isDeclaration())
+        {
+            if (symbol.isPrivate())
+            {
+                sourceRenames.push_back(symbol);
+                continue;
+            }
+            replacedDeclarations.push_back(existing);
+            continue;
+        }
+        if (symbol.isPrivate())
+        {
+            sourceRenames.push_back(symbol);
+            continue;
+        }
+        if (existingSymbol.isPrivate())
+        {
+            destinationRenames.push_back(existing);
+            continue;
+        }
+        // Both modules having been generated from a main module, they each contain a module initializer. The one of
+        // 'source' is renamed and called at the start of the one of 'destination'.
+        if (symbol.getName() == moduleInitializer && mlir::isa<mlir::func::FuncOp>(*symbol)
+            && mlir::isa<mlir::func::FuncOp>(existing))
+        {
+            sourceInitializer = mlir::cast<mlir::func::FuncOp>(*symbol);
+            sourceRenames.push_back(symbol);
+            continue;
+        }
+        if (isIdenticalDefinition(existing, symbol))
+        {
+            sourceDuplicates.push_back(symbol);
+            continue;
+        }
+        return symbol->emitError("redefinition of public symbol '") << symbol.getName() << "'";
+    }
+
+    for (auto* iter : sourceRenames)
+    {
+        if (mlir::failed(renameUnique(iter, sourceTable, destinationTable)))
+        {
+            return mlir::failure();
+        }
+    }
+    for (auto* iter : destinationRenames)
+    {
+        if (mlir::failed(renameUnique(iter, destinationTable, sourceTable)))
+        {
+            return mlir::failure();
+        }
+    }
+    for (auto* iter : sourceDuplicates)
+    {
+        iter->erase();
+    }
+    for (auto* iter : replacedDeclarations)
+    {
+        iter->erase();
+    }
+    if (sourceInitializer)
+    {
+        sourceInitializer.setPrivate();
+        auto destinationInitializer = destinationTable.lookup<mlir::func::FuncOp>(moduleInitializer);
+        auto builder = mlir::OpBuilder::atBlockBegin(&destinationInitializer.front());
+        builder.create<Py::CallOp>(sourceInitializer.getLoc(), sourceInitializer, mlir::ValueRange{});
+    }
+
+    destination.getBody()->getOperations().splice(destination.getBody()->end(), source->getBody()->getOperations());
+    return mlir::success();
+}
@@ -0,0 +1,22 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include <mlir/IR/BuiltinOps.h>
+#include <mlir/IR/OwningOpRef.h>
+#include <mlir/Support/LogicalResult.h>
+
+namespace pylir::Py
+{
+/// Moves all operations of 'source' into 'destination'. Public symbols are resolved by name: Declarations are
+/// replaced by definitions and public symbols defined identically in both modules, such as the builtins every
+/// module contains, are merged. Private declarations are resolved by name as well, but only to public definitions or
+/// other declarations. Private definitions whose names clash are renamed. If both modules contain a module
+/// initializer '__init__', the one of 'source' is made private and called at the start of the one of 'destination'.
+/// Fails if any other public symbol is defined differently in both modules, in which case neither module is modified.
+mlir::LogicalResult linkModules(mlir::ModuleOp destination, mlir::OwningOpRef<mlir::ModuleOp> source);
+} // namespace pylir::Py
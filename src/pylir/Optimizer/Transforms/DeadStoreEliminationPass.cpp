@@ -0,0 +1,195 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/IR/Dominance.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+
+#include <llvm/ADT/SetVector.h>
+
+#include <pylir/Optimizer/Analysis/MemorySSA.hpp>
+#include <pylir/Optimizer/Interfaces/CaptureInterface.hpp>
+#include <pylir/Optimizer/Interfaces/StoreInterface.hpp>
+
+#include "PassDetail.hpp"
+#include "Passes.hpp"
+
+namespace
+{
+
+struct DeadStoreEliminationPass : DeadStoreEliminationBase<DeadStoreEliminationPass>
+{
+protected:
+    void runOnOperation() override;
+};
+
+/// Returns true if 'operation' may read 'location'. A null 'location' denotes memory not accessible through any SSA
+/// value, which may therefore only be read by operations with unknown effects or effects not tied to a value.
+/// Operations writing 'location' are also considered reading it if their results are used, as these may depend on the
+/// prior contents of the memory, e.g. whether a dictionary entry existed. Stores that may execute user code may read
+/// anything.
+bool mayRead(mlir::Operation* operation, mlir::Value location, mlir::AliasAnalysis& aliasAnalysis)
+{
+    if (auto store = mlir::dyn_cast<pylir::StoreInterface>(operation))
+    {
+        return !store.isPureStore();
+    }
+    if (location)
+    {
+        auto modRef = aliasAnalysis.getModRef(operation, location);
+        return modRef.isRef() || (modRef.isMod() && !operation->use_empty());
+    }
+    auto memoryEffectOpInterface = mlir::dyn_cast<mlir::MemoryEffectOpInterface>(operation);
+    if (!memoryEffectOpInterface)
+    {
+        return true;
+    }
+    llvm::SmallVector<mlir::MemoryEffects::EffectInstance> effects;
+    memoryEffectOpInterface.getEffects(effects);
+    return llvm::any_of(effects,
+                        [](const mlir::MemoryEffects::EffectInstance& effect)
+                        { return !effect.getValue() && llvm::isa<mlir::MemoryEffects::Read>(effect.getEffect()); });
+}
+
+/// Returns true if the store 'def' is overwritten before anything could read the memory it has written. Only the
+/// definitions following 'def' within the same block are considered, which are executed whenever 'def' is.
+bool isOverwritten(pylir::MemSSA::MemoryDefOp def, pylir::StoreInterface store, mlir::AliasAnalysis& aliasAnalysis)
+{
+    auto location = store.getStoredLocation();
+    auto current = def;
+    while (true)
+    {
+        pylir::MemSSA::MemoryDefOp next;
+        for (auto* user : current->getUsers())
+        {
+            if (auto use = mlir::dyn_cast<pylir::MemSSA::MemoryUseOp>(user))
+            {
+                // Reads are always of SSA values.
+                if (location && !aliasAnalysis.alias(use.getRead(), location).isNo())
+                {
+                    return false;
+                }
+                continue;
+            }
+            auto userDef = mlir::dyn_cast<pylir::MemSSA::MemoryDefOp>(user);
+            if (!userDef || next || userDef->getBlock() != def->getBlock())
+            {
+                return false;
+            }
+            next = userDef;
+        }
+        if (!next)
+        {
+            return false;
+        }
+        if (store.isOverwrittenBy(next.getInstruction()))
+        {
+            return true;
+        }
+        if (mayRead(next.getInstruction(), location, aliasAnalysis))
+        {
+            return false;
+        }
+        current = next;
+    }
+}
+
+/// Returns true if 'object' is an allocation that never escapes and is never read. All stores into such an object are
+/// dead.
+bool isWriteOnlyAllocation(mlir::Value object)
+{
+    auto allocation = object.getDefiningOp<mlir::MemoryEffectOpInterface>();
+    if (!allocation || !allocation.getEffectOnValue<mlir::MemoryEffects::Allocate>(object))
+    {
+        return false;
+    }
+    for (auto& use : object.getUses())
+    {
+        auto* user = use.getOwner();
+        auto capture = mlir::dyn_cast<pylir::CaptureInterface>(user);
+        if (!capture || capture.capturesOperand(use.getOperandNumber()))
+        {
+            return false;
+        }
+        if (auto store = mlir::dyn_cast<pylir::StoreInterface>(user))
+        {
+            if (!store.isPureStore() || store.getStoredLocation() != object)
+            {
+                return false;
+            }
+            continue;
+        }
+        auto memoryEffectOpInterface = mlir::dyn_cast<mlir::MemoryEffectOpInterface>(user);
+        if (!memoryEffectOpInterface)
+        {
+            return false;
+        }
+        llvm::SmallVector<mlir::MemoryEffects::EffectInstance> effects;
+        memoryEffectOpInterface.getEffects(effects);
+        // Results of operations writing the object may depend on its contents as well.
+        if (llvm::any_of(effects,
+                         [&](const mlir::MemoryEffects::EffectInstance& effect)
+                         {
+                             if (effect.getValue() && effect.getValue() != object)
+                             {
+                                 return false;
+                             }
+                             return llvm::isa<mlir::MemoryEffects::Read>(effect.getEffect())
+                                    || (llvm::isa<mlir::MemoryEffects::Write>(effect.getEffect())
+                                        && !user->use_empty());
+                         }))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DeadStoreEliminationPass::runOnOperation()
+{
+    auto& memorySSA = getAnalysisManager().getAnalysis<pylir::MemorySSA>();
+    auto& aliasAnalysis = getAnalysisManager().getAnalysis<mlir::AliasAnalysis>();
+
+    llvm::SetVector<mlir::Operation*> deadStores;
+    memorySSA.getMemoryRegion().walk(
+        [&](pylir::MemSSA::MemoryDefOp def)
+        {
+            auto store = mlir::dyn_cast<pylir::StoreInterface>(def.getInstruction());
+            if (!store || !store.isPureStore())
+            {
+                return;
+            }
+            if (isOverwritten(def, store, aliasAnalysis))
+            {
+                deadStores.insert(store);
+                return;
+            }
+            auto location = store.getStoredLocation();
+            if (location && isWriteOnlyAllocation(location))
+            {
+                deadStores.insert(store);
+            }
+        });
+
+    if (deadStores.empty())
+    {
+        markAllAnalysesPreserved();
+        return;
+    }
+    for (auto* iter : deadStores)
+    {
+        memorySSA.removeAccess(iter);
+        iter->erase();
+        m_storesRemoved++;
+    }
+    markAnalysesPreserved<mlir::DominanceInfo, pylir::MemorySSA>();
+}
+
+} // namespace
+
+std::unique_ptr<mlir::Pass> pylir::createDeadStoreEliminationPass()
+{
+    return std::make_unique<DeadStoreEliminationPass>();
+}
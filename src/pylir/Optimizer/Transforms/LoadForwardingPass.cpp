@@ -93,8 +93,8 @@ void LoadForwardingPass::runOnOperation()
             }
             if (mlir::isOpTriviallyDead(memoryFold))
             {
+                memorySSA.removeAccess(memoryFold);
                 memoryFold->erase();
-                use.erase();
             }
         });
 
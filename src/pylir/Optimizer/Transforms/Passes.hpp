@@ -15,6 +15,8 @@ namespace pylir
 {
 std::unique_ptr<mlir::Pass> createLoadForwardingPass();
 
+std::unique_ptr<mlir::Pass> createDeadStoreEliminationPass();
+
 #define GEN_PASS_REGISTRATION
 #include "pylir/Optimizer/Transforms/Passes.h.inc"
 
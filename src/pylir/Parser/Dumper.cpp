@@ -28,7 +28,8 @@ std::vector<std::string_view> splitLines(std::string_view text)
     return result;
 }
 
-std::string dumpVariables(const pylir::IdentifierSet& tokens)
+template <class Set>
+std::string dumpVariables(const Set& tokens)
 {
     std::vector<std::string> variables(tokens.size());
     std::transform(tokens.begin(), tokens.end(), variables.begin(),
@@ -119,13 +120,17 @@ std::string pylir::Dumper::dump(const pylir::Syntax::Atom& atom)
 {
     switch (atom.token.getTokenType())
     {
-        case TokenType::Identifier: return fmt::format("atom {}", pylir::get<std::string>(atom.token.getValue()));
+        case TokenType::Identifier: return fmt::format("atom {}", m_tokenValues->getString(atom.token));
         case TokenType::NoneKeyword: return "atom None";
         case TokenType::TrueKeyword: return "atom True";
         case TokenType::FalseKeyword: return "atom False";
         default:
+            if (auto integer = atom.token.getInlineInteger())
+            {
+                return fmt::format("atom {}", *integer);
+            }
             return pylir::match(
-                atom.token.getValue(),
+                (*m_tokenValues)[*atom.token.getValueIndex()],
                 [](double value) -> std::string { return fmt::format(FMT_STRING("atom {:#}"), value); },
                 [](const BigInt& bigInt) -> std::string { return fmt::format("atom {}", bigInt.toString()); },
                 [&](const std::string& string) -> std::string
@@ -183,8 +188,7 @@ std::string pylir::Dumper::dump(const pylir::Syntax::Atom& atom)
                         }
                     }
                     return fmt::format("atom b'{}'", result);
-                },
-                [&](std::monostate) -> std::string { PYLIR_UNREACHABLE; });
+                });
     }
 }
 
@@ -257,7 +261,7 @@ std::string pylir::Dumper::dump(const pylir::Syntax::Call& call)
     builder.add(*call.expression, "callable");
     return pylir::match(
         call.variant,
-        [&](const std::vector<Syntax::Argument>& argument)
+        [&](const Syntax::ArenaVector<Syntax::Argument>& argument)
         {
             for (const auto& iter : argument)
             {
@@ -493,12 +497,13 @@ std::string pylir::Dumper::dump(const pylir::Syntax::AssignmentStmt& assignmentS
 
 std::string pylir::Dumper::dump(const pylir::Syntax::FileInput& fileInput)
 {
+    m_tokenValues = fileInput.tokenValues.get();
     auto builder = createBuilder("file input");
     if (!fileInput.globals.empty())
     {
         builder.add(dumpVariables(fileInput.globals), "globals");
     }
-    for (const auto& iter : fileInput.input.statements)
+    for (const auto& iter : fileInput.input->statements)
     {
         pylir::match(iter, [&](const auto& ptr) { builder.add(*ptr); });
     }
@@ -719,7 +724,7 @@ std::string pylir::Dumper::dump(const Syntax::ListDisplay& listDisplay)
     auto builder = createBuilder("list display");
     pylir::match(
         listDisplay.variant, [&](const Syntax::Comprehension& comprehension) { builder.add(comprehension); },
-        [&](const std::vector<Syntax::StarredItem>& items)
+        [&](const Syntax::ArenaVector<Syntax::StarredItem>& items)
         {
             for (const auto& iter : items)
             {
@@ -734,7 +739,7 @@ std::string pylir::Dumper::dump(const Syntax::SetDisplay& setDisplay)
     auto builder = createBuilder("set display");
     pylir::match(
         setDisplay.variant, [&](const Syntax::Comprehension& comprehension) { builder.add(comprehension); },
-        [&](const std::vector<Syntax::StarredItem>& items)
+        [&](const Syntax::ArenaVector<Syntax::StarredItem>& items)
         {
             for (const auto& iter : items)
             {
@@ -765,7 +770,7 @@ std::string pylir::Dumper::dump(const Syntax::DictDisplay& dictDisplay)
             builder.add(*comprehension.second, "value");
             builder.add(comprehension.compFor);
         },
-        [&](const std::vector<Syntax::DictDisplay::KeyDatum>& items)
+        [&](const Syntax::ArenaVector<Syntax::DictDisplay::KeyDatum>& items)
         {
             for (const auto& iter : items)
             {
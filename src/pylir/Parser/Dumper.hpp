@@ -19,6 +19,9 @@ namespace pylir
 
 class Dumper
 {
+    /// Values of the tokens of the file input currently being dumped.
+    const TokenValueStorage* m_tokenValues = nullptr;
+
     template <class T, class U = Dumper, class = void>
     struct CanDump : std::false_type
     {
@@ -96,7 +96,7 @@ bool pylir::Parser::firstInCompoundStmt(TokenType tokenType)
 void pylir::Parser::addToNamespace(const pylir::Token& token)
 {
     PYLIR_ASSERT(token.getTokenType() == TokenType::Identifier);
-    auto identifierToken = IdentifierToken{token};
+    auto identifierToken = toIdentifier(token);
     addToNamespace(identifierToken);
 }
 
@@ -119,6 +119,7 @@ void pylir::Parser::addToNamespace(const Syntax::Target& target)
     class TargetVisitor : public Syntax::Visitor<TargetVisitor>
     {
     public:
+        const TokenValueStorage* tokenValues;
         std::function<void(const pylir::IdentifierToken&)> callback;
 
         using Visitor::visit;
@@ -127,11 +128,12 @@ void pylir::Parser::addToNamespace(const Syntax::Target& target)
         {
             if (atom.token.getTokenType() == TokenType::Identifier)
             {
-                callback(IdentifierToken(atom.token));
+                callback(IdentifierToken(atom.token, *tokenValues));
             }
             Visitor::visit(atom);
         }
     } visitor{{},
+              m_lexer.getTokenValues().get(),
               [&](const IdentifierToken& token)
               { addToNamespace(token); }};
     visitor.visit(target);
@@ -148,7 +150,7 @@ tl::expected<pylir::Token, std::string> pylir::Parser::expect(pylir::TokenType t
     }
     if (m_current->getTokenType() == TokenType::SyntaxError)
     {
-        return tl::unexpected{pylir::get<std::string>(m_current->getValue())};
+        return tl::unexpected{m_lexer.getTokenValues()->getString(*m_current)};
     }
     if (m_current->getTokenType() != tokenType)
     {
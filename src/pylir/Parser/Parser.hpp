@@ -22,6 +22,7 @@ namespace pylir
 {
 class Parser
 {
+    std::shared_ptr<llvm::BumpPtrAllocator> m_allocator = std::make_shared<llvm::BumpPtrAllocator>();
     Lexer m_lexer;
     Lexer::iterator m_current;
 
@@ -153,21 +154,61 @@ class Parser
 
     [[nodiscard]] tl::expected<Token, std::string> expect(TokenType tokenType);
 
+    /// Creates an 'IdentifierToken' from 'token', whose name is stored within the 'TokenValueStorage' of the lexer.
+    [[nodiscard]] IdentifierToken toIdentifier(const Token& token) const
+    {
+        PYLIR_ASSERT(token.getTokenType() == TokenType::Identifier);
+        return IdentifierToken(token, *m_lexer.getTokenValues());
+    }
+
     void addToNamespace(const Token& token);
 
     void addToNamespace(const IdentifierToken& token);
 
     void addToNamespace(const Syntax::Target& target);
 
+    /// Moves the elements of 'vector' into an array allocated within 'm_allocator'. Containers of the syntax tree must
+    /// not own memory outside of 'm_allocator', while the parser itself builds them up in regular vectors.
+    template <class T>
+    Syntax::ArenaVector<T> toArena(std::vector<T>&& vector)
+    {
+        Syntax::ArenaVector<T> result{Syntax::ArenaAllocator<T>(*m_allocator)};
+        result.reserve(vector.size());
+        std::move(vector.begin(), vector.end(), std::back_inserter(result));
+        return result;
+    }
+
+    /// Copies 'set' into a set allocated within 'm_allocator'.
+    Syntax::ArenaIdentifierSet toArena(IdentifierSet&& set)
+    {
+        return Syntax::ArenaIdentifierSet(set.begin(), set.end(), set.size(), IdentifierHash{}, IdentifierEquals{},
+                                          Syntax::ArenaAllocator<IdentifierToken>(*m_allocator));
+    }
+
+    template <class T>
+    T&& toArena(T&& value)
+    {
+        return std::forward<T>(value);
+    }
+
+    /// Allocates a new expression or statement within 'm_allocator'. If the only argument is already of type 'T' it is
+    /// move constructed instead. Vectors and identifier sets passed as arguments are moved into 'm_allocator' as well.
     template <class T, class... Args>
-    static std::unique_ptr<T> make_node(Args&&... args)
+    std::unique_ptr<T> make_node(Args&&... args)
     {
-        return std::unique_ptr<T>(new T{{}, std::forward<Args>(args)...});
+        if constexpr (sizeof...(Args) == 1 && (std::is_same_v<T, std::decay_t<Args>> && ...))
+        {
+            return std::unique_ptr<T>(new (*m_allocator) T(std::forward<Args>(args)...));
+        }
+        else
+        {
+            return std::unique_ptr<T>(new (*m_allocator) T{{}, toArena(std::forward<Args>(args))...});
+        }
     }
 
-    tl::expected<IdentifierSet, std::string> finishNamespace(pylir::Syntax::Suite& suite,
-                                                             const IdentifierSet& nonLocals,
-                                                             std::vector<const pylir::IdentifierSet*> scopes = {});
+    tl::expected<IdentifierSet, std::string>
+        finishNamespace(pylir::Syntax::Suite& suite, const IdentifierSet& nonLocals,
+                        std::vector<const Syntax::ArenaIdentifierSet*> scopes = {});
 
     bool lookaheadEquals(tcb::span<const TokenType> tokens);
 
@@ -265,10 +306,13 @@ class Parser
     static bool firstInCompoundStmt(TokenType tokenType);
 
 public:
+    /// Creates a new parser for 'document'. 'threadPool' is forwarded to the lexer and if non-null used to lex the
+    /// document in parallel.
     explicit Parser(
         const Diag::Document& document, int fileId = 0,
-        std::function<void(Diag::DiagnosticsBuilder&& diagnosticsBuilder)> callBack = [](auto&&) {})
-        : m_lexer(document, fileId, std::move(callBack)),
+        std::function<void(Diag::DiagnosticsBuilder&& diagnosticsBuilder)> callBack = [](auto&&) {},
+        llvm::ThreadPool* threadPool = nullptr)
+        : m_lexer(document, fileId, std::move(callBack), threadPool),
           m_current(m_lexer.begin()),
 #define HANDLE_FEATURE(x)
 #define HANDLE_REQUIRED_FEATURE(x) m_##x{true},
@@ -628,7 +672,7 @@ public:
     /**
      * statement ::=  stmt_list NEWLINE | compound_stmt
      */
-    tl::expected<decltype(Syntax::Suite::statements), std::string> parseStatement();
+    tl::expected<std::vector<decltype(Syntax::Suite::statements)::value_type>, std::string> parseStatement();
 
     /**
      * suite ::=  stmt_list NEWLINE | NEWLINE INDENT statement { statement } DEDENT
@@ -16,7 +16,7 @@
 
 tl::expected<pylir::Syntax::FileInput, std::string> pylir::Parser::parseFileInput()
 {
-    decltype(Syntax::Suite::statements) vector;
+    std::vector<decltype(Syntax::Suite::statements)::value_type> vector;
     while (true)
     {
         while (maybeConsume(TokenType::Newline))
@@ -33,12 +33,15 @@ tl::expected<pylir::Syntax::FileInput, std::string> pylir::Parser::parseFileInpu
         }
         vector.insert(vector.end(), std::move_iterator(statement->begin()), std::move_iterator(statement->end()));
     }
-    return Syntax::FileInput{{std::move(vector)}, {m_globals.begin(), m_globals.end()}};
+    return Syntax::FileInput{m_allocator, m_lexer.getTokenValues(),
+                             new (*m_allocator) Syntax::Suite{{}, toArena(std::move(vector))},
+                             {m_globals.begin(), m_globals.end()}};
 }
 
-tl::expected<decltype(pylir::Syntax::Suite::statements), std::string> pylir::Parser::parseStatement()
+tl::expected<std::vector<decltype(pylir::Syntax::Suite::statements)::value_type>, std::string>
+    pylir::Parser::parseStatement()
 {
-    decltype(pylir::Syntax::Suite::statements) result;
+    std::vector<decltype(pylir::Syntax::Suite::statements)::value_type> result;
     if (peekedIs(firstInCompoundStmt))
     {
         auto compound = parseCompoundStmt();
@@ -107,7 +110,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
             {
                 return tl::unexpected{std::move(ifStmt).error()};
             }
-            return std::make_unique<Syntax::IfStmt>(std::move(*ifStmt));
+            return make_node<Syntax::IfStmt>(std::move(*ifStmt));
         }
         case TokenType::ForKeyword:
         {
@@ -116,7 +119,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
             {
                 return tl::unexpected{std::move(forStmt).error()};
             }
-            return std::make_unique<Syntax::ForStmt>(std::move(*forStmt));
+            return make_node<Syntax::ForStmt>(std::move(*forStmt));
         }
         case TokenType::TryKeyword:
         {
@@ -125,7 +128,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
             {
                 return tl::unexpected{std::move(tryStmt).error()};
             }
-            return std::make_unique<Syntax::TryStmt>(std::move(*tryStmt));
+            return make_node<Syntax::TryStmt>(std::move(*tryStmt));
         }
         case TokenType::WithKeyword:
         {
@@ -134,7 +137,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
             {
                 return tl::unexpected{std::move(withStmt).error()};
             }
-            return std::make_unique<Syntax::WithStmt>(std::move(*withStmt));
+            return make_node<Syntax::WithStmt>(std::move(*withStmt));
         }
         case TokenType::WhileKeyword:
         {
@@ -143,7 +146,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
             {
                 return tl::unexpected{std::move(whileStmt).error()};
             }
-            return std::make_unique<Syntax::WhileStmt>(std::move(*whileStmt));
+            return make_node<Syntax::WhileStmt>(std::move(*whileStmt));
         }
         case TokenType::DefKeyword:
         {
@@ -152,7 +155,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
             {
                 return tl::unexpected{std::move(funcDef).error()};
             }
-            return std::make_unique<Syntax::FuncDef>(std::move(*funcDef));
+            return make_node<Syntax::FuncDef>(std::move(*funcDef));
         }
         case TokenType::ClassKeyword:
         {
@@ -161,7 +164,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
             {
                 return tl::unexpected{std::move(classDef).error()};
             }
-            return std::make_unique<Syntax::ClassDef>(std::move(*classDef));
+            return make_node<Syntax::ClassDef>(std::move(*classDef));
         }
         case TokenType::AtSign:
         {
@@ -188,7 +191,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
                 {
                     return tl::unexpected{std::move(func).error()};
                 }
-                return std::make_unique<Syntax::FuncDef>(std::move(*func));
+                return make_node<Syntax::FuncDef>(std::move(*func));
             }
             if (m_current == m_lexer.end())
             {
@@ -206,7 +209,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
                     {
                         return tl::unexpected{std::move(func).error()};
                     }
-                    return std::make_unique<Syntax::FuncDef>(std::move(*func));
+                    return make_node<Syntax::FuncDef>(std::move(*func));
                 }
                 case TokenType::ClassKeyword:
                 {
@@ -215,9 +218,9 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
                     {
                         return tl::unexpected{std::move(clazz).error()};
                     }
-                    return std::make_unique<Syntax::ClassDef>(std::move(*clazz));
+                    return make_node<Syntax::ClassDef>(std::move(*clazz));
                 }
-                case TokenType::SyntaxError: return tl::unexpected{pylir::get<std::string>(m_current->getValue())};
+                case TokenType::SyntaxError: return tl::unexpected{m_lexer.getTokenValues()->getString(*m_current)};
                 default:
                 {
                     return tl::unexpected{createDiagnosticsBuilder(*m_current, Diag::EXPECTED_N_INSTEAD_OF_N,
@@ -246,7 +249,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
                     {
                         return tl::unexpected{std::move(func).error()};
                     }
-                    return std::make_unique<Syntax::FuncDef>(std::move(*func));
+                    return make_node<Syntax::FuncDef>(std::move(*func));
                 }
                 case TokenType::ForKeyword:
                 {
@@ -256,7 +259,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
                         return tl::unexpected{std::move(forStmt).error()};
                     }
                     forStmt->maybeAsyncKeyword = async;
-                    return std::make_unique<Syntax::ForStmt>(std::move(*forStmt));
+                    return make_node<Syntax::ForStmt>(std::move(*forStmt));
                 }
                 case TokenType::WithKeyword:
                 {
@@ -266,9 +269,9 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
                         return tl::unexpected{std::move(withStmt).error()};
                     }
                     withStmt->maybeAsyncKeyword = async;
-                    return std::make_unique<Syntax::WithStmt>(std::move(*withStmt));
+                    return make_node<Syntax::WithStmt>(std::move(*withStmt));
                 }
-                case TokenType::SyntaxError: return tl::unexpected{pylir::get<std::string>(m_current->getValue())};
+                case TokenType::SyntaxError: return tl::unexpected{m_lexer.getTokenValues()->getString(*m_current)};
                 default:
                 {
                     return tl::unexpected{createDiagnosticsBuilder(*m_current, Diag::EXPECTED_N_INSTEAD_OF_N,
@@ -279,7 +282,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::CompoundStmt>, std::string> pylir:
                 }
             }
         }
-        case TokenType::SyntaxError: return tl::unexpected{pylir::get<std::string>(m_current->getValue())};
+        case TokenType::SyntaxError: return tl::unexpected{m_lexer.getTokenValues()->getString(*m_current)};
         default:
         {
             return tl::unexpected{createDiagnosticsBuilder(*m_current, Diag::EXPECTED_N_INSTEAD_OF_N, "statement",
@@ -303,7 +306,7 @@ tl::expected<pylir::Syntax::IfStmt::Else, std::string> pylir::Parser::parseElse(
     {
         return tl::unexpected{std::move(elseSuite).error()};
     }
-    return Syntax::IfStmt::Else{elseKeyowrd, *elseColon, std::make_unique<Syntax::Suite>(std::move(*elseSuite))};
+    return Syntax::IfStmt::Else{elseKeyowrd, *elseColon, make_node<Syntax::Suite>(std::move(*elseSuite))};
 }
 
 tl::expected<pylir::Syntax::IfStmt, std::string> pylir::Parser::parseIfStmt()
@@ -347,7 +350,7 @@ tl::expected<pylir::Syntax::IfStmt, std::string> pylir::Parser::parseIfStmt()
             return tl::unexpected{std::move(elIfSuite).error()};
         }
         elifs.push_back(
-            {*elif, std::move(*condition), *elifColon, std::make_unique<Syntax::Suite>(std::move(*elIfSuite))});
+            {*elif, std::move(*condition), *elifColon, make_node<Syntax::Suite>(std::move(*elIfSuite))});
     }
     std::optional<Syntax::IfStmt::Else> elseSection;
     if (peekedIs(TokenType::ElseKeyword))
@@ -363,8 +366,8 @@ tl::expected<pylir::Syntax::IfStmt, std::string> pylir::Parser::parseIfStmt()
                           *ifKeyword,
                           std::move(*assignment),
                           *colon,
-                          std::make_unique<Syntax::Suite>(std::move(*suite)),
-                          std::move(elifs),
+                          make_node<Syntax::Suite>(std::move(*suite)),
+                          toArena(std::move(elifs)),
                           std::move(elseSection)};
 }
 
@@ -407,7 +410,7 @@ tl::expected<pylir::Syntax::WhileStmt, std::string> pylir::Parser::parseWhileStm
                              *whileKeyword,
                              std::move(*condition),
                              *colon,
-                             std::make_unique<Syntax::Suite>(std::move(*suite)),
+                             make_node<Syntax::Suite>(std::move(*suite)),
                              std::move(elseSection)};
 }
 
@@ -464,7 +467,7 @@ tl::expected<pylir::Syntax::ForStmt, std::string> pylir::Parser::parseForStmt()
                            *inKeyword,
                            std::move(*expressionList),
                            *colon,
-                           std::make_unique<Syntax::Suite>(std::move(*suite)),
+                           make_node<Syntax::Suite>(std::move(*suite)),
                            std::move(elseSection)};
 }
 
@@ -500,12 +503,12 @@ tl::expected<pylir::Syntax::TryStmt, std::string> pylir::Parser::parseTryStmt()
         return Syntax::TryStmt{{},
                                *tryKeyword,
                                *colon,
-                               std::make_unique<Syntax::Suite>(std::move(*suite)),
-                               {},
+                               make_node<Syntax::Suite>(std::move(*suite)),
+                               toArena(std::vector<Syntax::TryStmt::ExceptArgs>{}),
                                std::nullopt,
                                std::nullopt,
                                Syntax::TryStmt::Finally{*finallyKeyword, *finallyColon,
-                                                        std::make_unique<Syntax::Suite>(std::move(*finallySuite))}};
+                                                        make_node<Syntax::Suite>(std::move(*finallySuite))}};
     }
 
     std::optional<Syntax::TryStmt::ExceptAll> catchAll;
@@ -531,7 +534,7 @@ tl::expected<pylir::Syntax::TryStmt, std::string> pylir::Parser::parseTryStmt()
             {
                 return tl::unexpected{std::move(exceptSuite).error()};
             }
-            catchAll = {*exceptKeyword, *exceptColon, std::make_unique<Syntax::Suite>(std::move(*exceptSuite))};
+            catchAll = {*exceptKeyword, *exceptColon, make_node<Syntax::Suite>(std::move(*exceptSuite))};
             continue;
         }
         auto expression = parseExpression();
@@ -548,7 +551,7 @@ tl::expected<pylir::Syntax::TryStmt, std::string> pylir::Parser::parseTryStmt()
                 return tl::unexpected{std::move(id).error()};
             }
             addToNamespace(*id);
-            name.emplace(std::move(*id));
+            name.emplace(toIdentifier(*id));
         }
         auto exceptColon = expect(TokenType::Colon);
         if (!exceptColon)
@@ -561,7 +564,7 @@ tl::expected<pylir::Syntax::TryStmt, std::string> pylir::Parser::parseTryStmt()
             return tl::unexpected{std::move(exceptSuite).error()};
         }
         exceptSections.push_back({*exceptKeyword, std::move(*expression), std::move(name), *exceptColon,
-                                  std::make_unique<Syntax::Suite>(std::move(*exceptSuite))});
+                                  make_node<Syntax::Suite>(std::move(*exceptSuite))});
     } while (peekedIs(TokenType::ExceptKeyword));
 
     std::optional<Syntax::IfStmt::Else> elseSection;
@@ -589,13 +592,13 @@ tl::expected<pylir::Syntax::TryStmt, std::string> pylir::Parser::parseTryStmt()
             return tl::unexpected{std::move(finallySuite).error()};
         }
         finally = Syntax::TryStmt::Finally{*finallyKeyword, *finallyColon,
-                                           std::make_unique<Syntax::Suite>(std::move(*finallySuite))};
+                                           make_node<Syntax::Suite>(std::move(*finallySuite))};
     }
     return Syntax::TryStmt{{},
                            *tryKeyword,
                            *colon,
-                           std::make_unique<Syntax::Suite>(std::move(*suite)),
-                           std::move(exceptSections),
+                           make_node<Syntax::Suite>(std::move(*suite)),
+                           toArena(std::move(exceptSections)),
                            std::move(catchAll),
                            std::move(elseSection),
                            std::move(finally)};
@@ -640,20 +643,23 @@ tl::expected<pylir::Syntax::WithStmt, std::string> pylir::Parser::parseWithStmt(
     {
         return tl::unexpected{std::move(suite).error()};
     }
-    return Syntax::WithStmt{{},           std::nullopt,
-                            *withKeyword, std::move(withItems),
-                            *colon,       std::make_unique<Syntax::Suite>(std::move(*suite))};
+    return Syntax::WithStmt{{},
+                            std::nullopt,
+                            *withKeyword,
+                            toArena(std::move(withItems)),
+                            *colon,
+                            make_node<Syntax::Suite>(std::move(*suite))};
 }
 
 tl::expected<pylir::Syntax::Suite, std::string> pylir::Parser::parseSuite()
 {
-    decltype(Syntax::Suite::statements) statements;
+    std::vector<decltype(Syntax::Suite::statements)::value_type> statements;
     if (maybeConsume(TokenType::Newline))
     {
         if (!maybeConsume(TokenType::Indent))
         {
             // stmt_list was empty, and hence a newline immediately followed with no indent after.
-            return Syntax::Suite{};
+            return Syntax::Suite{{}, toArena(std::move(statements))};
         }
 
         do
@@ -671,7 +677,7 @@ tl::expected<pylir::Syntax::Suite, std::string> pylir::Parser::parseSuite()
         {
             return tl::unexpected{std::move(dedent).error()};
         }
-        return Syntax::Suite{std::move(statements)};
+        return Syntax::Suite{{}, toArena(std::move(statements))};
     }
 
     auto statementList = parseStmtList();
@@ -686,7 +692,7 @@ tl::expected<pylir::Syntax::Suite, std::string> pylir::Parser::parseSuite()
     }
     statements.insert(statements.end(), std::move_iterator(statementList->begin()),
                       std::move_iterator(statementList->end()));
-    return Syntax::Suite{std::move(statements)};
+    return Syntax::Suite{{}, toArena(std::move(statements))};
 }
 
 tl::expected<std::vector<pylir::Syntax::Parameter>, std::string> pylir::Parser::parseParameterList()
@@ -789,7 +795,7 @@ tl::expected<std::vector<pylir::Syntax::Parameter>, std::string> pylir::Parser::
             return tl::unexpected{
                 createDiagnosticsBuilder(
                     *identifier, Diag::NO_DEFAULT_ARGUMENT_FOR_PARAMETER_N_FOLLOWING_PARAMETERS_WITH_DEFAULT_ARGUMENTS,
-                    pylir::get<std::string>(identifier->getValue()))
+                    m_lexer.getTokenValues()->getString(*identifier))
                     .addLabel(*identifier, std::nullopt, Diag::ERROR_COLOUR)
                     .addNote(parameters[*seenDefaultParam], Diag::PARAMETER_N_WITH_DEFAULT_ARGUMENT_HERE,
                              parameters[*seenDefaultParam].name.getValue())
@@ -804,7 +810,7 @@ tl::expected<std::vector<pylir::Syntax::Parameter>, std::string> pylir::Parser::
         {
             return tl::unexpected{
                 createDiagnosticsBuilder(*identifier, Diag::NO_MORE_PARAMETERS_ALLOWED_AFTER_EXCESS_KEYWORD_PARAMETER_N,
-                                         pylir::get<std::string>(identifier->getValue()),
+                                         m_lexer.getTokenValues()->getString(*identifier),
                                          parameters[*seenKwRest].name.getValue())
                     .addLabel(*identifier, std::nullopt, Diag::ERROR_COLOUR)
                     .addNote(parameters[*seenKwRest], Diag::EXCESS_KEYWORD_PARAMETER_N_HERE,
@@ -815,7 +821,7 @@ tl::expected<std::vector<pylir::Syntax::Parameter>, std::string> pylir::Parser::
 
         if (!stars)
         {
-            parameters.push_back({currentKind, stars, IdentifierToken(std::move(*identifier)), std::move(maybeType),
+            parameters.push_back({currentKind, stars, toIdentifier(*identifier), std::move(maybeType),
                                   std::move(maybeDefault)});
             continue;
         }
@@ -842,14 +848,14 @@ tl::expected<std::vector<pylir::Syntax::Parameter>, std::string> pylir::Parser::
             }
 
             seenPosRest = parameters.size();
-            parameters.push_back({Syntax::Parameter::PosRest, stars, IdentifierToken(std::move(*identifier)),
-                                  std::move(maybeType), std::move(maybeDefault)});
+            parameters.push_back({Syntax::Parameter::PosRest, stars, toIdentifier(*identifier), std::move(maybeType),
+                                  std::move(maybeDefault)});
             continue;
         }
 
         seenKwRest = parameters.size();
-        parameters.push_back({Syntax::Parameter::KeywordRest, stars, IdentifierToken(std::move(*identifier)),
-                              std::move(maybeType), std::move(maybeDefault)});
+        parameters.push_back({Syntax::Parameter::KeywordRest, stars, toIdentifier(*identifier), std::move(maybeType),
+                              std::move(maybeDefault)});
     }
     return parameters;
 }
@@ -869,7 +875,7 @@ class NamespaceVisitor : public pylir::Syntax::Visitor<NamespaceVisitor>
         for (auto& iter : def.nonLocalVariables)
         {
             if (std::none_of(scopes.begin(), scopes.end(),
-                             [&](const pylir::IdentifierSet* set) -> bool { return set->count(iter); }))
+                             [&](const pylir::Syntax::ArenaIdentifierSet* set) -> bool { return set->count(iter); }))
             {
                 error = onError(iter);
                 break;
@@ -879,7 +885,7 @@ class NamespaceVisitor : public pylir::Syntax::Visitor<NamespaceVisitor>
         for (auto& iter : def.unknown)
         {
             if (std::any_of(scopes.begin(), scopes.end(),
-                            [&](const pylir::IdentifierSet* set) -> bool { return set->count(iter); })
+                            [&](const pylir::Syntax::ArenaIdentifierSet* set) -> bool { return set->count(iter); })
                 || globals.count(iter))
             {
                 def.nonLocalVariables.insert(iter);
@@ -915,7 +921,7 @@ class NamespaceVisitor : public pylir::Syntax::Visitor<NamespaceVisitor>
         }
     }
 
-    std::vector<const pylir::IdentifierSet*> scopes;
+    std::vector<const pylir::Syntax::ArenaIdentifierSet*> scopes;
     std::function<std::string(const pylir::IdentifierToken&)> onError;
     std::variant<std::monostate, pylir::Syntax::FuncDef*, pylir::Syntax::ClassDef*> parentDef;
     const pylir::IdentifierSet& globals;
@@ -924,7 +930,7 @@ public:
     pylir::IdentifierSet closures;
     std::optional<std::string> error;
 
-    NamespaceVisitor(std::vector<const pylir::IdentifierSet*>&& scopes,
+    NamespaceVisitor(std::vector<const pylir::Syntax::ArenaIdentifierSet*>&& scopes,
                      std::function<std::string(const pylir::IdentifierToken&)>&& onError,
                      const pylir::IdentifierSet& globals)
         : scopes(std::move(scopes)), onError(std::move(onError)), globals(globals)
@@ -965,7 +971,7 @@ public:
 
 tl::expected<pylir::IdentifierSet, std::string>
     pylir::Parser::finishNamespace(pylir::Syntax::Suite& suite, const IdentifierSet& nonLocals,
-                                   std::vector<const pylir::IdentifierSet*> scopes)
+                                   std::vector<const Syntax::ArenaIdentifierSet*> scopes)
 {
     if (auto first = nonLocals.begin(); first != nonLocals.end())
     {
@@ -1054,7 +1060,8 @@ tl::expected<pylir::Syntax::FuncDef, std::string>
     m_inLoop = false;
     m_inFunc = true;
     auto suite = parseSuite();
-    IdentifierSet locals;
+    // Allocated within the arena right away, as it may already be used as outer scope by 'finishNamespace'.
+    Syntax::ArenaIdentifierSet locals{Syntax::ArenaAllocator<IdentifierToken>(*m_allocator)};
     IdentifierSet nonLocals;
     IdentifierSet closures;
     IdentifierSet unknowns;
@@ -1098,20 +1105,20 @@ tl::expected<pylir::Syntax::FuncDef, std::string>
     }
 
     return Syntax::FuncDef{{},
-                           std::move(decorators),
+                           toArena(std::move(decorators)),
                            asyncKeyword,
                            *defKeyword,
-                           IdentifierToken{std::move(*funcName)},
+                           toIdentifier(*funcName),
                            *openParenth,
-                           std::move(parameterList),
+                           toArena(std::move(parameterList)),
                            *closeParenth,
                            std::move(suffix),
                            *colon,
-                           std::make_unique<Syntax::Suite>(std::move(*suite)),
+                           make_node<Syntax::Suite>(std::move(*suite)),
                            std::move(locals),
-                           std::move(nonLocals),
-                           std::move(closures),
-                           std::move(unknowns)};
+                           toArena(std::move(nonLocals)),
+                           toArena(std::move(closures)),
+                           toArena(std::move(unknowns))};
 }
 
 tl::expected<pylir::Syntax::ClassDef, std::string>
@@ -1146,7 +1153,7 @@ tl::expected<pylir::Syntax::ClassDef, std::string>
         {
             return tl::unexpected{std::move(close).error()};
         }
-        inheritance = Syntax::ClassDef::Inheritance{*open, std::move(argumentList), *close};
+        inheritance = Syntax::ClassDef::Inheritance{*open, toArena(std::move(argumentList)), *close};
     }
     auto colon = expect(TokenType::Colon);
     if (!colon)
@@ -1191,13 +1198,13 @@ tl::expected<pylir::Syntax::ClassDef, std::string>
         }
     }
     return Syntax::ClassDef{{},
-                            std::move(decorators),
+                            toArena(std::move(decorators)),
                             *classKeyword,
-                            IdentifierToken{std::move(*className)},
+                            toIdentifier(*className),
                             std::move(inheritance),
                             *colon,
-                            std::make_unique<Syntax::Suite>(std::move(*suite)),
-                            std::move(locals),
-                            std::move(nonLocals),
-                            std::move(unknowns)};
+                            make_node<Syntax::Suite>(std::move(*suite)),
+                            toArena(std::move(locals)),
+                            toArena(std::move(nonLocals)),
+                            toArena(std::move(unknowns))};
 }
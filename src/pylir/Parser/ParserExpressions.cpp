@@ -58,7 +58,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string> pylir::P
 
     switch (m_current->getTokenType())
     {
-        case TokenType::SyntaxError: return tl::unexpected{pylir::get<std::string>((*m_current++).getValue())};
+        case TokenType::SyntaxError: return tl::unexpected{m_lexer.getTokenValues()->getString(*m_current++)};
         case TokenType::Identifier:
         {
             auto token = *m_current++;
@@ -66,7 +66,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string> pylir::P
             {
                 // emplace will only insert if it is not already contained. So it will only be marked as unknown
                 // if we didn't know it's kind already
-                m_namespace.back().identifiers.emplace(token, Scope::Kind::Unknown);
+                m_namespace.back().identifiers.emplace(toIdentifier(token), Scope::Kind::Unknown);
             }
             return make_node<Syntax::Atom>(token);
         }
@@ -127,7 +127,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string> pylir::P
                 {
                     return tl::unexpected{std::move(closeParentheses).error()};
                 }
-                return std::make_unique<Syntax::Yield>(std::move(*yield));
+                return make_node<Syntax::Yield>(std::move(*yield));
             }
 
             if (firstInStarredItem(m_current->getTokenType())
@@ -383,7 +383,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string> pylir::P
             return make_node<Syntax::ListDisplay>(std::move(openSquareBracket), std::move(*comprehension),
                                                   std::move(*closeSquare));
         }
-        case TokenType::SyntaxError: return tl::unexpected{pylir::get<std::string>(m_current->getValue())};
+        case TokenType::SyntaxError: return tl::unexpected{m_lexer.getTokenValues()->getString(*m_current)};
         default:
             return tl::unexpected{
                 createDiagnosticsBuilder(*m_current, Diag::EXPECTED_N_INSTEAD_OF_N,
@@ -408,7 +408,7 @@ tl::expected<pylir::Syntax::AttributeRef, std::string>
     {
         return tl::unexpected{std::move(identifier).error()};
     }
-    return Syntax::AttributeRef{{}, std::move(expression), *std::move(dot), IdentifierToken{*std::move(identifier)}};
+    return Syntax::AttributeRef{{}, std::move(expression), *std::move(dot), toIdentifier(*identifier)};
 }
 
 tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string>
@@ -529,7 +529,7 @@ tl::expected<std::vector<pylir::Syntax::Argument>, std::string>
                 if (std::next(m_current) != m_lexer.end()
                     && std::next(m_current)->getTokenType() == TokenType::Assignment)
                 {
-                    keywordName = IdentifierToken{*m_current++};
+                    keywordName = toIdentifier(*m_current++);
                     expansionOrEqual = *m_current++;
                 }
                 break;
@@ -604,7 +604,7 @@ tl::expected<pylir::Syntax::Call, std::string> pylir::Parser::parseCall(IntrVarP
         return Syntax::Call{{},
                             std::move(expression),
                             std::move(*openParenth),
-                            std::vector<Syntax::Argument>{},
+                            toArena(std::vector<Syntax::Argument>{}),
                             std::move(*closeParenth)};
     }
     // If it's a star, power of or an "identifier =", it's definitely an argument list, not a comprehension
@@ -652,8 +652,11 @@ tl::expected<pylir::Syntax::Call, std::string> pylir::Parser::parseCall(IntrVarP
     {
         return tl::unexpected{std::move(closeParenth).error()};
     }
-    return Syntax::Call{
-        {}, std::move(expression), std::move(*openParenth), std::move(*argumentList), std::move(*closeParenth)};
+    return Syntax::Call{{},
+                        std::move(expression),
+                        std::move(*openParenth),
+                        toArena(std::move(*argumentList)),
+                        std::move(*closeParenth)};
 }
 
 tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string> pylir::Parser::parsePrimary()
@@ -680,7 +683,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string> pylir::P
                 {
                     return tl::unexpected{std::move(attributeRef).error()};
                 }
-                current = std::make_unique<Syntax::AttributeRef>(std::move(*attributeRef));
+                current = make_node<Syntax::AttributeRef>(std::move(*attributeRef));
                 break;
             }
             case TokenType::OpenSquareBracket:
@@ -700,7 +703,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string> pylir::P
                 {
                     return tl::unexpected{std::move(call).error()};
                 }
-                current = std::make_unique<Syntax::Call>(std::move(*call));
+                current = make_node<Syntax::Call>(std::move(*call));
                 break;
             }
             default: PYLIR_UNREACHABLE;
@@ -746,7 +749,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string> pylir::P
         return parseExpression();
     }
 
-    IdentifierToken variable{*m_current++};
+    IdentifierToken variable = toIdentifier(*m_current++);
     addToNamespace(variable);
     BaseToken walrus = *m_current++;
     auto expression = parseExpression();
@@ -782,7 +785,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string> pylir::P
         {
             return tl::unexpected{std::move(await).error()};
         }
-        expression = std::make_unique<Syntax::UnaryOp>(std::move(*await));
+        expression = make_node<Syntax::UnaryOp>(std::move(*await));
     }
     else
     {
@@ -1000,7 +1003,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string> pylir::P
     {
         return tl::unexpected{std::move(lambda).error()};
     }
-    return std::make_unique<Syntax::Lambda>(std::move(*lambda));
+    return make_node<Syntax::Lambda>(std::move(*lambda));
 }
 
 tl::expected<pylir::Syntax::Lambda, std::string> pylir::Parser::parseLambdaExpression()
@@ -1030,7 +1033,8 @@ tl::expected<pylir::Syntax::Lambda, std::string> pylir::Parser::parseLambdaExpre
     {
         return tl::unexpected{std::move(expression).error()};
     }
-    return Syntax::Lambda{{}, std::move(*keyword), std::move(parameterList), std::move(*colon), std::move(*expression)};
+    return Syntax::Lambda{{}, std::move(*keyword), toArena(std::move(parameterList)), std::move(*colon),
+                          std::move(*expression)};
 }
 
 tl::expected<pylir::Syntax::Comprehension, std::string>
@@ -1070,8 +1074,13 @@ tl::expected<pylir::Syntax::CompFor, std::string> pylir::Parser::parseCompFor()
     }
     if (!peekedIs({TokenType::ForKeyword, TokenType::IfKeyword, TokenType::AwaitKeyword}))
     {
-        return Syntax::CompFor{std::move(awaitToken), std::move(*forToken), std::move(*targetList),
-                               std::move(*inToken),   std::move(*orTest),   std::monostate{}};
+        return Syntax::CompFor{{},
+                               std::move(awaitToken),
+                               std::move(*forToken),
+                               std::move(*targetList),
+                               std::move(*inToken),
+                               std::move(*orTest),
+                               std::monostate{}};
     }
     std::variant<std::monostate, std::unique_ptr<Syntax::CompFor>, std::unique_ptr<Syntax::CompIf>> trail;
     if (m_current->getTokenType() == TokenType::IfKeyword)
@@ -1081,7 +1090,7 @@ tl::expected<pylir::Syntax::CompFor, std::string> pylir::Parser::parseCompFor()
         {
             return tl::unexpected{std::move(compIf).error()};
         }
-        trail = std::make_unique<Syntax::CompIf>(std::move(*compIf));
+        trail = make_node<Syntax::CompIf>(std::move(*compIf));
     }
     else
     {
@@ -1090,10 +1099,15 @@ tl::expected<pylir::Syntax::CompFor, std::string> pylir::Parser::parseCompFor()
         {
             return tl::unexpected{std::move(compFor).error()};
         }
-        trail = std::make_unique<Syntax::CompFor>(std::move(*compFor));
-    }
-    return Syntax::CompFor{std::move(awaitToken), std::move(*forToken), std::move(*targetList),
-                           std::move(*inToken),   std::move(*orTest),   std::move(trail)};
+        trail = make_node<Syntax::CompFor>(std::move(*compFor));
+    }
+    return Syntax::CompFor{{},
+                           std::move(awaitToken),
+                           std::move(*forToken),
+                           std::move(*targetList),
+                           std::move(*inToken),
+                           std::move(*orTest),
+                           std::move(trail)};
 }
 
 tl::expected<pylir::Syntax::CompIf, std::string> pylir::Parser::parseCompIf()
@@ -1110,7 +1124,7 @@ tl::expected<pylir::Syntax::CompIf, std::string> pylir::Parser::parseCompIf()
     }
     if (!peekedIs({TokenType::ForKeyword, TokenType::IfKeyword, TokenType::AwaitKeyword}))
     {
-        return Syntax::CompIf{std::move(*ifToken), std::move(*orTest), std::monostate{}};
+        return Syntax::CompIf{{}, std::move(*ifToken), std::move(*orTest), std::monostate{}};
     }
     std::variant<std::monostate, std::unique_ptr<Syntax::CompFor>, std::unique_ptr<Syntax::CompIf>> trail;
     if (m_current->getTokenType() == TokenType::IfKeyword)
@@ -1120,7 +1134,7 @@ tl::expected<pylir::Syntax::CompIf, std::string> pylir::Parser::parseCompIf()
         {
             return tl::unexpected{std::move(compIf).error()};
         }
-        trail = std::make_unique<Syntax::CompIf>(std::move(*compIf));
+        trail = make_node<Syntax::CompIf>(std::move(*compIf));
     }
     else
     {
@@ -1129,9 +1143,9 @@ tl::expected<pylir::Syntax::CompIf, std::string> pylir::Parser::parseCompIf()
         {
             return tl::unexpected{std::move(compFor).error()};
         }
-        trail = std::make_unique<Syntax::CompFor>(std::move(*compFor));
+        trail = make_node<Syntax::CompFor>(std::move(*compFor));
     }
-    return Syntax::CompIf{std::move(*ifToken), std::move(*orTest), std::move(trail)};
+    return Syntax::CompIf{{}, std::move(*ifToken), std::move(*orTest), std::move(trail)};
 }
 
 tl::expected<pylir::IntrVarPtr<pylir::Syntax::Expression>, std::string>
@@ -51,7 +51,7 @@ tl::expected<pylir::Syntax::AssignmentStmt, std::string>
     } while (peekedIs(firstInTarget));
     if (leftOverStarredExpression)
     {
-        return Syntax::AssignmentStmt{{}, std::move(targets), nullptr, std::move(leftOverStarredExpression)};
+        return Syntax::AssignmentStmt{{}, toArena(std::move(targets)), nullptr, std::move(leftOverStarredExpression)};
     }
     if (peekedIs(TokenType::YieldKeyword))
     {
@@ -61,7 +61,7 @@ tl::expected<pylir::Syntax::AssignmentStmt, std::string>
             return tl::unexpected{std::move(yieldExpr).error()};
         }
         return Syntax::AssignmentStmt{
-            {}, std::move(targets), nullptr, std::make_unique<Syntax::Yield>(std::move(*yieldExpr))};
+            {}, toArena(std::move(targets)), nullptr, make_node<Syntax::Yield>(std::move(*yieldExpr))};
     }
 
     auto starredExpression = parseStarredExpression();
@@ -69,7 +69,7 @@ tl::expected<pylir::Syntax::AssignmentStmt, std::string>
     {
         return tl::unexpected{std::move(starredExpression).error()};
     }
-    return Syntax::AssignmentStmt{{}, std::move(targets), nullptr, std::move(*starredExpression)};
+    return Syntax::AssignmentStmt{{}, toArena(std::move(targets)), nullptr, std::move(*starredExpression)};
 }
 
 tl::expected<pylir::IntrVarPtr<pylir::Syntax::SimpleStmt>, std::string> pylir::Parser::parseSimpleStmt()
@@ -87,7 +87,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::SimpleStmt>, std::string> pylir::P
             {
                 return tl::unexpected{std::move(assertStmt).error()};
             }
-            return std::make_unique<Syntax::AssertStmt>(std::move(*assertStmt));
+            return make_node<Syntax::AssertStmt>(std::move(*assertStmt));
         }
         case TokenType::PassKeyword: return make_node<Syntax::SingleTokenStmt>(*m_current++);
         case TokenType::BreakKeyword:
@@ -139,7 +139,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::SimpleStmt>, std::string> pylir::P
             {
                 return tl::unexpected{std::move(yieldExpr).error()};
             }
-            return make_node<Syntax::ExpressionStmt>(std::make_unique<Syntax::Yield>(std::move(*yieldExpr)));
+            return make_node<Syntax::ExpressionStmt>(make_node<Syntax::Yield>(std::move(*yieldExpr)));
         }
         case TokenType::RaiseKeyword:
         {
@@ -174,7 +174,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::SimpleStmt>, std::string> pylir::P
                 return tl::unexpected{std::move(identifier).error()};
             }
             std::vector<IdentifierToken> identifiers;
-            identifiers.emplace_back(std::move(*identifier));
+            identifiers.push_back(toIdentifier(*identifier));
             while (maybeConsume(TokenType::Comma))
             {
                 auto another = expect(TokenType::Identifier);
@@ -182,7 +182,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::SimpleStmt>, std::string> pylir::P
                 {
                     return tl::unexpected{std::move(another).error()};
                 }
-                identifiers.emplace_back(std::move(*another));
+                identifiers.push_back(toIdentifier(*another));
             }
             if (keyword.getTokenType() == TokenType::NonlocalKeyword)
             {
@@ -342,9 +342,30 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::SimpleStmt>, std::string> pylir::P
                     }
                 }
             }
-            return std::make_unique<Syntax::ImportStmt>(std::move(*import));
+            else
+            {
+                pylir::match(
+                    import->variant,
+                    [&](const Syntax::ImportStmt::ImportAs& importAs)
+                    {
+                        for (const auto& [module, name] : importAs.modules)
+                        {
+                            addToNamespace(name ? *name : module.identifiers.front());
+                        }
+                    },
+                    [&](const Syntax::ImportStmt::FromImport& fromImport)
+                    {
+                        for (const auto& [imported, name] : fromImport.imports)
+                        {
+                            addToNamespace(name ? *name : imported);
+                        }
+                    },
+                    // The names bound are only known once the module is imported.
+                    [](const Syntax::ImportStmt::ImportAll&) {});
+            }
+            return make_node<Syntax::ImportStmt>(std::move(*import));
         }
-        case TokenType::SyntaxError: return tl::unexpected{pylir::get<std::string>(m_current->getValue())};
+        case TokenType::SyntaxError: return tl::unexpected{m_lexer.getTokenValues()->getString(*m_current)};
         default:
             // Starred expression is a super set of both `target` and `augtarget`.
             auto starredExpression = parseStarredExpression();
@@ -374,7 +395,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::SimpleStmt>, std::string> pylir::P
                     {
                         return tl::unexpected{std::move(assignmentStmt).error()};
                     }
-                    return std::make_unique<Syntax::AssignmentStmt>(std::move(*assignmentStmt));
+                    return make_node<Syntax::AssignmentStmt>(std::move(*assignmentStmt));
                 }
                 case TokenType::PlusAssignment:
                 case TokenType::Colon:
@@ -420,7 +441,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::SimpleStmt>, std::string> pylir::P
                             }
                             return make_node<Syntax::AssignmentStmt>(
                                 std::move(vector), std::move(*expression),
-                                std::make_unique<Syntax::Yield>(std::move(*yield)));
+                                make_node<Syntax::Yield>(std::move(*yield)));
                         }
                         auto starred = parseStarredExpression();
                         if (!starred)
@@ -441,7 +462,7 @@ tl::expected<pylir::IntrVarPtr<pylir::Syntax::SimpleStmt>, std::string> pylir::P
                             return tl::unexpected{std::move(yield).error()};
                         }
                         return make_node<Syntax::AssignmentStmt>(std::move(vector), nullptr,
-                                                                 std::make_unique<Syntax::Yield>(std::move(*yield)));
+                                                                 make_node<Syntax::Yield>(std::move(*yield)));
                     }
                     auto expressionList = parseExpressionList();
                     if (!expressionList)
@@ -576,7 +597,7 @@ struct Visitor
                 .addLabel(assignOp, std::nullopt, Diag::ERROR_COMPLY)
                 .emitError();
         }
-        for (const auto& iter : pylir::get<std::vector<Syntax::StarredItem>>(expression.variant))
+        for (const auto& iter : pylir::get<Syntax::ArenaVector<Syntax::StarredItem>>(expression.variant))
         {
             if (auto error = visit(*iter.expression))
             {
@@ -803,10 +824,10 @@ tl::expected<Syntax::ImportStmt, std::string> pylir::Parser::parseImportStmt()
             {
                 return tl::unexpected{std::move(identifier).error()};
             }
-            identifiers.emplace_back(std::move(*identifier));
+            identifiers.push_back(toIdentifier(*identifier));
             if (!maybeConsume(TokenType::Dot))
             {
-                return Syntax::ImportStmt::Module{std::move(identifiers)};
+                return Syntax::ImportStmt::Module{toArena(std::move(identifiers))};
             }
         } while (true);
     };
@@ -820,14 +841,14 @@ tl::expected<Syntax::ImportStmt, std::string> pylir::Parser::parseImportStmt()
         }
         if (!dots.empty() && !peekedIs(TokenType::Identifier))
         {
-            return Syntax::ImportStmt::RelativeModule{std::move(dots), std::nullopt};
+            return Syntax::ImportStmt::RelativeModule{toArena(std::move(dots)), std::nullopt};
         }
         auto module = parseModule();
         if (!module)
         {
             return tl::unexpected{std::move(module).error()};
         }
-        return Syntax::ImportStmt::RelativeModule{std::move(dots), std::move(*module)};
+        return Syntax::ImportStmt::RelativeModule{toArena(std::move(dots)), std::move(*module)};
     };
     if (m_current == m_lexer.end())
     {
@@ -864,11 +885,12 @@ tl::expected<Syntax::ImportStmt, std::string> pylir::Parser::parseImportStmt()
                     {
                         return tl::unexpected{std::move(identifier).error()};
                     }
-                    nextName.emplace(std::move(*identifier));
+                    nextName = toIdentifier(*identifier);
                 }
                 modules.emplace_back(std::move(*nextModule), std::move(nextName));
             }
-            return Syntax::ImportStmt{{}, Syntax::ImportStmt::ImportAs{std::move(import), std::move(modules)}};
+            return Syntax::ImportStmt{
+                {}, Syntax::ImportStmt::ImportAs{std::move(import), toArena(std::move(modules))}};
         }
         case TokenType::FromKeyword:
         {
@@ -916,9 +938,9 @@ tl::expected<Syntax::ImportStmt, std::string> pylir::Parser::parseImportStmt()
                     {
                         return tl::unexpected{std::move(identifier).error()};
                     }
-                    nextName.emplace(std::move(*identifier));
+                    nextName = toIdentifier(*identifier);
                 }
-                imports.emplace_back(std::move(*imported), std::move(nextName));
+                imports.emplace_back(toIdentifier(*imported), std::move(nextName));
             }
             if (openParenth)
             {
@@ -929,9 +951,9 @@ tl::expected<Syntax::ImportStmt, std::string> pylir::Parser::parseImportStmt()
                 }
             }
             return Syntax::ImportStmt{
-                {}, Syntax::ImportStmt::FromImport{from, std::move(*relative), *import, std::move(imports)}};
+                {}, Syntax::ImportStmt::FromImport{from, std::move(*relative), *import, toArena(std::move(imports))}};
         }
-        case TokenType::SyntaxError: return tl::unexpected{pylir::get<std::string>(m_current->getValue())};
+        case TokenType::SyntaxError: return tl::unexpected{m_lexer.getTokenValues()->getString(*m_current)};
         default:
             return tl::unexpected{
                 createDiagnosticsBuilder(*m_current, Diag::EXPECTED_N_INSTEAD_OF_N,
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/Allocator.h>
 
 #include <pylir/Lexer/Token.hpp>
 #include <pylir/Support/AbstractIntrusiveVariant.hpp>
@@ -14,11 +15,87 @@
 namespace pylir::Syntax
 {
 
+/// Base class of all expressions, statements, suites and comprehension clauses. These are allocated within the
+/// 'llvm::BumpPtrAllocator' of the parser and their memory is only released together with the allocator. Deleting
+/// them therefore merely runs their destructor. Allocating them on the heap is a compile time error.
+///
+/// All containers within these nodes allocate from the same allocator, see 'ArenaAllocator'. Nothing within the syntax
+/// tree of a 'FileInput' therefore owns memory outside of the allocator, which allows releasing the whole tree at once
+/// without running any destructors.
+struct ArenaAllocated
+{
+    static void* operator new(std::size_t size, llvm::BumpPtrAllocator& allocator)
+    {
+        return allocator.Allocate(size, alignof(std::max_align_t));
+    }
+
+    static void* operator new(std::size_t, void* pointer) noexcept
+    {
+        return pointer;
+    }
+
+    static void operator delete(void*, llvm::BumpPtrAllocator&) noexcept {}
+
+    static void operator delete(void*) noexcept {}
+};
+
+/// Standard library allocator allocating from the 'llvm::BumpPtrAllocator' of the parser. Deallocation does nothing,
+/// the memory is only released together with the allocator.
+template <class T>
+class ArenaAllocator
+{
+    llvm::BumpPtrAllocator* m_allocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit ArenaAllocator(llvm::BumpPtrAllocator& allocator) : m_allocator(&allocator) {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : m_allocator(&other.getAllocator())
+    {
+    }
+
+    [[nodiscard]] llvm::BumpPtrAllocator& getAllocator() const
+    {
+        return *m_allocator;
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(m_allocator->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& rhs) const
+    {
+        return m_allocator == &rhs.getAllocator();
+    }
+
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+using ArenaIdentifierSet =
+    std::unordered_set<IdentifierToken, IdentifierHash, IdentifierEquals, ArenaAllocator<IdentifierToken>>;
+
 struct Expression
     : public AbstractIntrusiveVariant<Expression, struct BinOp, struct Atom, struct AttributeRef, struct Subscription,
                                       struct Slice, struct Assignment, struct Conditional, struct Call, struct Lambda,
                                       struct UnaryOp, struct Yield, struct Generator, struct TupleConstruct,
-                                      struct ListDisplay, struct SetDisplay, struct DictDisplay, struct Comparison>
+                                      struct ListDisplay, struct SetDisplay, struct DictDisplay, struct Comparison>,
+      ArenaAllocated
 {
     using AbstractIntrusiveVariant::AbstractIntrusiveVariant;
 };
@@ -49,7 +126,7 @@ struct Comparison : Expression::Base<Comparison>
         Token firstToken;
         std::optional<Token> secondToken;
     };
-    std::vector<std::pair<Operator, IntrVarPtr<Expression>>> rest;
+    ArenaVector<std::pair<Operator, IntrVarPtr<Expression>>> rest;
 };
 
 using Target = Expression;
@@ -103,7 +180,7 @@ struct Argument
 
 struct CompIf;
 
-struct CompFor
+struct CompFor : ArenaAllocated
 {
     std::optional<BaseToken> awaitToken;
     BaseToken forToken;
@@ -113,7 +190,7 @@ struct CompFor
     std::variant<std::monostate, std::unique_ptr<CompFor>, std::unique_ptr<CompIf>> compIter;
 };
 
-struct CompIf
+struct CompIf : ArenaAllocated
 {
     BaseToken ifToken;
     IntrVarPtr<Expression> test;
@@ -130,7 +207,7 @@ struct Call : Expression::Base<Call>
 {
     IntrVarPtr<Expression> expression;
     BaseToken openParenth;
-    std::variant<std::vector<Argument>, Comprehension> variant;
+    std::variant<ArenaVector<Argument>, Comprehension> variant;
     BaseToken closeParenth;
 };
 
@@ -153,7 +230,7 @@ struct Parameter
 struct Lambda : Expression::Base<Lambda>
 {
     BaseToken lambdaKeyword;
-    std::vector<Parameter> parameters;
+    ArenaVector<Parameter> parameters;
     BaseToken colon;
     IntrVarPtr<Expression> expression;
 };
@@ -183,21 +260,21 @@ struct TupleConstruct : Expression::Base<TupleConstruct>
 {
     // This and 'maybeCloseBracket' are guaranteed to be active when 'items' is empty.
     std::optional<BaseToken> maybeOpenBracket;
-    std::vector<StarredItem> items;
+    ArenaVector<StarredItem> items;
     std::optional<BaseToken> maybeCloseBracket;
 };
 
 struct ListDisplay : Expression::Base<ListDisplay>
 {
     BaseToken openSquare;
-    std::variant<std::vector<StarredItem>, Comprehension> variant;
+    std::variant<ArenaVector<StarredItem>, Comprehension> variant;
     BaseToken closeSquare;
 };
 
 struct SetDisplay : Expression::Base<SetDisplay>
 {
     BaseToken openBrace;
-    std::variant<std::vector<StarredItem>, Comprehension> variant;
+    std::variant<ArenaVector<StarredItem>, Comprehension> variant;
     BaseToken closeBrace;
 };
 
@@ -220,14 +297,15 @@ struct DictDisplay : Expression::Base<DictDisplay>
         CompFor compFor;
     };
 
-    std::variant<std::vector<KeyDatum>, DictComprehension> variant;
+    std::variant<ArenaVector<KeyDatum>, DictComprehension> variant;
     BaseToken closeBrace;
 };
 
 struct SimpleStmt
     : AbstractIntrusiveVariant<SimpleStmt, struct ExpressionStmt, struct AssertStmt, struct AssignmentStmt,
                                struct SingleTokenStmt, struct DelStmt, struct ReturnStmt, struct RaiseStmt,
-                               struct ImportStmt, struct GlobalOrNonLocalStmt>
+                               struct ImportStmt, struct GlobalOrNonLocalStmt>,
+      ArenaAllocated
 {
     using AbstractIntrusiveVariant::AbstractIntrusiveVariant;
 };
@@ -246,7 +324,7 @@ struct AssertStmt : SimpleStmt::Base<AssertStmt>
 
 struct AssignmentStmt : SimpleStmt::Base<AssignmentStmt>
 {
-    std::vector<std::pair<IntrVarPtr<Target>, Token>> targets;
+    ArenaVector<std::pair<IntrVarPtr<Target>, Token>> targets;
     IntrVarPtr<Expression> maybeAnnotation;
     IntrVarPtr<Expression> maybeExpression;
 };
@@ -279,19 +357,19 @@ struct ImportStmt : SimpleStmt::Base<ImportStmt>
 {
     struct Module
     {
-        std::vector<IdentifierToken> identifiers;
+        ArenaVector<IdentifierToken> identifiers;
     };
 
     struct RelativeModule
     {
-        std::vector<BaseToken> dots;
+        ArenaVector<BaseToken> dots;
         std::optional<Module> module;
     };
 
     struct ImportAs
     {
         BaseToken import;
-        std::vector<std::pair<Module, std::optional<IdentifierToken>>> modules;
+        ArenaVector<std::pair<Module, std::optional<IdentifierToken>>> modules;
     };
 
     struct FromImport
@@ -299,7 +377,7 @@ struct ImportStmt : SimpleStmt::Base<ImportStmt>
         BaseToken from;
         RelativeModule relativeModule;
         BaseToken import;
-        std::vector<std::pair<IdentifierToken, std::optional<IdentifierToken>>> imports;
+        ArenaVector<std::pair<IdentifierToken, std::optional<IdentifierToken>>> imports;
     };
 
     struct ImportAll
@@ -316,13 +394,14 @@ struct ImportStmt : SimpleStmt::Base<ImportStmt>
 struct GlobalOrNonLocalStmt : SimpleStmt::Base<GlobalOrNonLocalStmt>
 {
     Token token;
-    std::vector<IdentifierToken> identifiers;
+    ArenaVector<IdentifierToken> identifiers;
 };
 
 struct Suite;
 
 struct CompoundStmt : AbstractIntrusiveVariant<CompoundStmt, struct IfStmt, struct WhileStmt, struct ForStmt,
-                                               struct TryStmt, struct WithStmt, struct FuncDef, struct ClassDef>
+                                               struct TryStmt, struct WithStmt, struct FuncDef, struct ClassDef>,
+                      ArenaAllocated
 {
     using AbstractIntrusiveVariant::AbstractIntrusiveVariant;
 };
@@ -340,7 +419,7 @@ struct IfStmt : CompoundStmt::Base<IfStmt>
         BaseToken colon;
         std::unique_ptr<Suite> suite;
     };
-    std::vector<Elif> elifs;
+    ArenaVector<Elif> elifs;
     struct Else
     {
         BaseToken elseKeyowrd;
@@ -384,7 +463,7 @@ struct TryStmt : CompoundStmt::Base<TryStmt>
         BaseToken colon;
         std::unique_ptr<Suite> suite;
     };
-    std::vector<ExceptArgs> excepts;
+    ArenaVector<ExceptArgs> excepts;
     struct ExceptAll
     {
         BaseToken exceptKeyword;
@@ -411,7 +490,7 @@ struct WithStmt : CompoundStmt::Base<WithStmt>
         IntrVarPtr<Expression> expression;
         IntrVarPtr<Target> maybeTarget;
     };
-    std::vector<WithItem> items;
+    ArenaVector<WithItem> items;
     BaseToken colon;
     std::unique_ptr<Suite> suite;
 };
@@ -425,52 +504,67 @@ struct Decorator
 
 struct FuncDef : CompoundStmt::Base<FuncDef>
 {
-    std::vector<Decorator> decorators;
+    ArenaVector<Decorator> decorators;
     std::optional<BaseToken> maybeAsyncKeyword;
     BaseToken def;
     IdentifierToken funcName;
     BaseToken openParenth;
-    std::vector<Parameter> parameterList;
+    ArenaVector<Parameter> parameterList;
     BaseToken closeParenth;
     IntrVarPtr<Expression> maybeSuffix;
     BaseToken colon;
     std::unique_ptr<Suite> suite;
 
-    IdentifierSet localVariables;
-    IdentifierSet nonLocalVariables;
-    IdentifierSet closures;
-    IdentifierSet unknown; // only temporarily used
+    ArenaIdentifierSet localVariables;
+    ArenaIdentifierSet nonLocalVariables;
+    ArenaIdentifierSet closures;
+    ArenaIdentifierSet unknown; // only temporarily used
 };
 
 struct ClassDef : CompoundStmt::Base<ClassDef>
 {
-    std::vector<Decorator> decorators;
+    ArenaVector<Decorator> decorators;
     BaseToken classKeyword;
     IdentifierToken className;
     struct Inheritance
     {
         BaseToken openParenth;
-        std::vector<Argument> argumentList;
+        ArenaVector<Argument> argumentList;
         BaseToken closeParenth;
     };
     std::optional<Inheritance> inheritance;
     BaseToken colon;
     std::unique_ptr<Suite> suite;
 
-    IdentifierSet localVariables;
-    IdentifierSet nonLocalVariables;
-    IdentifierSet unknown; // only temporarily used
+    ArenaIdentifierSet localVariables;
+    ArenaIdentifierSet nonLocalVariables;
+    ArenaIdentifierSet unknown; // only temporarily used
 };
 
-struct Suite
+struct Suite : ArenaAllocated
 {
-    std::vector<std::variant<IntrVarPtr<SimpleStmt>, IntrVarPtr<CompoundStmt>>> statements;
+    ArenaVector<std::variant<IntrVarPtr<SimpleStmt>, IntrVarPtr<CompoundStmt>>> statements;
 };
 
 struct FileInput
 {
-    Suite input;
+    /// Allocator owning the memory of the whole syntax tree. Releasing it releases the tree at once.
+    std::shared_ptr<llvm::BumpPtrAllocator> allocator;
+    /// Storage of the values of all tokens within 'input'.
+    std::shared_ptr<const TokenValueStorage> tokenValues;
+    /// Top level statements of the file. Allocated within 'allocator' and, like every other node of the tree, never
+    /// destroyed explicitly.
+    Suite* input;
     IdentifierSet globals;
+
+    FileInput(std::shared_ptr<llvm::BumpPtrAllocator> allocator, std::shared_ptr<const TokenValueStorage> tokenValues,
+              Suite* input, IdentifierSet globals)
+        : allocator(std::move(allocator)),
+          tokenValues(std::move(tokenValues)),
+          input(input),
+          globals(std::move(globals))
+    {
+    }
 };
 
 } // namespace pylir::Syntax
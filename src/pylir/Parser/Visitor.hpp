@@ -76,7 +76,7 @@ public:
         getImpl()->visit(*call.expression);
         pylir::match(
             call.variant,
-            [&](const std::vector<Argument>& arguments)
+            [&](const ArenaVector<Argument>& arguments)
             {
                 for (auto& iter : arguments)
                 {
@@ -120,7 +120,7 @@ public:
             getImpl()->visit(*comprehension);
             return;
         }
-        for (const auto& iter : pylir::get<std::vector<StarredItem>>(listDisplay.variant))
+        for (const auto& iter : pylir::get<ArenaVector<StarredItem>>(listDisplay.variant))
         {
             getImpl()->visit(iter);
         }
@@ -133,7 +133,7 @@ public:
             getImpl()->visit(*comprehension);
             return;
         }
-        for (const auto& iter : pylir::get<std::vector<StarredItem>>(setDisplay.variant))
+        for (const auto& iter : pylir::get<ArenaVector<StarredItem>>(setDisplay.variant))
         {
             getImpl()->visit(iter);
         }
@@ -148,7 +148,7 @@ public:
             getImpl()->visit(comprehension->compFor);
             return;
         }
-        for (const auto& iter : pylir::get<std::vector<DictDisplay::KeyDatum>>(dictDisplay.variant))
+        for (const auto& iter : pylir::get<ArenaVector<DictDisplay::KeyDatum>>(dictDisplay.variant))
         {
             getImpl()->visit(*iter.key);
             if (iter.maybeValue)
@@ -409,7 +409,7 @@ public:
 
     void visit(const FileInput& fileInput)
     {
-        getImpl()->visit(fileInput.input);
+        getImpl()->visit(*fileInput.input);
     }
 };
 } // namespace pylir::Syntax
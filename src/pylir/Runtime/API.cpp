@@ -6,8 +6,17 @@
 
 #include "API.hpp"
 
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 using namespace pylir::rt;
 
@@ -53,3 +62,171 @@ void pylir_print(PyString& string)
 {
     std::cout << string.view();
 }
+
+namespace
+{
+/// Call counts recorded by instrumented programs. Written to the profile file when the program exits, adding the counts
+/// to the ones already contained in the file. Every line of the profile contains the call site, the qualified name of
+/// the function called and the amount of times it was called, separated by tabs.
+class CallProfile
+{
+    struct CallSite
+    {
+        std::string_view name;
+        std::map<std::string, std::uint64_t, std::less<>> functions;
+    };
+    // Call site names are constants and can therefore be keyed by their address.
+    std::unordered_map<PyString*, CallSite> m_callSites;
+
+public:
+    CallProfile() = default;
+    CallProfile(const CallProfile&) = delete;
+    CallProfile& operator=(const CallProfile&) = delete;
+    CallProfile(CallProfile&&) = delete;
+    CallProfile& operator=(CallProfile&&) = delete;
+
+    void record(PyString& site, std::string_view qualifiedName)
+    {
+        auto [iter, inserted] = m_callSites.try_emplace(&site);
+        if (inserted)
+        {
+            iter->second.name = site.view();
+        }
+        auto& functions = iter->second.functions;
+        auto function = functions.find(qualifiedName);
+        if (function == functions.end())
+        {
+            function = functions.emplace(qualifiedName, 0).first;
+        }
+        function->second++;
+    }
+
+    ~CallProfile()
+    {
+        const char* path = std::getenv("PYLIR_PROFILE_FILE");
+        if (!path || !*path)
+        {
+            path = "default.pylirprof";
+        }
+
+        std::map<std::pair<std::string, std::string>, std::uint64_t> counts;
+        {
+            std::ifstream existing(path);
+            std::string line;
+            while (std::getline(existing, line))
+            {
+                std::istringstream stream(line);
+                std::string site;
+                std::string qualifiedName;
+                std::uint64_t count;
+                if (std::getline(stream, site, '\t') && std::getline(stream, qualifiedName, '\t') && stream >> count)
+                {
+                    counts[{std::move(site), std::move(qualifiedName)}] += count;
+                }
+            }
+        }
+        for (auto& [site, callSite] : m_callSites)
+        {
+            for (auto& [qualifiedName, count] : callSite.functions)
+            {
+                counts[{std::string(callSite.name), qualifiedName}] += count;
+            }
+        }
+
+        std::ofstream output(path, std::ios_base::trunc);
+        for (auto& [key, count] : counts)
+        {
+            output << key.first << '\t' << key.second << '\t' << count << '\n';
+        }
+    }
+};
+
+} // namespace
+
+void pylir_profile_call(PyObject& function, PyString& site)
+{
+    static CallProfile profile;
+    // Callables that are not functions or whose qualified name is not a string are recorded with an empty name.
+    std::string_view qualifiedName;
+    if (auto* qualName = function.isa<PyFunction>() ? function.getSlot(PyFunction::QualName) : nullptr)
+    {
+        if (auto* string = qualName->dyn_cast<PyString>())
+        {
+            qualifiedName = string->view();
+        }
+    }
+    profile.record(site, qualifiedName);
+}
+
+namespace
+{
+
+/// Time spent initializing modules. Only recorded if 'PYLIR_STARTUP_TIMING' is set in the environment, in which case
+/// the time of every module is printed to stderr once its initialization finished. The time of a module does not
+/// include the initialization of the modules it imports.
+class StartupTiming
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame
+    {
+        std::string moduleName;
+        Clock::time_point start;
+        Clock::duration imports{};
+    };
+    std::vector<Frame> m_stack;
+    bool m_enabled = std::getenv("PYLIR_STARTUP_TIMING") != nullptr;
+
+public:
+    void start(std::string_view moduleName)
+    {
+        if (m_enabled)
+        {
+            m_stack.push_back({std::string(moduleName), Clock::now()});
+        }
+    }
+
+    void end(std::string_view moduleName)
+    {
+        if (!m_enabled)
+        {
+            return;
+        }
+        // Modules whose initialization was aborted by an exception never reach their end and are dropped.
+        while (!m_stack.empty() && m_stack.back().moduleName != moduleName)
+        {
+            m_stack.pop_back();
+        }
+        if (m_stack.empty())
+        {
+            return;
+        }
+        auto frame = std::move(m_stack.back());
+        m_stack.pop_back();
+        auto total = Clock::now() - frame.start;
+        if (!m_stack.empty())
+        {
+            m_stack.back().imports += total;
+        }
+        std::cerr << "pylir: initializing " << moduleName << " took "
+                  << std::chrono::duration<double, std::milli>(total - frame.imports).count() << "ms\n";
+    }
+};
+
+StartupTiming& getStartupTiming()
+{
+    static StartupTiming timing;
+    return timing;
+}
+
+} // namespace
+
+void pylir_module_init_start(PyString& moduleName)
+{
+    getStartupTiming().start(moduleName.view());
+}
+
+void pylir_module_init_end(PyString& moduleName)
+{
+    getStartupTiming().end(moduleName.view());
+}
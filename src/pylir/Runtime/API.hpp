@@ -22,6 +22,12 @@ extern "C" void pylir_print(pylir::rt::PyString& string);
 
 extern "C" void pylir_raise(pylir::rt::PyBaseException& exception);
 
+extern "C" void pylir_profile_call(pylir::rt::PyObject& function, pylir::rt::PyString& site);
+
+extern "C" void pylir_module_init_start(pylir::rt::PyString& moduleName);
+
+extern "C" void pylir_module_init_end(pylir::rt::PyString& moduleName);
+
 struct IntGetResult
 {
     std::size_t value;
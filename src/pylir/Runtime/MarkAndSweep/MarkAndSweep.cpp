@@ -75,7 +75,11 @@ void introspectObject(pylir::rt::PyObject* object, F f)
     }
 }
 
-void mark(std::uintptr_t stackLowerBound, std::uintptr_t stackUpperBound, std::vector<pylir::rt::PyObject*>&& workList)
+/// Marks all objects reachable from 'workList'. Objects allocated on the stack are traced as well, as they may
+/// reference objects on the heap. Since they are never swept, they are additionally recorded in 'stackObjects' for
+/// their mark to be reset once collection is done.
+void mark(std::uintptr_t stackLowerBound, std::uintptr_t stackUpperBound, std::vector<pylir::rt::PyObject*>&& workList,
+          std::vector<pylir::rt::PyObject*>& stackObjects)
 {
     while (!workList.empty())
     {
@@ -84,12 +88,15 @@ void mark(std::uintptr_t stackLowerBound, std::uintptr_t stackUpperBound, std::v
         introspectObject(top,
                          [&](pylir::rt::PyObject* subObject)
                          {
-                             auto address = reinterpret_cast<std::uintptr_t>(subObject);
-                             if ((address >= stackLowerBound && address <= stackUpperBound) || isGlobal(subObject)
-                                 || subObject->getMark<bool>())
+                             if (isGlobal(subObject) || subObject->getMark<bool>())
                              {
                                  return;
                              }
+                             auto address = reinterpret_cast<std::uintptr_t>(subObject);
+                             if (address >= stackLowerBound && address <= stackUpperBound)
+                             {
+                                 stackObjects.push_back(subObject);
+                             }
                              mark(subObject);
                              workList.push_back(subObject);
                          });
@@ -111,18 +118,21 @@ void pylir::rt::MarkAndSweep::collect()
             roots.push_back(*iter);
         }
     }
+    std::vector<PyObject*> stackObjects;
     for (auto iter = roots.begin(); iter != roots.end();)
     {
-        auto address = reinterpret_cast<std::uintptr_t>(*iter);
-        if ((address >= stackLower && address <= stackUpper) || isGlobal(*iter) || (*iter)->getMark<bool>())
+        if (isGlobal(*iter) || (*iter)->getMark<bool>())
         {
             iter = roots.erase(iter);
+            continue;
         }
-        else
+        auto address = reinterpret_cast<std::uintptr_t>(*iter);
+        if (address >= stackLower && address <= stackUpper)
         {
-            mark(*iter);
-            iter++;
+            stackObjects.push_back(*iter);
         }
+        mark(*iter);
+        iter++;
     }
     for (const auto& iter : getCollections())
     {
@@ -137,7 +147,11 @@ void pylir::rt::MarkAndSweep::collect()
                              roots.push_back(subObject);
                          });
     }
-    mark(stackLower, stackUpper, std::move(roots));
+    mark(stackLower, stackUpper, std::move(roots), stackObjects);
+    for (auto* iter : stackObjects)
+    {
+        iter->setMark(false);
+    }
     m_unit2.sweep();
     m_unit4.sweep();
     m_unit6.sweep();
@@ -16,22 +16,21 @@
     #include <unistd.h>
 #endif
 
-static std::size_t pageSize;
-
-void __attribute__((constructor(200))) pageSizeInit()
+std::size_t pylir::rt::getPageSize()
 {
+    // Queried lazily on first use instead of from a static constructor, so that programs that never touch the heap
+    // don't pay for the system call at startup.
+    static std::size_t pageSize = []
+    {
 #ifdef _WIN32
-    SYSTEM_INFO systemInfo;
-    GetSystemInfo(&systemInfo);
-    // This is technically not the page size, but it is granularity VirtualAlloc works with.
-    pageSize = systemInfo.dwAllocationGranularity;
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        // This is technically not the page size, but it is granularity VirtualAlloc works with.
+        return static_cast<std::size_t>(systemInfo.dwAllocationGranularity);
 #else
-    pageSize = sysconf(_SC_PAGESIZE);
+        return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
 #endif
-}
-
-std::size_t pylir::rt::getPageSize()
-{
+    }();
     return pageSize;
 }
 
@@ -6,6 +6,7 @@
 
 #include "Stack.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <unordered_map>
@@ -83,7 +84,11 @@ const std::unordered_map<std::uintptr_t, std::vector<StackMap::Location>>& count
 
 std::pair<std::uintptr_t, std::uintptr_t> pylir::rt::collectStackRoots(std::vector<PyObject*>& results)
 {
-    std::uintptr_t stackLowerBound = std::numeric_limits<std::uintptr_t>::max();
+    // Objects may be allocated within the stack frame of any function that is currently being executed. The stack
+    // grows downwards, so any such object lies between the frame of this function and the stack pointer of the
+    // outermost frame.
+    int local;
+    std::uintptr_t stackLowerBound = reinterpret_cast<std::uintptr_t>(&local);
     std::uintptr_t stackUpperBound = 0;
 #ifdef __linux__
     unw_context_t uc;
@@ -92,6 +97,9 @@ std::pair<std::uintptr_t, std::uintptr_t> pylir::rt::collectStackRoots(std::vect
     unw_init_local(&cursor, &uc);
     while (unw_step(&cursor) > 0)
     {
+        unw_word_t stackPointer;
+        unw_get_reg(&cursor, UNW_REG_SP, &stackPointer);
+        stackUpperBound = std::max<std::uintptr_t>(stackUpperBound, stackPointer);
         unw_word_t programCounter;
         unw_get_reg(&cursor, UNW_REG_IP, &programCounter);
         auto result = counterToLoc().find(programCounter);
@@ -142,6 +150,7 @@ std::pair<std::uintptr_t, std::uintptr_t> pylir::rt::collectStackRoots(std::vect
 #else
     auto trace = [&](_Unwind_Context* context)
     {
+        stackUpperBound = std::max<std::uintptr_t>(stackUpperBound, _Unwind_GetCFA(context));
         uintptr_t programCounter = _Unwind_GetIP(context);
         auto result = counterToLoc().find(programCounter);
         if (result == counterToLoc().end())
@@ -0,0 +1,5 @@
+value = 3
+
+
+def double(x):
+    return x + x
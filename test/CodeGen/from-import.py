@@ -0,0 +1,25 @@
+# RUN: pylir %s -emit-pylir -o - -S | FileCheck %s
+
+# CHECK-DAG: py.globalHandle "private" @value
+# CHECK-DAG: py.globalHandle "private" @twice
+
+# CHECK-LABEL: func.func @__init__
+# CHECK: py.call @Inputs.imported.__init__()
+# CHECK: %[[VALUE:.*]] = py.load @Inputs.imported.value
+# CHECK: %[[IS_UNBOUND:.*]] = py.isUnboundValue %[[VALUE]]
+# CHECK: cond_br %[[IS_UNBOUND]], ^[[UNBOUND:[[:alnum:]]+]], ^[[FOUND:[[:alnum:]]+]]
+
+# CHECK: ^[[UNBOUND]]:
+# CHECK: %[[IMPORT_ERROR:.*]] = py.constant(@builtins.ImportError)
+# CHECK: py.raise
+
+# CHECK: ^[[FOUND]]:
+# CHECK: py.store %[[VALUE]] into @value
+# CHECK: %[[DOUBLE:.*]] = py.load @Inputs.imported.double
+# CHECK: py.store %[[DOUBLE]] into @twice
+
+from Inputs.imported import value, double as twice
+
+# CHECK-DAG: func.func private @Inputs.imported.__init__()
+# CHECK-DAG: py.globalHandle @Inputs.imported.value
+# CHECK-DAG: py.globalHandle @Inputs.imported.double
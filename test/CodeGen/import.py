@@ -0,0 +1,26 @@
+# RUN: not pylir %s -emit-pylir -o - -c -S 2>&1 | FileCheck %s
+
+import foo
+
+# CHECK: import.py:3:1: {{.*}}importing modules is not yet supported
+# CHECK-NEXT: 3 | import foo
+
+from foo import bar
+
+# CHECK: import.py:8:6: {{.*}}could not find module 'foo'
+# CHECK-NEXT: 8 | from foo import bar
+
+from . import bar
+
+# CHECK: import.py:13:6: {{.*}}relative imports are not yet supported
+# CHECK-NEXT: 13 | from . import bar
+
+from Inputs.imported import *
+
+# CHECK: import.py:18:29: {{.*}}importing all names of a module is not yet supported
+# CHECK-NEXT: 18 | from Inputs.imported import *
+
+from Inputs.imported import value, missing
+
+# CHECK: import.py:23:36: {{.*}}cannot import name 'missing' from 'Inputs.imported'
+# CHECK-NEXT: 23 | from Inputs.imported import value, missing
@@ -0,0 +1,30 @@
+# RUN: pylir %s -emit-pylir -o - -S -fmodule-name=foo | FileCheck %s
+# RUN: pylir %s -emit-pylir -o - -S -fmodule-name=foo -ftime-module-init | FileCheck %s --check-prefix=TIMING
+
+# CHECK-DAG: py.globalHandle @foo.x
+# CHECK-DAG: py.globalHandle @foo.$initialized
+
+# CHECK-LABEL: func.func @foo.__init__
+# CHECK: %[[INITIALIZED:.*]] = py.load @foo.$initialized
+# CHECK: %[[IS_UNBOUND:.*]] = py.isUnboundValue %[[INITIALIZED]]
+# CHECK: cond_br %[[IS_UNBOUND]], ^[[FIRST:[[:alnum:]]+]], ^[[ALREADY:[[:alnum:]]+]]
+
+# CHECK: ^[[ALREADY]]:
+# CHECK-NEXT: return
+
+# CHECK: ^[[FIRST]]:
+# CHECK: %[[NONE:.*]] = py.constant(@builtins.None)
+# CHECK: py.store %[[NONE]] into @foo.$initialized
+# CHECK-NOT: py.intr.moduleInitStart
+# CHECK: py.store %{{.*}} into @foo.x
+# CHECK-NOT: py.intr.moduleInitEnd
+
+# TIMING-LABEL: func.func @foo.__init__
+# TIMING: py.store %{{.*}} into @foo.$initialized
+# TIMING: %[[NAME:.*]] = py.constant(#py.str<"foo">)
+# TIMING: py.intr.moduleInitStart %[[NAME]]
+# TIMING: py.store %{{.*}} into @foo.x
+# TIMING: py.intr.moduleInitEnd %[[NAME]]
+# TIMING-NEXT: return
+
+x = 3
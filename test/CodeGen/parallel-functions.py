@@ -0,0 +1,35 @@
+# RUN: pylir %s -emit-pylir -o %t.single -S -Xsingle-threaded
+# RUN: pylir %s -emit-pylir -o %t.multi -S -Xmulti-threaded
+# RUN: diff %t.single %t.multi
+# RUN: FileCheck %s --input-file %t.multi
+
+
+def foo():
+    def bar():
+        pass
+
+
+def baz(a, b=3):
+    def bar():
+        return a
+
+    return bar
+
+
+if True:
+    def baz():
+        def bar():
+            pass
+
+# CHECK: func private @"foo$impl[0]"
+# CHECK: func private @"foo.<locals>.bar$impl[0]"
+# CHECK: func private @"foo.<locals>.bar$cc[0]"
+# CHECK: func private @"foo$cc[0]"
+# CHECK: func private @"baz$impl[0]"
+# CHECK: func private @"baz.<locals>.bar$impl[0]"
+# CHECK: func private @"baz.<locals>.bar$cc[0]"
+# CHECK: func private @"baz$cc[0]"
+# CHECK: func private @"baz$impl[1]"
+# CHECK: func private @"baz.<locals>.bar$impl[1]"
+# CHECK: func private @"baz.<locals>.bar$cc[1]"
+# CHECK: func private @"baz$cc[1]"
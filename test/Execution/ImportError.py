@@ -0,0 +1,6 @@
+# RUN: pylir %S/Inputs/unassigned.py -fmodule-name=unassigned -emit-pylir -o %t.mlir
+# RUN: pylir %s -I %S/Inputs --link-pylir=%t.mlir -o %t -O3
+# RUN: not %t 2>&1 | FileCheck %s
+
+from unassigned import missing
+# CHECK: ImportError: cannot import name 'missing' from 'unassigned'
@@ -0,0 +1,7 @@
+print("initializing imported")
+
+value = 3
+
+
+def double(x):
+    return x + x
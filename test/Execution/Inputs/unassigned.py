@@ -0,0 +1,2 @@
+if False:
+    missing = 3
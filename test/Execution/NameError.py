@@ -2,5 +2,4 @@
 # RUN: not %t 2>&1 | FileCheck %s
 
 a
-# CHECK: NameError:
-# TODO error messagea
+# CHECK: NameError: name 'a' is not defined
@@ -0,0 +1,23 @@
+# RUN: pylir %S/Inputs/imported.py -fmodule-name=imported -emit-pylir -o %t.mlir
+# RUN: pylir %s -I %S/Inputs --link-pylir=%t.mlir -o %t -O3
+# RUN: %t | FileCheck %s --match-full-lines
+
+# CHECK: initializing imported
+# CHECK-NEXT: 3
+# CHECK-NEXT: 6
+# CHECK-NEXT: 3
+# CHECK-NOT: initializing imported
+
+from imported import value
+from imported import double as twice
+
+print(value)
+print(twice(value))
+
+
+def foo():
+    from imported import value as local
+    return local
+
+
+print(foo())
@@ -0,0 +1,13 @@
+# RUN: pylir %S/Inputs/imported.py -fmodule-name=imported -emit-pylir -o %t.mlir -ftime-module-init
+# RUN: pylir %s -I %S/Inputs --link-pylir=%t.mlir -o %t -O3 -ftime-module-init
+# RUN: env PYLIR_STARTUP_TIMING=1 %t 2>&1 >/dev/null | FileCheck %s
+# RUN: %t 2>&1 >/dev/null | FileCheck %s --check-prefix=DISABLED --allow-empty
+
+# CHECK: pylir: initializing imported took {{[0-9.e+-]+}}ms
+# CHECK-NEXT: pylir: initializing __main__ took {{[0-9.e+-]+}}ms
+
+# DISABLED-NOT: pylir: initializing
+
+from imported import value
+
+print(value)
@@ -0,0 +1,6 @@
+func.func private @helper() -> !py.dynamic
+
+func.func @uses_declaration() -> !py.dynamic {
+    %0 = call @helper() : () -> !py.dynamic
+    return %0 : !py.dynamic
+}
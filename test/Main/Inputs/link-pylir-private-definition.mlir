@@ -0,0 +1,9 @@
+func.func private @helper() -> !py.dynamic {
+    %0 = py.constant(#py.str<"definition">)
+    return %0 : !py.dynamic
+}
+
+func.func @uses_definition() -> !py.dynamic {
+    %0 = call @helper() : () -> !py.dynamic
+    return %0 : !py.dynamic
+}
@@ -0,0 +1,4 @@
+func.func @linked_function() -> !py.dynamic {
+    %0 = py.constant(#py.str<"other">)
+    return %0 : !py.dynamic
+}
@@ -0,0 +1,7 @@
+py.globalValue @builtins.type
+py.globalValue "private" const @const$ = #py.str<"text">
+
+func.func @linked_function() -> !py.dynamic {
+    %0 = py.constant(@const$)
+    return %0 : !py.dynamic
+}
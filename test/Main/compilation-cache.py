@@ -0,0 +1,28 @@
+# RUN: rm -rf %t.cache %t.o %t2.o
+# RUN: pylir %s -c -o %t.o --cache-dir=%t.cache
+# RUN: ls %t.cache | FileCheck %s
+# CHECK: {{[[:xdigit:]]+}}.o
+
+# RUN: pylir %s -c -o %t2.o --cache-dir=%t.cache -v 2>&1 | FileCheck %s --check-prefix=HIT
+# HIT: Using cached object file
+# RUN: cmp %t.o %t2.o
+
+# Different options result in a different cache entry
+# RUN: pylir %s -c -o %t2.o --cache-dir=%t.cache -O1 -v 2>&1 | FileCheck %s --check-prefix=MISS
+# MISS-NOT: Using cached object file
+
+# RUN: env PYLIR_CACHE_DIR=%t.cache pylir %s -c -o %t2.o -v 2>&1 | FileCheck %s --check-prefix=HIT
+
+# Options only affecting the linker or diagnostic output do not change the object file
+# RUN: pylir %s -c -o %t2.o --cache-dir=%t.cache -L%t.cache -Wl,--gc-sections --verbose 2>&1 | FileCheck %s --check-prefix=HIT
+
+# Changing the source without changing the generated IR still reuses the object file
+# RUN: rm -rf %t.ir-cache
+# RUN: cp %s %t.py
+# RUN: pylir %t.py -c -o %t.o --cache-dir=%t.ir-cache
+# RUN: echo "# A new comment" >> %t.py
+# RUN: pylir %t.py -c -o %t2.o --cache-dir=%t.ir-cache -v 2>&1 | FileCheck %s --check-prefix=IR-HIT
+# IR-HIT: Using cached object file {{.*}} with identical IR
+# RUN: cmp %t.o %t2.o
+
+x = 3
@@ -0,0 +1,14 @@
+# RUN: pylir %S/Inputs/link-pylir-module.py -emit-pylir -o %t.mlir
+# RUN: pylir %s -emit-pylir -o - --link-pylir=%t.mlir | FileCheck %s
+
+# Builtins are contained in both modules and merged. The module initializer of the linked module is run first.
+
+# CHECK: @builtins.type =
+# CHECK: py.globalHandle "private" @x
+# CHECK-LABEL: func.func @__init__()
+# CHECK-NEXT: py.call @[[INIT:"?__init__\$[0-9]+"?]]()
+# CHECK-NOT: @builtins.type =
+# CHECK: py.globalHandle "private" @y
+# CHECK: func.func private @[[INIT]]()
+
+x = 3
@@ -0,0 +1,24 @@
+# RUN: pylir %s -emit-pylir -o - --link-pylir=%S/Inputs/link-pylir.mlir | FileCheck %s
+# RUN: not pylir %s -emit-pylir -o - --link-pylir=%S/Inputs/link-pylir.mlir \
+# RUN: --link-pylir=%S/Inputs/link-pylir-redefinition.mlir 2>&1 | FileCheck %s --check-prefix=REDEFINITION
+# RUN: pylir %s -emit-pylir -o - --link-pylir=%S/Inputs/link-pylir-private-definition.mlir \
+# RUN: --link-pylir=%S/Inputs/link-pylir-private-declaration.mlir | FileCheck %s --check-prefix=PRIVATE
+
+# CHECK-NOT: py.globalValue @builtins.type{{$}}
+# CHECK-DAG: py.globalValue "private" const @[[CONST:.*]] = #py.str<"text">
+# CHECK-DAG: func.func @__init__()
+# CHECK-DAG: func.func @linked_function()
+# CHECK-DAG: py.constant(@[[CONST]])
+
+# REDEFINITION: redefinition of public symbol 'linked_function'
+
+# A private declaration must not bind to an unrelated private definition of the same name.
+
+# PRIVATE: func.func private @[[RENAMED:"?helper\$[0-9]+"?]]() -> !py.dynamic {
+# PRIVATE-LABEL: func.func @uses_definition
+# PRIVATE-NEXT: call @[[RENAMED]]()
+# PRIVATE: func.func private @helper() -> !py.dynamic{{$}}
+# PRIVATE-LABEL: func.func @uses_declaration
+# PRIVATE-NEXT: call @helper()
+
+x = 3
@@ -0,0 +1,133 @@
+// RUN: pylir-opt %s --test-memory-ssa-updater --split-input-file | FileCheck %s
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.list = #py.type
+
+func.func @duplicate(%length : index) -> index {
+    %0 = py.makeList ()
+    py.list.resize %0 to %length {test.duplicate}
+    %1 = py.list.len %0
+    return %1 : index
+}
+
+// CHECK-LABEL: memSSA.module @duplicate
+// CHECK-NEXT: %[[ENTRY:.*]] = liveOnEntry
+// CHECK-NEXT: %[[DEF1:.*]] = def(%[[ENTRY]])
+// CHECK-NEXT: py.makeList
+// CHECK-NEXT: %[[DEF2:.*]] = def(%[[DEF1]])
+// CHECK-NEXT: py.list.resize
+// CHECK-NEXT: %[[DEF3:.*]] = def(%[[DEF2]])
+// CHECK-NEXT: py.list.resize
+// CHECK-NEXT: use(%[[DEF3]])
+// CHECK-NEXT: py.list.len
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.list = #py.type
+
+func.func @erase(%length : index) -> index {
+    %0 = py.makeList ()
+    py.list.resize %0 to %length {test.erase}
+    %1 = py.list.len %0
+    return %1 : index
+}
+
+// CHECK-LABEL: memSSA.module @erase
+// CHECK-NEXT: %[[ENTRY:.*]] = liveOnEntry
+// CHECK-NEXT: %[[DEF1:.*]] = def(%[[ENTRY]])
+// CHECK-NEXT: py.makeList
+// CHECK-NEXT: use(%[[DEF1]])
+// CHECK-NEXT: py.list.len
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.list = #py.type
+
+func.func @sink(%arg0 : i1, %length : index) -> index {
+    %0 = py.makeList ()
+    cf.cond_br %arg0, ^bb1, ^bb2
+
+^bb1:
+    py.list.resize %0 to %length {test.sink}
+    cf.br ^bb2
+
+^bb2:
+    %1 = py.list.len %0
+    return %1 : index
+}
+
+// CHECK-LABEL: memSSA.module @sink
+// CHECK-NEXT: %[[ENTRY:.*]] = liveOnEntry
+// CHECK-NEXT: %[[DEF1:.*]] = def(%[[ENTRY]])
+// CHECK-NEXT: py.makeList
+// CHECK-NEXT: br ^[[BB1:.*]], ^[[BB2:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[BB1]]:
+// CHECK-NEXT: br ^[[BB2]] (%[[DEF1]])
+// CHECK-NEXT: ^[[BB2]]
+// CHECK-SAME: %[[ARG:[[:alnum:]]+]]
+// CHECK-NEXT: %[[DEF2:.*]] = def(%[[ARG]])
+// CHECK-NEXT: py.list.resize
+// CHECK-NEXT: use(%[[DEF2]])
+// CHECK-NEXT: py.list.len
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.list = #py.type
+
+func.func @sink_phi(%arg0 : i1, %length : index) -> index {
+    %0 = py.makeList ()
+    py.list.resize %0 to %length {test.sink}
+    cf.cond_br %arg0, ^bb1, ^bb2
+
+^bb1:
+    cf.br ^bb3
+
+^bb2:
+    cf.br ^bb3
+
+^bb3:
+    %1 = py.list.len %0
+    return %1 : index
+}
+
+// CHECK-LABEL: memSSA.module @sink_phi
+// CHECK-NEXT: %[[ENTRY:.*]] = liveOnEntry
+// CHECK-NEXT: %[[DEF1:.*]] = def(%[[ENTRY]])
+// CHECK-NEXT: py.makeList
+// CHECK-NEXT: br ^[[BB1:.*]], ^[[BB2:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[BB1]]:
+// CHECK-NEXT: %[[DEF2:.*]] = def(%[[DEF1]])
+// CHECK-NEXT: py.list.resize
+// CHECK-NEXT: br ^[[BB3:[[:alnum:]]+]] (%[[DEF2]])
+// CHECK-NEXT: ^[[BB2]]:
+// CHECK-NEXT: br ^[[BB3]] (%[[DEF1]])
+// CHECK-NEXT: ^[[BB3]]
+// CHECK-SAME: %[[ARG:[[:alnum:]]+]]
+// CHECK-NEXT: use(%[[ARG]])
+// CHECK-NEXT: py.list.len
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.list = #py.type
+
+func.func @split(%length : index) -> index {
+    %0 = py.makeList ()
+    py.list.resize %0 to %length
+    %1 = py.list.len %0 {test.split}
+    return %1 : index
+}
+
+// CHECK-LABEL: memSSA.module @split
+// CHECK-NEXT: %[[ENTRY:.*]] = liveOnEntry
+// CHECK-NEXT: %[[DEF1:.*]] = def(%[[ENTRY]])
+// CHECK-NEXT: py.makeList
+// CHECK-NEXT: %[[DEF2:.*]] = def(%[[DEF1]])
+// CHECK-NEXT: py.list.resize
+// CHECK-NEXT: br ^[[BB1:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[BB1]]:
+// CHECK-NEXT: use(%[[DEF2]])
+// CHECK-NEXT: py.list.len
@@ -0,0 +1,16 @@
+// RUN: pylir-opt %s -convert-pylir-to-llvm --split-input-file | FileCheck %s
+
+func.func @test(%arg : i1, %lhs : !py.dynamic, %rhs : !py.dynamic) -> !py.dynamic {
+    cf.cond_br %arg, ^bb1(%lhs : !py.dynamic), ^bb1(%rhs : !py.dynamic)
+        {py.branch_weights = dense<[950, 50]> : vector<2xi32>}
+
+^bb1(%0 : !py.dynamic):
+    return %0 : !py.dynamic
+}
+
+// CHECK: @test
+// CHECK-SAME: %[[ARG:[[:alnum:]]+]]
+// CHECK-SAME: %[[LHS:[[:alnum:]]+]]
+// CHECK-SAME: %[[RHS:[[:alnum:]]+]]
+// CHECK-NEXT: llvm.cond_br %[[ARG]] weights({{.*}}[950, 50]{{.*}}), ^[[BB1:[[:alnum:]]+]](%[[LHS]] : {{.*}}),
+// CHECK-SAME: ^[[BB1]](%[[RHS]] : {{.*}})
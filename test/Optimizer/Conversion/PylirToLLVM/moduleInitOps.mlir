@@ -0,0 +1,16 @@
+// RUN: pylir-opt %s -convert-pylir-to-llvm --split-input-file | FileCheck %s
+
+func.func @test(%name : !py.dynamic) {
+    py.intr.moduleInitStart %name
+    py.intr.moduleInitEnd %name
+    return
+}
+
+// CHECK: @test
+// CHECK-SAME: %[[NAME:[[:alnum:]]+]]
+// CHECK-NEXT: llvm.call @pylir_module_init_start(%[[NAME]])
+// CHECK-NEXT: llvm.call @pylir_module_init_end(%[[NAME]])
+// CHECK-NEXT: llvm.return
+
+// CHECK-DAG: llvm.func @pylir_module_init_start
+// CHECK-DAG: llvm.func @pylir_module_init_end
@@ -0,0 +1,14 @@
+// RUN: pylir-opt %s -convert-pylir-to-llvm --split-input-file | FileCheck %s
+
+func.func @test(%function : !py.dynamic, %site : !py.dynamic) {
+    py.intr.profileCall %function at %site
+    return
+}
+
+// CHECK: @test
+// CHECK-SAME: %[[FUNCTION:[[:alnum:]]+]]
+// CHECK-SAME: %[[SITE:[[:alnum:]]+]]
+// CHECK-NEXT: llvm.call @pylir_profile_call(%[[FUNCTION]], %[[SITE]])
+// CHECK-NEXT: llvm.return
+
+// CHECK: llvm.func @pylir_profile_call
@@ -0,0 +1,64 @@
+// RUN: pylir-opt %s -convert-pylir-to-llvm --split-input-file | FileCheck %s
+
+py.globalValue const @builtins.type = #py.type<slots = {__slots__ = #py.tuple<(#py.str<"__slots__">,#py.str<"__eq__">,#py.str<"__hash__">)>}>
+py.globalValue const @builtins.tuple = #py.type // stub
+py.globalValue const @builtins.str = #py.type // stub
+py.globalValue const @builtins.float = #py.type // stub
+
+func.func @foo() -> !pyMem.memory {
+    cf.br ^bb1
+
+^bb1:
+    %0 = py.constant(@builtins.float)
+    %1 = pyMem.stackAllocObject %0
+    return %1 : !pyMem.memory
+}
+
+// CHECK-LABEL: llvm.func @foo
+// CHECK-NEXT: %[[ONE:.*]] = llvm.mlir.constant(1 : i32)
+// CHECK-NEXT: %[[ALLOCA:.*]] = llvm.alloca %[[ONE]] x !llvm.array<{{[0-9]+}} x i8>
+// CHECK-NEXT: llvm.br ^[[BB1:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[BB1]]:
+// CHECK-NEXT: %[[FLOAT:.*]] = llvm.mlir.addressof @builtins.float
+// CHECK-NEXT: %[[BYTES:.*]] = llvm.mlir.constant
+// CHECK-NEXT: %[[ZERO_I8:.*]] = llvm.mlir.constant(0 : i8)
+// CHECK-NEXT: %[[FALSE:.*]] = llvm.mlir.constant(false)
+// CHECK-NEXT: "llvm.intr.memset"(%[[ALLOCA]], %[[ZERO_I8]], %[[BYTES]], %[[FALSE]])
+// CHECK-NEXT: %[[ADDRESS:.*]] = llvm.ptrtoint %[[ALLOCA]]
+// CHECK-NEXT: %[[MEMORY:.*]] = llvm.inttoptr %[[ADDRESS]] : i{{[0-9]+}} to !llvm.ptr<1>
+// CHECK-NEXT: %[[ZERO:.*]] = llvm.mlir.constant(0 : i{{[0-9]+}})
+// CHECK-NEXT: %[[GEP:.*]] = llvm.getelementptr %[[MEMORY]][%[[ZERO]], 0]
+// CHECK-NEXT: llvm.store %[[FLOAT]], %[[GEP]]
+// CHECK-NEXT: llvm.return %[[MEMORY]]
+
+// -----
+
+py.globalValue const @builtins.type = #py.type<slots = {__slots__ = #py.tuple<(#py.str<"__slots__">,#py.str<"__eq__">,#py.str<"__hash__">)>}>
+py.globalValue const @builtins.tuple = #py.type // stub
+py.globalValue const @builtins.str = #py.type // stub
+
+func.func @foo() -> !pyMem.memory {
+    cf.br ^bb1
+
+^bb1:
+    %0 = py.constant(@builtins.tuple)
+    %1 = pyMem.stackAllocTuple %0[2]
+    return %1 : !pyMem.memory
+}
+
+// CHECK-LABEL: llvm.func @foo
+// CHECK-NEXT: %[[ONE:.*]] = llvm.mlir.constant(1 : i32)
+// CHECK-NEXT: %[[ALLOCA:.*]] = llvm.alloca %[[ONE]] x !llvm.array<{{[0-9]+}} x i8>
+// CHECK-NEXT: llvm.br ^[[BB1:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[BB1]]:
+// CHECK-NEXT: %[[TUPLE:.*]] = llvm.mlir.addressof @builtins.tuple
+// CHECK-NEXT: %[[BYTES:.*]] = llvm.mlir.constant
+// CHECK-NEXT: %[[ZERO_I8:.*]] = llvm.mlir.constant(0 : i8)
+// CHECK-NEXT: %[[FALSE:.*]] = llvm.mlir.constant(false)
+// CHECK-NEXT: "llvm.intr.memset"(%[[ALLOCA]], %[[ZERO_I8]], %[[BYTES]], %[[FALSE]])
+// CHECK-NEXT: %[[ADDRESS:.*]] = llvm.ptrtoint %[[ALLOCA]]
+// CHECK-NEXT: %[[MEMORY:.*]] = llvm.inttoptr %[[ADDRESS]] : i{{[0-9]+}} to !llvm.ptr<1>
+// CHECK-NEXT: %[[ZERO:.*]] = llvm.mlir.constant(0 : i{{[0-9]+}})
+// CHECK-NEXT: %[[GEP:.*]] = llvm.getelementptr %[[MEMORY]][%[[ZERO]], 0]
+// CHECK-NEXT: llvm.store %[[TUPLE]], %[[GEP]]
+// CHECK-NEXT: llvm.return %[[MEMORY]]
@@ -0,0 +1,95 @@
+// RUN: pylir-opt %s -pylir-stack-allocation --split-input-file | FileCheck %s
+
+py.globalValue const @builtins.type = #py.type
+py.globalValue const @builtins.object = #py.type
+py.globalValue const @builtins.tuple = #py.type<mroTuple = #py.tuple<(@builtins.tuple, @builtins.object)>>
+
+func.func @local_tuple(%arg0 : !py.dynamic) -> index {
+    %0 = py.constant(@builtins.tuple)
+    %1 = arith.constant 1 : index
+    %2 = pyMem.gcAllocTuple %0[%1]
+    %3 = pyMem.initTuple %2 to (%arg0)
+    %4 = py.tuple.len %3
+    return %4 : index
+}
+
+// CHECK-LABEL: @local_tuple
+// CHECK-SAME: %[[ARG:[[:alnum:]]+]]
+// CHECK: %[[TUPLE:.*]] = py.constant(@builtins.tuple)
+// CHECK: %[[MEM:.*]] = pyMem.stackAllocTuple %[[TUPLE]][1]
+// CHECK-NEXT: pyMem.initTuple %[[MEM]] to (%[[ARG]])
+
+// -----
+
+py.globalValue const @builtins.type = #py.type
+py.globalValue const @builtins.object = #py.type
+py.globalValue const @builtins.tuple = #py.type<mroTuple = #py.tuple<(@builtins.tuple, @builtins.object)>>
+
+func.func @returned_tuple(%arg0 : !py.dynamic) -> !py.dynamic {
+    %0 = py.constant(@builtins.tuple)
+    %1 = arith.constant 1 : index
+    %2 = pyMem.gcAllocTuple %0[%1]
+    %3 = pyMem.initTuple %2 to (%arg0)
+    return %3 : !py.dynamic
+}
+
+// CHECK-LABEL: @returned_tuple
+// CHECK: pyMem.gcAllocTuple
+// CHECK-NOT: pyMem.stackAllocTuple
+
+// -----
+
+py.globalValue const @builtins.type = #py.type
+py.globalValue const @builtins.object = #py.type
+py.globalValue const @builtins.tuple = #py.type<mroTuple = #py.tuple<(@builtins.tuple, @builtins.object)>>
+
+func.func private @length(%arg0 : !py.dynamic) -> index {
+    %0 = py.tuple.len %arg0
+    return %0 : index
+}
+
+func.func private @store(%arg0 : !py.dynamic) -> !py.dynamic {
+    return %arg0 : !py.dynamic
+}
+
+func.func @call_arguments(%arg0 : !py.dynamic) -> index {
+    %0 = py.constant(@builtins.tuple)
+    %1 = arith.constant 1 : index
+    %2 = pyMem.gcAllocTuple %0[%1]
+    %3 = pyMem.initTuple %2 to (%arg0)
+    %4 = call @length(%3) : (!py.dynamic) -> index
+    %5 = pyMem.gcAllocTuple %0[%1]
+    %6 = pyMem.initTuple %5 to (%arg0)
+    %7 = call @store(%6) : (!py.dynamic) -> !py.dynamic
+    return %4 : index
+}
+
+// CHECK-LABEL: @call_arguments
+// CHECK: pyMem.stackAllocTuple
+// CHECK: call @length
+// CHECK: pyMem.gcAllocTuple
+// CHECK: call @store
+
+// -----
+
+py.globalValue const @builtins.type = #py.type
+py.globalValue const @builtins.object = #py.type
+py.globalValue const @builtins.float = #py.type<mroTuple = #py.tuple<(@builtins.float, @builtins.object)>>
+py.globalValue const @builtins.int = #py.type<mroTuple = #py.tuple<(@builtins.int, @builtins.object)>>
+
+func.func @boxed_numbers(%arg0 : f64, %arg1 : index) -> i1 {
+    %0 = py.constant(@builtins.float)
+    %1 = pyMem.gcAllocObject %0
+    %2 = pyMem.initFloat %1 to %arg0
+    %3 = py.constant(@builtins.int)
+    %4 = pyMem.gcAllocObject %3
+    %5 = pyMem.initInt %4 to %arg1 : index
+    %6 = py.is %2, %5
+    return %6 : i1
+}
+
+// CHECK-LABEL: @boxed_numbers
+// CHECK: %[[FLOAT:.*]] = py.constant(@builtins.float)
+// CHECK-NEXT: pyMem.stackAllocObject %[[FLOAT]]
+// CHECK: %[[INT:.*]] = py.constant(@builtins.int)
+// CHECK-NEXT: pyMem.gcAllocObject %[[INT]]
@@ -0,0 +1,214 @@
+// RUN: pylir-opt %s -pass-pipeline="any(pylir-licm)" --split-input-file | FileCheck %s
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+py.globalValue @builtins.function = #py.type
+
+func.func @versioning(%obj : !py.dynamic, %n : !py.dynamic) -> !py.dynamic {
+    %zero = py.constant(#py.int<0>)
+    %one = py.constant(#py.int<1>)
+    %function = py.constant(@builtins.function)
+    cf.br ^condition(%zero : !py.dynamic)
+
+^condition(%i : !py.dynamic):
+    %0 = py.int.cmp lt %i, %n
+    cf.cond_br %0, ^body, ^exit
+
+^body:
+    %1 = py.typeOf %obj
+    %2 = py.type.mro %1
+    %3, %found = py.mroLookup "__call__" in %2
+    cf.cond_br %found, ^found, ^latch
+
+^found:
+    %4 = py.typeOf %3
+    %5 = py.is %4, %function
+    cf.cond_br %5, ^call, ^latch
+
+^call:
+    test.use(%3) : !py.dynamic
+    cf.br ^latch
+
+^latch:
+    %6 = py.int.add %i, %one
+    cf.br ^condition(%6 : !py.dynamic)
+
+^exit:
+    return %i : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @versioning
+// CHECK-SAME: %[[OBJ:[[:alnum:]]+]]
+// CHECK: %[[TYPE:.*]] = py.typeOf %[[OBJ]]
+// CHECK-NEXT: %[[MRO:.*]] = py.type.mro %[[TYPE]]
+// CHECK-NEXT: %[[RESULT:.*]], %[[FOUND:.*]] = py.mroLookup "__call__" in %[[MRO]]
+// CHECK-NEXT: %[[CALLABLE_TYPE:.*]] = py.typeOf %[[RESULT]]
+// CHECK-NEXT: %[[IS_FUNCTION:.*]] = py.is %[[CALLABLE_TYPE]], %{{.*}}
+// CHECK-NEXT: cf.cond_br %[[FOUND]], ^[[FOUND_LOOP:[[:alnum:]]+]](%{{.*}} : !py.dynamic), ^[[NOT_FOUND_LOOP:[[:alnum:]]+]](%{{.*}} : !py.dynamic)
+// CHECK-NEXT: ^[[FOUND_LOOP]](%[[I:[[:alnum:]]+]]: !py.dynamic):
+// CHECK-NEXT: %[[CMP:.*]] = py.int.cmp lt %[[I]]
+// CHECK-NEXT: cf.cond_br %[[CMP]], ^[[BODY:[[:alnum:]]+]], ^[[EXIT:[[:alnum:]]+]](%[[I]] : !py.dynamic)
+// CHECK-NEXT: ^[[BODY]]:
+// CHECK-NEXT: cf.br ^[[FOUND_BLOCK:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[FOUND_BLOCK]]:
+// CHECK-NEXT: cf.cond_br %[[IS_FUNCTION]]
+// CHECK: ^[[NOT_FOUND_LOOP]](%[[I2:[[:alnum:]]+]]: !py.dynamic):
+// CHECK-NEXT: %[[CMP2:.*]] = py.int.cmp lt %[[I2]]
+// CHECK-NEXT: cf.cond_br %[[CMP2]], ^[[BODY2:[[:alnum:]]+]], ^[[EXIT]](%[[I2]] : !py.dynamic)
+// CHECK-NEXT: ^[[BODY2]]:
+// CHECK-NEXT: cf.br ^[[LATCH2:[[:alnum:]]+]]
+// CHECK: ^[[EXIT]](%[[RET:[[:alnum:]]+]]: !py.dynamic):
+// CHECK-NEXT: return %[[RET]]
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+py.globalHandle @handle
+py.globalHandle @other
+
+func.func @loads(%n : !py.dynamic) -> !py.dynamic {
+    %zero = py.constant(#py.int<0>)
+    cf.br ^condition(%zero : !py.dynamic)
+
+^condition(%i : !py.dynamic):
+    %0 = py.load @handle
+    %1 = py.load @other
+    %2 = py.int.add %i, %0
+    py.store %2 into @other
+    %3 = py.int.cmp lt %2, %n
+    cf.cond_br %3, ^condition(%2 : !py.dynamic), ^exit
+
+^exit:
+    return %1 : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @loads
+// CHECK: %[[HANDLE:.*]] = py.load @handle
+// CHECK-NEXT: cf.br ^[[CONDITION:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[CONDITION]](%[[I:[[:alnum:]]+]]: !py.dynamic):
+// CHECK-NEXT: py.load @other
+// CHECK-NEXT: py.int.add %[[I]], %[[HANDLE]]
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+
+func.func @slots(%obj : !py.dynamic, %n : !py.dynamic, %value : !py.dynamic) -> !py.dynamic {
+    %zero = py.constant(#py.int<0>)
+    %type = py.typeOf %obj
+    cf.br ^condition(%zero : !py.dynamic)
+
+^condition(%i : !py.dynamic):
+    %0 = py.getSlot "__dict__" from %obj : %type
+    %1 = py.int.add %i, %0
+    %2 = py.int.cmp lt %1, %n
+    cf.cond_br %2, ^condition(%1 : !py.dynamic), ^second(%zero : !py.dynamic)
+
+^second(%j : !py.dynamic):
+    %3 = py.getSlot "__weakref__" from %obj : %type
+    py.setSlot "__dict__" of %obj : %type to %value
+    %4 = py.int.add %j, %3
+    %5 = py.int.cmp lt %4, %n
+    cf.cond_br %5, ^second(%4 : !py.dynamic), ^exit
+
+^exit:
+    return %4 : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @slots
+// CHECK-SAME: %[[OBJ:[[:alnum:]]+]]
+// CHECK: %[[TYPE:.*]] = py.typeOf %[[OBJ]]
+// CHECK-NEXT: %[[DICT:.*]] = py.getSlot "__dict__" from %[[OBJ]] : %[[TYPE]]
+// CHECK-NEXT: cf.br ^[[CONDITION:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[CONDITION]](%[[I:[[:alnum:]]+]]: !py.dynamic):
+// CHECK-NEXT: py.int.add %[[I]], %[[DICT]]
+// CHECK: ^[[PREHEADER:[[:alnum:]]+]](%[[ZERO:[[:alnum:]]+]]: !py.dynamic):
+// CHECK-NEXT: cf.br ^[[SECOND:[[:alnum:]]+]](%[[ZERO]] : !py.dynamic)
+// CHECK-NEXT: ^[[SECOND]](%[[J:[[:alnum:]]+]]: !py.dynamic):
+// CHECK-NEXT: %[[WEAKREF:.*]] = py.getSlot "__weakref__" from %[[OBJ]] : %[[TYPE]]
+// CHECK-NEXT: py.setSlot "__dict__" of %[[OBJ]] : %[[TYPE]] to %{{.*}}
+// CHECK-NEXT: py.int.add %[[J]], %[[WEAKREF]]
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+py.globalValue @builtins.NameError = #py.type
+py.globalHandle @handle
+
+func.func @unbound_guard(%n : !py.dynamic) -> !py.dynamic {
+    %zero = py.constant(#py.int<0>)
+    %one = py.constant(#py.int<1>)
+    %value = py.load @handle
+    cf.br ^condition(%zero : !py.dynamic)
+
+^condition(%i : !py.dynamic):
+    %0 = py.int.cmp lt %i, %n
+    cf.cond_br %0, ^body, ^exit
+
+^body:
+    %1 = py.isUnboundValue %value
+    cf.cond_br %1, ^raise, ^bound
+
+^bound:
+    %2 = py.typeOf %value
+    test.use(%2) : !py.dynamic
+    %3 = py.int.add %i, %one
+    cf.br ^condition(%3 : !py.dynamic)
+
+^raise:
+    %4 = py.constant(@builtins.NameError)
+    py.raise %4
+
+^exit:
+    return %i : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @unbound_guard
+// CHECK: %[[VALUE:.*]] = py.load @handle
+// CHECK-NOT: py.typeOf
+// CHECK: %[[UNBOUND:.*]] = py.isUnboundValue %[[VALUE]]
+// CHECK-NOT: py.typeOf
+// CHECK: cf.cond_br %[[UNBOUND]], ^{{[[:alnum:]]+}}, ^[[BOUND:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[BOUND]]:
+// CHECK-NEXT: %[[TYPE:.*]] = py.typeOf %[[VALUE]]
+// CHECK-NEXT: test.use(%[[TYPE]])
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+py.globalHandle @handle
+py.globalHandle @other
+
+func.func @nested_loads(%n : !py.dynamic) -> !py.dynamic {
+    %zero = py.constant(#py.int<0>)
+    cf.br ^outer(%zero : !py.dynamic)
+
+^outer(%i : !py.dynamic):
+    cf.br ^inner(%i : !py.dynamic)
+
+^inner(%j : !py.dynamic):
+    %0 = py.load @handle
+    %1 = py.int.add %j, %0
+    py.store %1 into @other
+    %2 = py.int.cmp lt %1, %n
+    cf.cond_br %2, ^inner(%1 : !py.dynamic), ^latch
+
+^latch:
+    %3 = py.int.add %i, %0
+    %4 = py.int.cmp lt %3, %n
+    cf.cond_br %4, ^outer(%3 : !py.dynamic), ^exit
+
+^exit:
+    return %i : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @nested_loads
+// CHECK: %[[HANDLE:.*]] = py.load @handle
+// CHECK-NEXT: cf.br ^[[OUTER:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[OUTER]](%{{.*}}: !py.dynamic):
+// CHECK-NOT: py.load
+// CHECK: py.int.add %{{.*}}, %[[HANDLE]]
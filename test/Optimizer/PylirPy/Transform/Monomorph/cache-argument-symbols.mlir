@@ -0,0 +1,32 @@
+// RUN: rm -f %t.cache
+// RUN: sed 's/FIRST/SECOND/' %s > %t.mlir
+// RUN: pylir-opt %s --pylir-monomorph="cache-file=%t.cache" -mlir-pass-statistics -o /dev/null 2> %t.stats
+// RUN: FileCheck %s --check-prefix=MISS --input-file %t.stats
+// RUN: pylir-opt %t.mlir --pylir-monomorph="cache-file=%t.cache" -mlir-pass-statistics -o /dev/null 2> %t.stats
+// RUN: FileCheck %s --check-prefix=MISS --input-file %t.stats
+// RUN: pylir-opt %t.mlir --pylir-monomorph="cache-file=%t.cache" -mlir-pass-statistics -o /dev/null 2> %t.stats
+// RUN: FileCheck %s --check-prefix=HIT --input-file %t.stats
+
+// @aType is only referenced by the argument of @createObject, not by @createObject itself. Changing it must
+// invalidate the specialization nevertheless.
+
+// MISS: {{[[:space:]]}}0 Cache hits
+// HIT: {{[[:space:]]}}2 Cache hits
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.tuple = #py.type
+py.globalValue @aType = #py.type<slots = {__slots__ = #py.tuple<(#py.str<"FIRST">)>}>
+
+func.func @createObject(%typeObject : !py.dynamic) -> !py.dynamic {
+	%0 = py.makeObject %typeObject
+	test.use(%0) : !py.dynamic
+	return %0 : !py.dynamic
+}
+
+func.func @__init__() -> !py.dynamic {
+	%0 = py.constant(@aType)
+	%1 = py.call @createObject(%0) : (!py.dynamic) -> !py.dynamic
+	%2 = py.typeOf %1
+	return %2 : !py.dynamic
+}
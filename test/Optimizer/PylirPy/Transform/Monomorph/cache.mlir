@@ -0,0 +1,30 @@
+// RUN: rm -f %t.cache
+// RUN: pylir-opt %s --pylir-monomorph="cache-file=%t.cache" -mlir-pass-statistics > %t.first 2> %t.stats
+// RUN: FileCheck %s --check-prefix=MISS --input-file %t.stats
+// RUN: pylir-opt %s --pylir-monomorph="cache-file=%t.cache" -mlir-pass-statistics > %t.second 2> %t.stats
+// RUN: FileCheck %s --check-prefix=HIT --input-file %t.stats
+// RUN: diff %t.first %t.second
+// RUN: FileCheck %s --input-file %t.second
+
+// MISS: {{[[:space:]]}}0 Cache hits
+// HIT: {{[[:space:]]}}2 Cache hits
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+
+func.func @foo(%arg0 : !py.dynamic) -> !py.dynamic {
+	%0 = py.constant(#py.int<1>)
+	%1 = py.int.add %arg0, %0
+	return %1 : !py.dynamic
+}
+
+func.func @__init__() -> !py.dynamic {
+	%0 = py.constant(#py.int<0>)
+	%1 = py.call @foo(%0) : (!py.dynamic) -> !py.dynamic
+	%2 = py.typeOf %1
+	return %2 : !py.dynamic
+}
+
+// CHECK-LABEL: func @__init__
+// CHECK: %[[TYPE:.*]] = py.constant(@builtins.int)
+// CHECK: return %[[TYPE]]
@@ -0,0 +1,43 @@
+// RUN: pylir-opt %s --pylir-monomorph --split-input-file --mlir-disable-threading > %t.single
+// RUN: pylir-opt %s --pylir-monomorph --split-input-file > %t.multi
+// RUN: diff %t.single %t.multi
+// RUN: FileCheck %s --input-file %t.multi
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+py.globalValue @builtins.str = #py.type
+
+func.func @foo(%arg0 : !py.dynamic) -> !py.dynamic {
+	%0 = py.constant(#py.int<1>)
+	%1 = py.int.add %arg0, %0
+	return %1 : !py.dynamic
+}
+
+func.func @bar(%arg0 : !py.dynamic) -> !py.dynamic {
+	%0 = py.constant(#py.str<"text">)
+	%1 = py.str.concat %arg0, %0
+	return %1 : !py.dynamic
+}
+
+func.func @__init__() -> !py.dynamic {
+	%0 = test.random
+	cf.cond_br %0, ^lhs, ^rhs
+
+^lhs:
+	%1 = py.constant(#py.int<0>)
+	%2 = py.call @foo(%1) : (!py.dynamic) -> !py.dynamic
+	%3 = py.typeOf %2
+	return %3 : !py.dynamic
+
+^rhs:
+	%4 = py.constant(#py.str<"value">)
+	%5 = py.call @bar(%4) : (!py.dynamic) -> !py.dynamic
+	%6 = py.typeOf %5
+	return %6 : !py.dynamic
+}
+
+// CHECK-LABEL: func @__init__
+// CHECK: %[[INT:.*]] = py.constant(@builtins.int)
+// CHECK: return %[[INT]]
+// CHECK: %[[STR:.*]] = py.constant(@builtins.str)
+// CHECK: return %[[STR]]
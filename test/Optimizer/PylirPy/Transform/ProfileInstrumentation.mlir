@@ -0,0 +1,25 @@
+// RUN: pylir-opt %s --pylir-profile-instrumentation | FileCheck %s
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+
+func.func @foo(%arg0 : !py.dynamic, %arg1 : !py.dynamic, %arg2 : !py.dynamic) -> !py.dynamic {
+    %0 = py.function.call %arg0(%arg0, %arg1, %arg2)
+    %1 = py.function.invoke %0(%0, %arg1, %arg2)
+        label ^continue unwind ^handler
+
+^continue:
+    return %1 : !py.dynamic
+
+^handler(%e : !py.dynamic):
+    return %e : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @foo
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-NEXT: %[[SITE0:.*]] = py.constant(#py.str<"foo#0">)
+// CHECK-NEXT: py.intr.profileCall %[[ARG0]] at %[[SITE0]]
+// CHECK-NEXT: %[[RESULT:.*]] = py.function.call %[[ARG0]]
+// CHECK-NEXT: %[[SITE1:.*]] = py.constant(#py.str<"foo#1">)
+// CHECK-NEXT: py.intr.profileCall %[[RESULT]] at %[[SITE1]]
+// CHECK-NEXT: py.function.invoke %[[RESULT]]
@@ -0,0 +1,68 @@
+// RUN: pylir-opt %s --pylir-profile-use="profile-file=%S/Inputs/profile-use.pylirprof" | FileCheck %s
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.function = #py.type
+
+py.globalValue @bar = #py.function<@bar$impl, qualName = #py.str<"bar">>
+py.globalValue @baz = #py.function<@baz$impl, qualName = #py.str<"baz">>
+
+func.func @bar$impl(%arg0 : !py.dynamic, %arg1 : !py.dynamic, %arg2 : !py.dynamic) -> !py.dynamic {
+    return %arg0 : !py.dynamic
+}
+
+func.func @baz$impl(%arg0 : !py.dynamic, %arg1 : !py.dynamic, %arg2 : !py.dynamic) -> !py.dynamic {
+    return %arg1 : !py.dynamic
+}
+
+func.func @foo(%arg0 : !py.dynamic, %arg1 : !py.dynamic, %arg2 : !py.dynamic) -> !py.dynamic {
+    %0 = py.function.call %arg0(%arg0, %arg1, %arg2)
+    %1 = py.function.call %0(%0, %arg1, %arg2)
+    %2 = py.function.call %1(%1, %arg1, %arg2)
+    %3 = py.function.invoke %2(%2, %arg1, %arg2)
+        label ^continue unwind ^handler
+
+^continue:
+    return %3 : !py.dynamic
+
+^handler(%e : !py.dynamic):
+    return %e : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @foo
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]: !py.dynamic
+// CHECK-SAME: %[[ARG1:[[:alnum:]]+]]: !py.dynamic
+// CHECK-SAME: %[[ARG2:[[:alnum:]]+]]: !py.dynamic
+// CHECK-NEXT: %[[BAR:.*]] = py.constant(@bar)
+// CHECK-NEXT: %[[IS:.*]] = py.is %[[ARG0]], %[[BAR]]
+// CHECK-NEXT: cf.cond_br %[[IS]], ^[[FAST:[[:alnum:]]+]], ^[[SLOW:[[:alnum:]]+]]
+// CHECK-SAME: py.branch_weights = dense<[950, 50]> : vector<2xi32>
+// CHECK-NEXT: ^[[FAST]]:
+// CHECK-NEXT: %[[DIRECT:.*]] = py.call @bar$impl(%[[BAR]], %[[ARG1]], %[[ARG2]])
+// CHECK-SAME: py.profile_count = 950
+// CHECK-NEXT: cf.br ^[[CONTINUE:[[:alnum:]]+]](%[[DIRECT]] : !py.dynamic)
+// CHECK-NEXT: ^[[SLOW]]:
+// CHECK-NEXT: %[[INDIRECT:.*]] = py.function.call %[[ARG0]](%[[ARG0]], %[[ARG1]], %[[ARG2]])
+// CHECK-NEXT: cf.br ^[[CONTINUE]](%[[INDIRECT]] : !py.dynamic)
+// CHECK-NEXT: ^[[CONTINUE]](%[[RESULT0:[[:alnum:]]+]]: !py.dynamic):
+// CHECK-NEXT: %[[RESULT1:.*]] = py.function.call %[[RESULT0]](%[[RESULT0]], %[[ARG1]], %[[ARG2]])
+// CHECK-NEXT: %[[RESULT2:.*]] = py.function.call %[[RESULT1]](%[[RESULT1]], %[[ARG1]], %[[ARG2]])
+// CHECK-NEXT: %[[BAR:.*]] = py.constant(@bar)
+// CHECK-NEXT: %[[IS:.*]] = py.is %[[RESULT2]], %[[BAR]]
+// CHECK-NEXT: cf.cond_br %[[IS]], ^[[FAST:[[:alnum:]]+]], ^[[SLOW:[[:alnum:]]+]]
+// CHECK-SAME: py.branch_weights = dense<[1073741824, 0]> : vector<2xi32>
+// CHECK-NEXT: ^[[FAST]]:
+// CHECK-NEXT: %[[DIRECT:.*]] = py.invoke @bar$impl(%[[BAR]], %[[ARG1]], %[[ARG2]])
+// CHECK-SAME: py.profile_count = 4294967296
+// CHECK-NEXT: label ^[[FAST_CONTINUE:[[:alnum:]]+]] unwind ^[[HANDLER:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[SLOW]]:
+// CHECK-NEXT: %[[INDIRECT:.*]] = py.function.invoke %[[RESULT2]](%[[RESULT2]], %[[ARG1]], %[[ARG2]])
+// CHECK-NEXT: label ^[[SLOW_CONTINUE:[[:alnum:]]+]] unwind ^[[HANDLER]]
+// CHECK-NEXT: ^[[FAST_CONTINUE]]:
+// CHECK-NEXT: cf.br ^[[CONTINUE:[[:alnum:]]+]](%[[DIRECT]] : !py.dynamic)
+// CHECK-NEXT: ^[[SLOW_CONTINUE]]:
+// CHECK-NEXT: cf.br ^[[CONTINUE]](%[[INDIRECT]] : !py.dynamic)
+// CHECK-NEXT: ^[[CONTINUE]](%[[RESULT3:[[:alnum:]]+]]: !py.dynamic):
+// CHECK-NEXT: cf.br ^[[RETURN:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[RETURN]]:
+// CHECK-NEXT: return %[[RESULT3]]
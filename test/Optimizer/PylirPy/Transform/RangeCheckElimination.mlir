@@ -0,0 +1,101 @@
+// RUN: pylir-opt %s -pass-pipeline="any(pylir-range-check-elimination,canonicalize)" --split-input-file | FileCheck %s
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+py.globalValue @builtins.tuple = #py.type
+py.globalValue @builtins.IndexError = #py.type
+
+func.func @py_int_loop(%tuple : !py.dynamic) -> !py.dynamic {
+    %zero = py.constant(#py.int<0>)
+    %one = py.constant(#py.int<1>)
+    %len = py.tuple.len %tuple
+    %n = py.int.fromInteger %len : index
+    cf.br ^condition(%zero : !py.dynamic)
+
+^condition(%i : !py.dynamic):
+    %0 = py.int.cmp lt %i, %n
+    cf.cond_br %0, ^body, ^exit
+
+^body:
+    %1 = py.int.cmp lt %i, %zero
+    cf.cond_br %1, ^raise, ^check_bounds
+
+^check_bounds:
+    %2 = py.int.cmp ge %i, %n
+    cf.cond_br %2, ^raise, ^access
+
+^access:
+    %3, %ok = py.int.toInteger %i : index
+    %4 = py.tuple.getItem %tuple[%3]
+    test.use(%4) : !py.dynamic
+    %5 = py.int.add %i, %one
+    cf.br ^condition(%5 : !py.dynamic)
+
+^raise:
+    %6 = py.constant(@builtins.IndexError)
+    py.raise %6
+
+^exit:
+    return %i : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @py_int_loop
+// CHECK-SAME: %[[TUPLE:[[:alnum:]]+]]
+// CHECK: ^[[CONDITION:.*]](%[[I:.*]]: !py.dynamic):
+// CHECK-NEXT: %[[CMP:.*]] = py.int.cmp lt %[[I]], %{{.*}}
+// CHECK-NEXT: cf.cond_br %[[CMP]], ^[[BODY:[[:alnum:]]+]], ^[[EXIT:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[BODY]]:
+// CHECK-NEXT: %[[INDEX:.*]], %{{.*}} = py.int.toInteger %[[I]] : index
+// CHECK-NEXT: %[[ITEM:.*]] = py.tuple.getItem %[[TUPLE]][%[[INDEX]]]
+// CHECK-NEXT: test.use(%[[ITEM]])
+// CHECK-NEXT: %[[NEXT:.*]] = py.int.add %[[I]], %{{.*}}
+// CHECK-NEXT: cf.br ^[[CONDITION]](%[[NEXT]] : !py.dynamic)
+// CHECK-NOT: py.raise
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.IndexError = #py.type
+
+func.func @index_loop(%list : !py.dynamic) -> !py.dynamic {
+    %zero = arith.constant 0 : index
+    %one = arith.constant 1 : index
+    %len = py.list.len %list
+    cf.br ^condition(%zero : index)
+
+^condition(%i : index):
+    %0 = arith.cmpi ult, %i, %len : index
+    cf.cond_br %0, ^body, ^exit
+
+^body:
+    %1 = arith.cmpi uge, %i, %len : index
+    cf.cond_br %1, ^raise, ^access
+
+^access:
+    %2 = py.list.getItem %list[%i]
+    test.use(%2) : !py.dynamic
+    %3 = arith.addi %i, %one : index
+    %4 = arith.cmpi ult, %3, %len : index
+    cf.cond_br %4, ^next, ^raise
+
+^next:
+    %5 = py.list.getItem %list[%3]
+    test.use(%5) : !py.dynamic
+    cf.br ^condition(%3 : index)
+
+^raise:
+    %6 = py.constant(@builtins.IndexError)
+    py.raise %6
+
+^exit:
+    return %list : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @index_loop
+// CHECK: arith.cmpi ult
+// CHECK-NOT: arith.cmpi uge
+// CHECK: py.list.getItem
+// CHECK: %[[NEXT:.*]] = arith.addi
+// CHECK-NEXT: %[[CMP:.*]] = arith.cmpi ult, %[[NEXT]]
+// CHECK-NEXT: cf.cond_br %[[CMP]]
+// CHECK: py.raise
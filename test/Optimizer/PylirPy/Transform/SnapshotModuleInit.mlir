@@ -0,0 +1,137 @@
+// RUN: pylir-opt %s --pylir-snapshot-module-init --split-input-file | FileCheck %s
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.list = #py.type
+py.globalValue @builtins.dict = #py.type
+
+py.globalHandle "private" @foo
+py.globalHandle "private" @bar
+
+func.func @__init__() {
+    %0 = py.constant(#py.int<5>)
+    %1 = py.constant(#py.str<"text">)
+    %2 = py.makeList (%0, %1)
+    py.store %2 into @foo
+    %3 = py.makeDict (%1 : %0)
+    py.store %3 into @bar
+    return
+}
+
+func.func @test() -> !py.dynamic {
+    %0 = py.load @foo
+    return %0 : !py.dynamic
+}
+
+// CHECK-DAG: py.globalValue "private" @foo = #py.list<[#py.int<5>, #py.str<"text">]>
+// CHECK-DAG: py.globalValue "private" @bar = #py.dict<{#py.str<"text"> to #py.int<5>}>
+
+// CHECK-LABEL: @__init__
+// CHECK-NOT: py.makeList
+// CHECK-NOT: py.makeDict
+// CHECK-NOT: py.store
+// CHECK: return
+
+// CHECK-LABEL: @test
+// CHECK-NEXT: %[[C:.*]] = py.constant(@foo)
+// CHECK-NEXT: return %[[C]]
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.function = #py.type
+py.globalValue @builtins.None = #py.type
+
+func.func @real(%arg0 : !py.dynamic, %arg1 : !py.dynamic, %arg2 : !py.dynamic) -> !py.dynamic {
+    return %arg0 : !py.dynamic
+}
+
+py.globalHandle "private" @foo
+
+func.func @__init__() {
+    %0 = py.makeFunc @real
+    %1 = py.typeOf %0
+    %2 = py.constant(#py.str<"real">)
+    py.setSlot "__qualname__" of %0 : %1 to %2
+    py.store %0 into @foo
+    return
+}
+
+// CHECK: py.globalValue "private" @foo = #py.function<@real>
+
+// CHECK-LABEL: @__init__
+// CHECK-NEXT: %[[C:.*]] = py.constant(@foo)
+// CHECK-NEXT: %[[TYPE:.*]] = py.typeOf %[[C]]
+// CHECK-NEXT: %[[STR:.*]] = py.constant(#py.str<"real">)
+// CHECK-NEXT: py.setSlot "__qualname__" of %[[C]] : %[[TYPE]] to %[[STR]]
+// CHECK-NEXT: return
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+py.globalValue @builtins.list = #py.type
+
+py.globalHandle "private" @foo
+py.globalHandle "private" @bar
+
+func.func @__init__() {
+    %0 = py.constant(#py.int<5>)
+    cf.br ^bb1
+
+^bb1:
+    %1 = py.makeList (%0)
+    py.store %1 into @foo
+    return
+}
+
+func.func @test(%arg0 : !py.dynamic) {
+    %0 = py.makeList (%arg0)
+    py.store %0 into @bar
+    return
+}
+
+// CHECK: py.globalHandle "private" @foo
+// CHECK: py.globalHandle "private" @bar
+
+// CHECK-LABEL: @__init__
+// CHECK: py.makeList
+// CHECK: py.store %{{.*}} into @foo
+
+// CHECK-LABEL: @test
+// CHECK: py.makeList
+// CHECK: py.store %{{.*}} into @bar
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+py.globalValue @builtins.bool = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.dict = #py.type
+py.globalValue @builtins.None = #py.type
+
+py.globalHandle "private" @duplicates
+py.globalHandle "private" @mixed
+py.globalHandle "private" @reference
+
+func.func @__init__() {
+    %0 = py.constant(#py.str<"text">)
+    %1 = py.constant(#py.int<1>)
+    %2 = py.constant(#py.int<2>)
+    %3 = py.makeDict (%0 : %1, %1 : %1, %0 : %2)
+    py.store %3 into @duplicates
+    %4 = py.constant(#py.bool<True>)
+    %5 = py.makeDict (%1 : %1, %4 : %2)
+    py.store %5 into @mixed
+    %6 = py.constant(@builtins.None)
+    %7 = py.makeDict (%6 : %1)
+    py.store %7 into @reference
+    return
+}
+
+// CHECK-DAG: py.globalValue "private" @duplicates = #py.dict<{#py.str<"text"> to #py.int<2>, #py.int<1> to #py.int<1>}>
+// CHECK-DAG: py.globalHandle "private" @mixed
+// CHECK-DAG: py.globalHandle "private" @reference
@@ -0,0 +1,29 @@
+// RUN: rm -f %t.cache
+// RUN: pylir-opt %s --pylir-trial-inliner="min-callee-size-reduction=0 cache-file=%t.cache" -mlir-pass-statistics \
+// RUN:   > %t.first 2> %t.stats
+// RUN: FileCheck %s --check-prefix=MISS --input-file %t.stats
+// RUN: pylir-opt %s --pylir-trial-inliner="min-callee-size-reduction=0 cache-file=%t.cache" -mlir-pass-statistics \
+// RUN:   > %t.second 2> %t.stats
+// RUN: FileCheck %s --check-prefix=HIT --input-file %t.stats
+// RUN: diff %t.first %t.second
+// RUN: FileCheck %s --input-file %t.second
+
+// MISS-DAG: {{[[:space:]]}}0 Cache hits
+// MISS-DAG: {{[[:space:]]}}1 Caches misses
+
+// HIT-DAG: {{[[:space:]]}}1 Cache hits
+// HIT-DAG: {{[[:space:]]}}0 Caches misses
+
+func.func @foo() -> i32 {
+	%0 = arith.constant 5 : i32
+	return %0 : i32
+}
+
+func.func @test() -> i32 {
+	%0 = call @foo() : () -> i32
+	return %0 : i32
+}
+
+// CHECK-LABEL: @test
+// CHECK-NEXT: %[[C:.*]] = arith.constant 5
+// CHECK-NEXT: return %[[C]]
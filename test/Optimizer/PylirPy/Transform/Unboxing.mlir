@@ -0,0 +1,99 @@
+// RUN: pylir-opt %s -pass-pipeline="any(pylir-unboxing)" --split-input-file | FileCheck %s
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+
+func.func @loop(%arg0 : i64) -> !py.dynamic {
+    %zero = py.constant(#py.int<0>)
+    %one = py.constant(#py.int<1>)
+    %n = py.int.fromInteger %arg0 : i64
+    cf.br ^condition(%zero : !py.dynamic)
+
+^condition(%i : !py.dynamic):
+    %0 = py.int.cmp lt %i, %n
+    cf.cond_br %0, ^body, ^exit
+
+^body:
+    %1 = py.int.add %i, %one
+    cf.br ^condition(%1 : !py.dynamic)
+
+^exit:
+    return %i : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @loop
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK: cf.br ^[[CONDITION:[[:alnum:]]+]](%{{.*}}, %{{.*}} : i64, !py.dynamic)
+// CHECK: ^[[CONDITION]](%[[SMALL:[[:alnum:]]+]]: i64, %[[BOXED:[[:alnum:]]+]]: !py.dynamic):
+// CHECK: %[[CMP:.*]] = arith.cmpi ult, %[[SMALL]], %[[ARG0]]
+// CHECK: cf.cond_br %{{.*}}, ^{{.*}}(%[[CMP]] : i1), ^{{.*}}
+// CHECK: py.int.cmp lt
+// CHECK: %[[SUM:.*]] = arith.addi %[[SMALL]], %{{.*}}
+// CHECK: %[[NO_OVERFLOW:.*]] = arith.cmpi uge, %[[SUM]], %[[SMALL]]
+// CHECK: %[[FAST:.*]] = arith.andi %{{.*}}, %[[NO_OVERFLOW]]
+// CHECK: cf.cond_br %[[FAST]], ^{{.*}}(%[[SUM]], %{{.*}} : i64, !py.dynamic), ^{{.*}}
+// CHECK: py.int.add
+// CHECK: py.isUnboundValue %[[BOXED]]
+// CHECK: py.int.fromInteger %[[SMALL]] : i64
+// CHECK: return
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.int = #py.type
+
+func.func @escaping_constant(%arg0 : i1) -> !py.dynamic {
+    %zero = py.constant(#py.int<0>)
+    %one = py.constant(#py.int<1>)
+    cf.cond_br %arg0, ^bb1(%zero : !py.dynamic), ^bb1(%one : !py.dynamic)
+
+^bb1(%0 : !py.dynamic):
+    %1 = py.int.cmp eq %0, %one
+    cf.cond_br %1, ^bb2, ^bb3
+
+^bb2:
+    return %0 : !py.dynamic
+
+^bb3:
+    return %one : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @escaping_constant
+// CHECK-DAG: %[[ZERO:.*]] = arith.constant 0 : i64
+// CHECK-DAG: %[[ONE:.*]] = arith.constant 1 : i64
+// CHECK: cf.cond_br %{{.*}}, ^[[BB1:.*]](%[[ZERO]], %{{.*}} : i64, !py.dynamic), ^[[BB1]](%[[ONE]], %{{.*}} : i64, !py.dynamic)
+// CHECK: ^[[BB1]](%[[SMALL:[[:alnum:]]+]]: i64, %{{.*}}: !py.dynamic):
+// CHECK: arith.cmpi eq, %[[SMALL]]
+// CHECK: py.int.fromInteger %[[SMALL]] : i64
+// CHECK: return
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.bool = #py.type
+
+func.func @bool_arg(%arg0 : i1, %arg1 : i1) -> !py.dynamic {
+    %0 = py.bool.fromI1 %arg0
+    %1 = py.constant(#py.bool<False>)
+    cf.cond_br %arg1, ^bb1(%0 : !py.dynamic), ^bb1(%1 : !py.dynamic)
+
+^bb1(%2 : !py.dynamic):
+    %3 = py.bool.toI1 %2
+    cf.cond_br %3, ^bb2, ^bb3
+
+^bb2:
+    return %2 : !py.dynamic
+
+^bb3:
+    return %1 : !py.dynamic
+}
+
+// CHECK-LABEL: func.func @bool_arg
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-SAME: %[[ARG1:[[:alnum:]]+]]
+// CHECK: %[[FALSE:.*]] = arith.constant false
+// CHECK: cf.cond_br %[[ARG1]], ^[[BB1:.*]](%[[ARG0]] : i1), ^[[BB1]](%[[FALSE]] : i1)
+// CHECK: ^[[BB1]](%[[UNBOXED:[[:alnum:]]+]]: i1):
+// CHECK-NEXT: %[[BOXED:.*]] = py.bool.fromI1 %[[UNBOXED]]
+// CHECK-NEXT: cf.cond_br %[[UNBOXED]]
+// CHECK: return %[[BOXED]]
@@ -0,0 +1,289 @@
+// RUN: pylir-opt %s -pass-pipeline='func.func(pylir-dead-store-elimination)' --split-input-file | FileCheck %s
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+
+func.func @test_set_slot_overwritten(%arg0 : !py.dynamic) -> !py.dynamic {
+    %0 = py.constant(#py.str<"first">)
+    %1 = py.constant(#py.str<"second">)
+    %2 = py.typeOf %arg0
+    py.setSlot "test" of %arg0 : %2 to %0
+    py.setSlot "other" of %arg0 : %2 to %0
+    py.setSlot "test" of %arg0 : %2 to %1
+    return %arg0 : !py.dynamic
+}
+
+// CHECK-LABEL: @test_set_slot_overwritten
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK: %[[FIRST:.*]] = py.constant(#py.str<"first">)
+// CHECK: %[[SECOND:.*]] = py.constant(#py.str<"second">)
+// CHECK-NOT: py.setSlot "test" of %[[ARG0]] : %{{.*}} to %[[FIRST]]
+// CHECK: py.setSlot "other" of %[[ARG0]] : %{{.*}} to %[[FIRST]]
+// CHECK-NEXT: py.setSlot "test" of %[[ARG0]] : %{{.*}} to %[[SECOND]]
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+
+func.func @test_set_slot_read(%arg0 : !py.dynamic) -> !py.dynamic {
+    %0 = py.constant(#py.str<"first">)
+    %1 = py.constant(#py.str<"second">)
+    %2 = py.typeOf %arg0
+    py.setSlot "test" of %arg0 : %2 to %0
+    %3 = py.getSlot "test" from %arg0 : %2
+    py.setSlot "test" of %arg0 : %2 to %1
+    return %3 : !py.dynamic
+}
+
+// CHECK-LABEL: @test_set_slot_read
+// CHECK: py.setSlot "test"
+// CHECK: py.getSlot "test"
+// CHECK: py.setSlot "test"
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+
+func.func private @bar()
+
+func.func @test_set_slot_call(%arg0 : !py.dynamic) -> !py.dynamic {
+    %0 = py.constant(#py.str<"first">)
+    %1 = py.constant(#py.str<"second">)
+    %2 = py.typeOf %arg0
+    py.setSlot "test" of %arg0 : %2 to %0
+    call @bar() : () -> ()
+    py.setSlot "test" of %arg0 : %2 to %1
+    return %arg0 : !py.dynamic
+}
+
+// CHECK-LABEL: @test_set_slot_call
+// CHECK: py.setSlot "test"
+// CHECK: call @bar
+// CHECK: py.setSlot "test"
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+
+func.func @test_set_slot_control_flow(%arg0 : !py.dynamic, %arg1 : i1) -> !py.dynamic {
+    %0 = py.constant(#py.str<"first">)
+    %1 = py.constant(#py.str<"second">)
+    %2 = py.typeOf %arg0
+    py.setSlot "test" of %arg0 : %2 to %0
+    cf.cond_br %arg1, ^bb1, ^bb2
+
+^bb1:
+    py.setSlot "test" of %arg0 : %2 to %1
+    return %arg0 : !py.dynamic
+
+^bb2:
+    return %arg0 : !py.dynamic
+}
+
+// CHECK-LABEL: @test_set_slot_control_flow
+// CHECK: py.setSlot "test"
+// CHECK: py.setSlot "test"
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.dict = #py.type
+
+func.func @test_dict_set_item(%arg0 : !py.dynamic) -> !py.dynamic {
+    %0 = py.constant(#py.str<"first">)
+    %1 = py.constant(#py.str<"second">)
+    py.dict.setItem %arg0[%1] to %0
+    py.dict.setItem %arg0[%1] to %1
+    py.dict.setItem %arg0[%0] to %1
+    %2 = py.dict.delItem %0 from %arg0
+    return %arg0 : !py.dynamic
+}
+
+// CHECK-LABEL: @test_dict_set_item
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK: %[[FIRST:.*]] = py.constant(#py.str<"first">)
+// CHECK: %[[SECOND:.*]] = py.constant(#py.str<"second">)
+// CHECK-NEXT: py.dict.setItem %[[ARG0]][%[[SECOND]]] to %[[SECOND]]
+// CHECK-NEXT: py.dict.delItem %[[FIRST]] from %[[ARG0]]
+// CHECK-NEXT: return
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.dict = #py.type
+
+func.func @test_dict_set_item_unknown_key(%arg0 : !py.dynamic, %arg1 : !py.dynamic) -> !py.dynamic {
+    %0 = py.constant(#py.str<"first">)
+    %1 = py.constant(#py.str<"second">)
+    py.dict.setItem %arg0[%arg1] to %0
+    py.dict.setItem %arg0[%arg1] to %1
+    py.dict.setItem %arg0[%0] to %0
+    py.dict.setItem %arg0[%arg1] to %0
+    py.dict.setItem %arg0[%0] to %1
+    return %arg0 : !py.dynamic
+}
+
+// The hash and equality implementations of unknown keys may execute arbitrary code, including reading the dictionary.
+
+// CHECK-LABEL: @test_dict_set_item_unknown_key
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-SAME: %[[ARG1:[[:alnum:]]+]]
+// CHECK: %[[FIRST:.*]] = py.constant(#py.str<"first">)
+// CHECK: %[[SECOND:.*]] = py.constant(#py.str<"second">)
+// CHECK-NEXT: py.dict.setItem %[[ARG0]][%[[ARG1]]] to %[[FIRST]]
+// CHECK-NEXT: py.dict.setItem %[[ARG0]][%[[ARG1]]] to %[[SECOND]]
+// CHECK-NEXT: py.dict.setItem %[[ARG0]][%[[FIRST]]] to %[[FIRST]]
+// CHECK-NEXT: py.dict.setItem %[[ARG0]][%[[ARG1]]] to %[[FIRST]]
+// CHECK-NEXT: py.dict.setItem %[[ARG0]][%[[FIRST]]] to %[[SECOND]]
+// CHECK-NEXT: return
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.dict = #py.type
+
+func.func @test_dict_del_item_existed(%arg0 : !py.dynamic) -> (!py.dynamic, i1) {
+    %0 = py.constant(#py.str<"first">)
+    py.dict.setItem %arg0[%0] to %0
+    %1 = py.dict.delItem %0 from %arg0
+    py.dict.setItem %arg0[%0] to %0
+    return %arg0, %1 : !py.dynamic, i1
+}
+
+// CHECK-LABEL: @test_dict_del_item_existed
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK: %[[FIRST:.*]] = py.constant(#py.str<"first">)
+// CHECK-NEXT: py.dict.setItem %[[ARG0]][%[[FIRST]]] to %[[FIRST]]
+// CHECK-NEXT: %[[EXISTED:.*]] = py.dict.delItem %[[FIRST]] from %[[ARG0]]
+// CHECK-NEXT: py.dict.setItem %[[ARG0]][%[[FIRST]]] to %[[FIRST]]
+// CHECK-NEXT: return %[[ARG0]], %[[EXISTED]]
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.list = #py.type
+
+func.func @test_list_set_item(%arg0 : !py.dynamic, %arg1 : index) -> !py.dynamic {
+    %0 = py.constant(#py.str<"first">)
+    %1 = py.constant(#py.str<"second">)
+    py.list.setItem %arg0[%arg1] to %0
+    %2 = py.list.len %arg0
+    py.list.setItem %arg0[%arg1] to %1
+    return %arg0 : !py.dynamic
+}
+
+// CHECK-LABEL: @test_list_set_item
+// CHECK: py.list.setItem
+// CHECK: py.list.len
+// CHECK: py.list.setItem
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalHandle @handle
+py.globalHandle @other
+
+func.func @test_store(%arg0 : !py.dynamic) {
+    %0 = py.constant(#py.str<"first">)
+    py.store %0 into @handle
+    py.store %0 into @other
+    py.store %arg0 into @handle
+    return
+}
+
+// CHECK-LABEL: @test_store
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK: %[[FIRST:.*]] = py.constant(#py.str<"first">)
+// CHECK-NEXT: py.store %[[FIRST]] into @other
+// CHECK-NEXT: py.store %[[ARG0]] into @handle
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @foo = #py.type<slots = {__slots__ = #py.tuple<(#py.str<"test">)>}>
+
+func.func @test_non_escaping(%arg0 : !py.dynamic) -> !py.dynamic {
+    %0 = py.constant(@foo)
+    %1 = py.makeObject %0
+    %2 = py.typeOf %1
+    py.setSlot "test" of %1 : %0 to %arg0
+    %3 = py.makeObject %0
+    py.setSlot "test" of %3 : %0 to %arg0
+    return %3 : !py.dynamic
+}
+
+// CHECK-LABEL: @test_non_escaping
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK: %[[TYPE:.*]] = py.constant(@foo)
+// CHECK-NEXT: py.makeObject %[[TYPE]]
+// CHECK-NEXT: py.typeOf
+// CHECK-NEXT: %[[ESCAPING:.*]] = py.makeObject %[[TYPE]]
+// CHECK-NEXT: py.setSlot "test" of %[[ESCAPING]] : %[[TYPE]] to %[[ARG0]]
+// CHECK-NEXT: return %[[ESCAPING]]
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.dict = #py.type
+
+func.func @test_local_dict_del_item_existed() -> i1 {
+    %0 = py.constant(#py.str<"first">)
+    %1 = py.makeDict ()
+    py.dict.setItem %1[%0] to %0
+    %2 = py.dict.delItem %0 from %1
+    return %2 : i1
+}
+
+// CHECK-LABEL: @test_local_dict_del_item_existed
+// CHECK: %[[DICT:.*]] = py.makeDict ()
+// CHECK-NEXT: py.dict.setItem %[[DICT]]
+// CHECK-NEXT: %[[EXISTED:.*]] = py.dict.delItem %{{.*}} from %[[DICT]]
+// CHECK-NEXT: return %[[EXISTED]]
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.dict = #py.type
+
+func.func @test_local_dict_del_item() {
+    %0 = py.constant(#py.str<"first">)
+    %1 = py.makeDict ()
+    py.dict.setItem %1[%0] to %0
+    %2 = py.dict.delItem %0 from %1
+    return
+}
+
+// CHECK-LABEL: @test_local_dict_del_item
+// CHECK-NOT: py.dict.setItem
+// CHECK: return
+
+// -----
+
+py.globalValue @builtins.type = #py.type
+py.globalValue @builtins.str = #py.type
+py.globalValue @builtins.dict = #py.type
+
+func.func @test_local_dict_unknown_key(%arg0 : !py.dynamic) {
+    %0 = py.constant(#py.str<"first">)
+    %1 = py.makeDict ()
+    py.dict.setItem %1[%0] to %0
+    py.dict.setItem %1[%arg0] to %0
+    return
+}
+
+// CHECK-LABEL: @test_local_dict_unknown_key
+// CHECK: %[[DICT:.*]] = py.makeDict ()
+// CHECK-NEXT: py.dict.setItem %[[DICT]]
+// CHECK-NEXT: py.dict.setItem %[[DICT]]
+// CHECK-NEXT: return
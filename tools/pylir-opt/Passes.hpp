@@ -10,6 +10,11 @@
 #include <mlir/IR/FunctionInterfaces.h>
 #include <mlir/Pass/Pass.h>
 
+namespace mlir::cf
+{
+class ControlFlowDialect;
+}
+
 namespace pylir::MemSSA
 {
 class MemorySSADialect;
@@ -0,0 +1,94 @@
+// Copyright 2022 Markus Böck
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/Dialect/ControlFlow/IR/ControlFlowOps.h>
+#include <mlir/IR/BuiltinOps.h>
+#include <mlir/IR/FunctionInterfaces.h>
+#include <mlir/Pass/Pass.h>
+
+#include <pylir/Optimizer/Analysis/MemorySSA.hpp>
+
+#include <memory>
+
+#include "Passes.hpp"
+
+namespace
+{
+
+class TestMemorySSAUpdater : public TestMemorySSAUpdaterBase<TestMemorySSAUpdater>
+{
+protected:
+    void runOnOperation() override;
+};
+
+void TestMemorySSAUpdater::runOnOperation()
+{
+    for (auto func : getOperation().getOps<mlir::FunctionOpInterface>())
+    {
+        auto& memorySSA = getChildAnalysis<pylir::MemorySSA>(func);
+
+        llvm::SmallVector<mlir::Operation*> splits;
+        llvm::SmallVector<mlir::Operation*> duplicates;
+        llvm::SmallVector<mlir::Operation*> sinks;
+        llvm::SmallVector<mlir::Operation*> erasures;
+        func->walk(
+            [&](mlir::Operation* op)
+            {
+                if (op->hasAttr("test.split"))
+                {
+                    splits.push_back(op);
+                }
+                if (op->hasAttr("test.duplicate"))
+                {
+                    duplicates.push_back(op);
+                }
+                if (op->hasAttr("test.sink"))
+                {
+                    sinks.push_back(op);
+                }
+                if (op->hasAttr("test.erase"))
+                {
+                    erasures.push_back(op);
+                }
+            });
+
+        for (auto* op : splits)
+        {
+            auto* block = op->getBlock();
+            auto* newBlock = block->splitBlock(op);
+            mlir::OpBuilder builder = mlir::OpBuilder::atBlockEnd(block);
+            builder.create<mlir::cf::BranchOp>(op->getLoc(), newBlock);
+            memorySSA.splitBlock(block, newBlock);
+        }
+        for (auto* op : duplicates)
+        {
+            mlir::OpBuilder builder(op->getContext());
+            builder.setInsertionPointAfter(op);
+            auto* clone = builder.clone(*op);
+            clone->removeAttr("test.duplicate");
+            memorySSA.insertAccess(clone);
+        }
+        // Sinks the operation to the start of the first successor of its block.
+        for (auto* op : sinks)
+        {
+            memorySSA.removeAccess(op);
+            op->moveBefore(&op->getBlock()->getSuccessor(0)->front());
+            memorySSA.insertAccess(op);
+        }
+        for (auto* op : erasures)
+        {
+            memorySSA.removeAccess(op);
+            op->erase();
+        }
+        llvm::outs() << memorySSA;
+    }
+}
+} // namespace
+
+std::unique_ptr<mlir::Pass> createTestMemorySSAUpdater()
+{
+    return std::make_unique<TestMemorySSAUpdater>();
+}
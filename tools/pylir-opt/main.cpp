@@ -12,6 +12,7 @@
 
 #include <pylir/Optimizer/Conversion/Passes.hpp>
 #include <pylir/Optimizer/PylirMem/IR/PylirMemDialect.hpp>
+#include <pylir/Optimizer/PylirMem/Transforms/Passes.hpp>
 #include <pylir/Optimizer/PylirPy/IR/PylirPyDialect.hpp>
 #include <pylir/Optimizer/PylirPy/Transforms/Passes.hpp>
 #include <pylir/Optimizer/Transforms/Passes.hpp>
@@ -20,6 +21,8 @@
 
 std::unique_ptr<mlir::Pass> createTestMemorySSA();
 
+std::unique_ptr<mlir::Pass> createTestMemorySSAUpdater();
+
 std::unique_ptr<mlir::Pass> createTestInlinerInterface();
 
 std::unique_ptr<mlir::Pass> createTestTypeFlow();
@@ -44,6 +47,7 @@ int main(int argc, char** argv)
     pylir::registerConversionPasses();
     pylir::registerTransformPasses();
     pylir::Py::registerTransformPasses();
+    pylir::Mem::registerTransformPasses();
     ::registerTestPasses();
 
     return mlir::failed(mlir::MlirOptMain(argc, argv, "Standalone optimizer driver\n", registry));
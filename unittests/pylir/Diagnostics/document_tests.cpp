@@ -35,13 +35,13 @@ TEST_CASE("Document BOM detection", "[Document]")
     {
         std::string bytes{"\xFF\xFE\x00\x00\x54\x00\x00\x00\x65\x00\x00\x00\x78\x00\x00\x00\x74\x00\x00\x00", 20};
         pylir::Diag::Document document(bytes);
-        CHECK(document.getText() == U"Text");
+        CHECK(document.getText() == "Text");
     }
     SECTION("UTF32BE BOM")
     {
         std::string bytes{"\x00\x00\xFE\xFF\x00\x00\x00\x54\x00\x00\x00\x65\x00\x00\x00\x78\x00\x00\x00\x74", 20};
         pylir::Diag::Document document(bytes);
-        CHECK(document.getText() == U"Text");
+        CHECK(document.getText() == "Text");
     }
 }
 
@@ -50,5 +50,69 @@ TEST_CASE("Document line normalization", "[Document]")
     pylir::Diag::Document document("Windows\r\n"
                                    "Unix\n"
                                    "OldMac\r");
-    CHECK(document.getText() == U"Windows\nUnix\nOldMac\n");
+    CHECK(document.getText() == "Windows\nUnix\nOldMac\n");
+}
+
+TEST_CASE("Document UTF8 decoding", "[Document]")
+{
+    pylir::Diag::Document document("a = 'ä'\r\n"
+                                   "株式 = 3\n");
+    CHECK(document.getText() == "a = 'ä'\n株式 = 3\n");
+    CHECK(std::u32string(document.begin(), document.end()) == U"a = 'ä'\n株式 = 3\n");
+    CHECK(document.getLine(1) == "a = 'ä'");
+    CHECK(document.getLine(2) == "株式 = 3");
+    CHECK(document.getLineCol(15) == std::pair<std::size_t, std::size_t>{2, 3});
+}
+
+TEST_CASE("Document invalid UTF8", "[Document]")
+{
+    pylir::Diag::Document document("a\xFF = 3\r\n");
+    CHECK(document.getText() == "a\uFFFD = 3\n");
+    CHECK(std::u32string(document.begin(), document.end()) == U"a\uFFFD = 3\n");
+}
+
+TEST_CASE("Document null characters", "[Document]")
+{
+    SECTION("UTF8")
+    {
+        std::string bytes{"a\0b", 3};
+        pylir::Diag::Document document(bytes);
+        CHECK(document.getText() == std::string_view("a\0b", 3));
+    }
+    SECTION("UTF16LE")
+    {
+        std::string bytes{"\xFF\xFE\x61\x00\x00\x00\x62\x00", 8};
+        pylir::Diag::Document document(bytes);
+        CHECK(document.getText() == std::string_view("a\0b", 3));
+    }
+}
+
+TEST_CASE("Document line lookup", "[Document]")
+{
+    pylir::Diag::Document document("first\n"
+                                   "\n"
+                                   "a line that is longer than a single block\n"
+                                   "last");
+    SECTION("Sequential")
+    {
+        CHECK(document.getLineCol(0) == std::pair<std::size_t, std::size_t>{1, 1});
+        CHECK(document.getLineCol(5) == std::pair<std::size_t, std::size_t>{1, 6});
+        CHECK(document.getLineCol(6) == std::pair<std::size_t, std::size_t>{2, 1});
+        CHECK(document.getLineCol(7) == std::pair<std::size_t, std::size_t>{3, 1});
+        CHECK(document.getLineCol(10) == std::pair<std::size_t, std::size_t>{3, 4});
+        CHECK(document.getLineCol(49) == std::pair<std::size_t, std::size_t>{4, 1});
+        CHECK(document.getLineCol(53) == std::pair<std::size_t, std::size_t>{4, 5});
+    }
+    SECTION("Random access")
+    {
+        CHECK(document.getLineNumber(50) == 4);
+        CHECK(document.getLineNumber(2) == 1);
+        CHECK(document.getLineNumber(20) == 3);
+        CHECK(document.getLineNumber(6) == 2);
+        CHECK(document.getLineNumber(50) == 4);
+    }
+    CHECK(document.getLine(2).empty());
+    CHECK(document.getLine(4) == "last");
+    CHECK(document.hasLine(4));
+    CHECK_FALSE(document.hasLine(5));
 }
@@ -9,7 +9,11 @@
 #include <pylir/Diagnostics/DiagnosticMessages.hpp>
 #include <pylir/Lexer/Lexer.hpp>
 
+#include <llvm/Support/ThreadPool.h>
+
 #include <iostream>
+#include <limits>
+#include <unordered_map>
 
 #include <fmt/format.h>
 
@@ -22,7 +26,7 @@
         {                                                                     \
             if (token.getTokenType() == pylir::TokenType::SyntaxError)        \
             {                                                                 \
-                auto& error = std::get<std::string>(token.getValue());        \
+                auto& error = lexer.getTokenValues()->getString(token);       \
                 std::cerr << error;                                           \
                 CHECK_THAT(error, Catch::Contains(fmt::format(__VA_ARGS__))); \
                 return;                                                       \
@@ -44,7 +48,7 @@ TEST_CASE("Lex comments", "[Lexer]")
         CHECK(token.getTokenType() == pylir::TokenType::Newline);
         CHECK(token.getFileId() == 1);
         CHECK(token.getOffset() == 9);
-        CHECK(std::holds_alternative<std::monostate>(token.getValue()));
+        CHECK_FALSE(token.getValueIndex());
     }
     SECTION("Comment to end of file")
     {
@@ -56,7 +60,7 @@ TEST_CASE("Lex comments", "[Lexer]")
         CHECK(token.getTokenType() == pylir::TokenType::Newline);
         CHECK(token.getFileId() == 1);
         CHECK(token.getOffset() == 9);
-        CHECK(std::holds_alternative<std::monostate>(token.getValue()));
+        CHECK_FALSE(token.getValueIndex());
     }
 }
 
@@ -126,6 +130,26 @@ TEST_CASE("Lex line continuation", "[Lexer]")
 
 TEST_CASE("Lex identifiers", "[Lexer]")
 {
+    SECTION("ASCII")
+    {
+        pylir::Diag::Document document("_foo_Bar9");
+        pylir::Lexer lexer(document, 1);
+        std::vector result(lexer.begin(), lexer.end());
+        REQUIRE(result.size() == 2);
+        auto& identifier = result[0];
+        CHECK(identifier.getTokenType() == pylir::TokenType::Identifier);
+        CHECK(lexer.getTokenValues()->getString(identifier) == "_foo_Bar9");
+    }
+    SECTION("Mixed")
+    {
+        pylir::Diag::Document document("fooＢＡＲ");
+        pylir::Lexer lexer(document, 1);
+        std::vector result(lexer.begin(), lexer.end());
+        REQUIRE(result.size() == 2);
+        auto& identifier = result[0];
+        CHECK(identifier.getTokenType() == pylir::TokenType::Identifier);
+        CHECK(lexer.getTokenValues()->getString(identifier) == "fooBAR");
+    }
     SECTION("Unicode")
     {
         pylir::Diag::Document document("株式会社");
@@ -134,9 +158,7 @@ TEST_CASE("Lex identifiers", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& identifier = result[0];
         CHECK(identifier.getTokenType() == pylir::TokenType::Identifier);
-        const auto* str = std::get_if<std::string>(&identifier.getValue());
-        REQUIRE(str);
-        CHECK(*str == "株式会社");
+        CHECK(lexer.getTokenValues()->getString(identifier) == "株式会社");
     }
     SECTION("Normalized")
     {
@@ -146,9 +168,16 @@ TEST_CASE("Lex identifiers", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& identifier = result[0];
         CHECK(identifier.getTokenType() == pylir::TokenType::Identifier);
-        const auto* str = std::get_if<std::string>(&identifier.getValue());
-        REQUIRE(str);
-        CHECK(*str == "KADOKAWA");
+        CHECK(lexer.getTokenValues()->getString(identifier) == "KADOKAWA");
+    }
+    SECTION("Repeated")
+    {
+        pylir::Diag::Document document("foo bar foo");
+        pylir::Lexer lexer(document, 1);
+        std::vector result(lexer.begin(), lexer.end());
+        REQUIRE(result.size() == 4);
+        CHECK(result[0].getValueIndex() == result[2].getValueIndex());
+        CHECK(result[0].getValueIndex() != result[1].getValueIndex());
     }
 }
 
@@ -188,9 +217,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
             REQUIRE_FALSE(result.empty());
             auto& first = result[0];
             CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-            const auto* str = std::get_if<std::string>(&first.getValue());
-            REQUIRE(str);
-            CHECK(*str == "a text");
+            CHECK(lexer.getTokenValues()->getString(first) == "a text");
         }
         SECTION("Double quote")
         {
@@ -200,9 +227,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
             REQUIRE_FALSE(result.empty());
             auto& first = result[0];
             CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-            const auto* str = std::get_if<std::string>(&first.getValue());
-            REQUIRE(str);
-            CHECK(*str == "a text");
+            CHECK(lexer.getTokenValues()->getString(first) == "a text");
         }
         SECTION("Triple quote")
         {
@@ -212,9 +237,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
             REQUIRE_FALSE(result.empty());
             auto& first = result[0];
             CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-            const auto* str = std::get_if<std::string>(&first.getValue());
-            REQUIRE(str);
-            CHECK(*str == "a text");
+            CHECK(lexer.getTokenValues()->getString(first) == "a text");
         }
         SECTION("Triple double quote")
         {
@@ -224,9 +247,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
             REQUIRE_FALSE(result.empty());
             auto& first = result[0];
             CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-            const auto* str = std::get_if<std::string>(&first.getValue());
-            REQUIRE(str);
-            CHECK(*str == "a text");
+            CHECK(lexer.getTokenValues()->getString(first) == "a text");
         }
         LEXER_EMITS("'a text", pylir::Diag::EXPECTED_END_OF_LITERAL);
         LEXER_EMITS("'''a text", pylir::Diag::EXPECTED_END_OF_LITERAL);
@@ -241,9 +262,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
         REQUIRE_FALSE(result.empty());
         auto& first = result[0];
         CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-        const auto* str = std::get_if<std::string>(&first.getValue());
-        REQUIRE(str);
-        CHECK(*str == "\na text\n");
+        CHECK(lexer.getTokenValues()->getString(first) == "\na text\n");
         LEXER_EMITS("'a text\n'", pylir::Diag::NEWLINE_NOT_ALLOWED_IN_LITERAL);
     }
     SECTION("Simple escapes")
@@ -254,9 +273,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
         REQUIRE_FALSE(result.empty());
         auto& first = result[0];
         CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-        const auto* str = std::get_if<std::string>(&first.getValue());
-        REQUIRE(str);
-        CHECK(*str == "\\'\"\a\b\f\n\r\t\v\n");
+        CHECK(lexer.getTokenValues()->getString(first) == "\\'\"\a\b\f\n\r\t\v\n");
     }
     SECTION("Unicode name")
     {
@@ -266,9 +283,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
         REQUIRE_FALSE(result.empty());
         auto& first = result[0];
         CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-        const auto* str = std::get_if<std::string>(&first.getValue());
-        REQUIRE(str);
-        CHECK(*str == "\U0001F574");
+        CHECK(lexer.getTokenValues()->getString(first) == "\U0001F574");
         LEXER_EMITS("'\\N'", pylir::Diag::EXPECTED_OPEN_BRACE_AFTER_BACKSLASH_N);
         LEXER_EMITS("'\\N{wdwadwad}'", pylir::Diag::UNICODE_NAME_N_NOT_FOUND, "wdwadwad");
     }
@@ -280,9 +295,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
         REQUIRE_FALSE(result.empty());
         auto& first = result[0];
         CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-        const auto* str = std::get_if<std::string>(&first.getValue());
-        REQUIRE(str);
-        CHECK(*str == "§");
+        CHECK(lexer.getTokenValues()->getString(first) == "§");
     }
     SECTION("Octal characters")
     {
@@ -292,9 +305,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
         REQUIRE_FALSE(result.empty());
         auto& first = result[0];
         CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-        const auto* str = std::get_if<std::string>(&first.getValue());
-        REQUIRE(str);
-        CHECK(*str == "§");
+        CHECK(lexer.getTokenValues()->getString(first) == "§");
     }
     SECTION("Unicode escape")
     {
@@ -306,9 +317,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
             REQUIRE_FALSE(result.empty());
             auto& first = result[0];
             CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-            const auto* str = std::get_if<std::string>(&first.getValue());
-            REQUIRE(str);
-            CHECK(*str == "§");
+            CHECK(lexer.getTokenValues()->getString(first) == "§");
         }
         SECTION("Big")
         {
@@ -318,9 +327,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
             REQUIRE_FALSE(result.empty());
             auto& first = result[0];
             CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-            const auto* str = std::get_if<std::string>(&first.getValue());
-            REQUIRE(str);
-            CHECK(*str == "\U0001F574");
+            CHECK(lexer.getTokenValues()->getString(first) == "\U0001F574");
         }
         LEXER_EMITS("'\\u343'", pylir::Diag::EXPECTED_N_MORE_HEX_CHARACTERS, 1);
         LEXER_EMITS("'\\ud869'", pylir::Diag::U_PLUS_N_IS_NOT_A_VALID_UNICODE_CODEPOINT, 0xd869);
@@ -335,9 +342,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
             REQUIRE_FALSE(result.empty());
             auto& first = result[0];
             CHECK(first.getTokenType() == pylir::TokenType::StringLiteral);
-            const auto* str = std::get_if<std::string>(&first.getValue());
-            REQUIRE(str);
-            CHECK(*str == "\\\\\\\"\\a\\b\\f\\n\\r\\t\\v\\newline\\u343\\N");
+            CHECK(lexer.getTokenValues()->getString(first) == "\\\\\\\"\\a\\b\\f\\n\\r\\t\\v\\newline\\u343\\N");
         }
         SECTION("Not immediately before")
         {
@@ -347,14 +352,10 @@ TEST_CASE("Lex string literals", "[Lexer]")
             REQUIRE(result.size() >= 2);
             auto& first = result[0];
             CHECK(first.getTokenType() == pylir::TokenType::Identifier);
-            const auto* str = std::get_if<std::string>(&first.getValue());
-            REQUIRE(str);
-            CHECK(*str == "r");
+            CHECK(lexer.getTokenValues()->getString(first) == "r");
             auto& second = result[1];
             CHECK(second.getTokenType() == pylir::TokenType::StringLiteral);
-            str = std::get_if<std::string>(&second.getValue());
-            REQUIRE(str);
-            CHECK(*str == "\n");
+            CHECK(lexer.getTokenValues()->getString(second) == "\n");
         }
     }
     SECTION("Byte literals")
@@ -367,9 +368,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
             REQUIRE_FALSE(result.empty());
             auto& first = result[0];
             CHECK(first.getTokenType() == pylir::TokenType::ByteLiteral);
-            const auto* str = std::get_if<std::string>(&first.getValue());
-            REQUIRE(str);
-            CHECK(*str == "\xC2\xA7");
+            CHECK(lexer.getTokenValues()->getString(first) == "\xC2\xA7");
         }
         SECTION("Raw")
         {
@@ -379,9 +378,7 @@ TEST_CASE("Lex string literals", "[Lexer]")
             REQUIRE_FALSE(result.empty());
             auto& first = result[0];
             CHECK(first.getTokenType() == pylir::TokenType::ByteLiteral);
-            const auto* str = std::get_if<std::string>(&first.getValue());
-            REQUIRE(str);
-            CHECK(*str == "\\xC2\\xA7");
+            CHECK(lexer.getTokenValues()->getString(first) == "\\xC2\\xA7");
         }
         LEXER_EMITS("b'§'", pylir::Diag::ONLY_ASCII_VALUES_ARE_ALLOWED_IN_BYTE_LITERALS);
         LEXER_EMITS("b'§'", pylir::Diag::USE_HEX_OR_OCTAL_ESCAPES_INSTEAD);
@@ -399,9 +396,7 @@ TEST_CASE("Lex integers", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::IntegerLiteral);
-        const auto* apInt = std::get_if<pylir::BigInt>(&number.getValue());
-        REQUIRE(apInt);
-        CHECK(*apInt == pylir::BigInt(30));
+        CHECK(lexer.getTokenValues()->getInteger(number) == pylir::BigInt(30));
     }
     SECTION("Binary")
     {
@@ -411,9 +406,7 @@ TEST_CASE("Lex integers", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::IntegerLiteral);
-        const auto* apInt = std::get_if<pylir::BigInt>(&number.getValue());
-        REQUIRE(apInt);
-        CHECK(*apInt == pylir::BigInt(2));
+        CHECK(lexer.getTokenValues()->getInteger(number) == pylir::BigInt(2));
     }
     SECTION("Octal")
     {
@@ -423,9 +416,7 @@ TEST_CASE("Lex integers", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::IntegerLiteral);
-        const auto* apInt = std::get_if<pylir::BigInt>(&number.getValue());
-        REQUIRE(apInt);
-        CHECK(*apInt == pylir::BigInt(030));
+        CHECK(lexer.getTokenValues()->getInteger(number) == pylir::BigInt(030));
     }
     SECTION("Hex")
     {
@@ -435,9 +426,7 @@ TEST_CASE("Lex integers", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::IntegerLiteral);
-        const auto* apInt = std::get_if<pylir::BigInt>(&number.getValue());
-        REQUIRE(apInt);
-        CHECK(*apInt == pylir::BigInt(0x30));
+        CHECK(lexer.getTokenValues()->getInteger(number) == pylir::BigInt(0x30));
     }
     SECTION("Underline")
     {
@@ -447,11 +436,22 @@ TEST_CASE("Lex integers", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::IntegerLiteral);
-        const auto* apInt = std::get_if<pylir::BigInt>(&number.getValue());
-        REQUIRE(apInt);
-        CHECK(*apInt == pylir::BigInt(0x30));
+        CHECK(lexer.getTokenValues()->getInteger(number) == pylir::BigInt(0x30));
         LEXER_EMITS("0x3__0", pylir::Diag::UNDERSCORE_ONLY_ALLOWED_BETWEEN_DIGITS);
     }
+    SECTION("Large")
+    {
+        pylir::Diag::Document document("0xFFFFFFFFFFFFFFFF 0x1_0000_0000_0000_0000");
+        pylir::Lexer lexer(document, 1);
+        std::vector result(lexer.begin(), lexer.end());
+        REQUIRE(result.size() == 3);
+        // Integers fitting into 64 bit are stored inline within the token, larger ones out of line.
+        CHECK(result[0].getInlineInteger() == std::numeric_limits<std::uint64_t>::max());
+        CHECK_FALSE(result[1].getInlineInteger());
+        auto first = lexer.getTokenValues()->getInteger(result[0]);
+        CHECK(first == pylir::BigInt(std::numeric_limits<std::uint64_t>::max()));
+        CHECK(lexer.getTokenValues()->getInteger(result[1]) == first + pylir::BigInt(1));
+    }
     SECTION("Null")
     {
         pylir::Diag::Document document("0000000000000");
@@ -460,9 +460,7 @@ TEST_CASE("Lex integers", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::IntegerLiteral);
-        const auto* apInt = std::get_if<pylir::BigInt>(&number.getValue());
-        REQUIRE(apInt);
-        CHECK(apInt->isZero());
+        CHECK(lexer.getTokenValues()->getInteger(number).isZero());
         LEXER_EMITS("00000000001", pylir::Diag::NUMBER_WITH_LEADING_ZEROS_NOT_ALLOWED);
     }
     LEXER_EMITS("0x3ll", pylir::Diag::INVALID_INTEGER_SUFFIX, "ll");
@@ -478,9 +476,7 @@ TEST_CASE("Lex floats", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::FloatingPointLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 3.14);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 3.14);
     }
     SECTION("Trailing dot")
     {
@@ -490,9 +486,7 @@ TEST_CASE("Lex floats", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::FloatingPointLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 10);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 10);
     }
     SECTION("Leading dot")
     {
@@ -502,9 +496,7 @@ TEST_CASE("Lex floats", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::FloatingPointLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == .001);
+        CHECK(lexer.getTokenValues()->getDouble(number) == .001);
     }
     SECTION("Exponent")
     {
@@ -514,9 +506,7 @@ TEST_CASE("Lex floats", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::FloatingPointLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 1e100);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 1e100);
     }
     SECTION("Neg exponent")
     {
@@ -526,9 +516,7 @@ TEST_CASE("Lex floats", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::FloatingPointLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 3.14e-10);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 3.14e-10);
     }
     SECTION("0")
     {
@@ -538,9 +526,7 @@ TEST_CASE("Lex floats", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::FloatingPointLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 0e0);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 0e0);
     }
     SECTION("Underlines")
     {
@@ -550,9 +536,7 @@ TEST_CASE("Lex floats", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::FloatingPointLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 3.141593);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 3.141593);
     }
     LEXER_EMITS("0e", pylir::Diag::EXPECTED_DIGITS_FOR_THE_EXPONENT);
 }
@@ -567,9 +551,7 @@ TEST_CASE("Lex complex literals", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::ComplexLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 3.14);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 3.14);
     }
     SECTION("Trailing dot")
     {
@@ -579,9 +561,7 @@ TEST_CASE("Lex complex literals", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::ComplexLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 10);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 10);
     }
     SECTION("Integer")
     {
@@ -591,9 +571,7 @@ TEST_CASE("Lex complex literals", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::ComplexLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 10);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 10);
     }
     SECTION("Leading dot")
     {
@@ -603,9 +581,7 @@ TEST_CASE("Lex complex literals", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::ComplexLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == .001);
+        CHECK(lexer.getTokenValues()->getDouble(number) == .001);
     }
     SECTION("Exponent")
     {
@@ -615,9 +591,7 @@ TEST_CASE("Lex complex literals", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::ComplexLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 1e100);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 1e100);
     }
     SECTION("Neg exponent")
     {
@@ -627,9 +601,7 @@ TEST_CASE("Lex complex literals", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::ComplexLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 3.14e-10);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 3.14e-10);
     }
     SECTION("0")
     {
@@ -639,9 +611,7 @@ TEST_CASE("Lex complex literals", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::ComplexLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 0e0);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 0e0);
     }
     SECTION("Underlines")
     {
@@ -651,9 +621,7 @@ TEST_CASE("Lex complex literals", "[Lexer]")
         REQUIRE(result.size() == 2);
         auto& number = result[0];
         CHECK(number.getTokenType() == pylir::TokenType::ComplexLiteral);
-        const auto* value = std::get_if<double>(&number.getValue());
-        REQUIRE(value);
-        CHECK(*value == 3.141593);
+        CHECK(lexer.getTokenValues()->getDouble(number) == 3.141593);
     }
 }
 
@@ -833,19 +801,117 @@ void lex(std::string_view source)
     pylir::Diag::Document document(std::string{source});
     pylir::Lexer lexer(document);
     std::for_each(lexer.begin(), lexer.end(),
-                  [](const pylir::Token& token)
+                  [&](const pylir::Token& token)
                   {
                       if (token.getTokenType() == pylir::TokenType::SyntaxError)
                       {
-                          std::cerr << pylir::get<std::string>(token.getValue());
+                          std::cerr << lexer.getTokenValues()->getString(token);
                       }
                   });
 }
 } // namespace
 
+TEST_CASE("Lex long runs", "[Lexer]")
+{
+    // Long enough for the bulk scans over the bytes of the document to be used.
+    std::string filler(37, 'a');
+    SECTION("Comment")
+    {
+        pylir::Diag::Document document("# " + filler + "ä" + filler + "\n" + filler);
+        pylir::Lexer lexer(document);
+        std::vector result(lexer.begin(), lexer.end());
+        REQUIRE(result.size() == 3);
+        CHECK(result[0].getTokenType() == pylir::TokenType::Newline);
+        CHECK(result[1].getTokenType() == pylir::TokenType::Identifier);
+        CHECK(result[1].getOffset() == 2 + 2 * 37 + 2 + 1);
+    }
+    SECTION("String")
+    {
+        for (std::size_t i = 0; i < 20; i++)
+        {
+            auto prefix = filler.substr(0, i);
+            pylir::Diag::Document document("'" + prefix + "\\n" + filler + "\"ä" + filler + "'");
+            pylir::Lexer lexer(document);
+            std::vector result(lexer.begin(), lexer.end());
+            REQUIRE(result.size() == 2);
+            CHECK(result[0].getTokenType() == pylir::TokenType::StringLiteral);
+            CHECK(lexer.getTokenValues()->getString(result[0]) == prefix + "\n" + filler + "\"ä" + filler);
+        }
+        LEXER_EMITS("'" + filler + "\n'", pylir::Diag::NEWLINE_NOT_ALLOWED_IN_LITERAL);
+        LEXER_EMITS("b'" + filler + "ä'", pylir::Diag::ONLY_ASCII_VALUES_ARE_ALLOWED_IN_BYTE_LITERALS);
+    }
+    SECTION("Indentation")
+    {
+        pylir::Diag::Document document("if a:\n" + std::string(40, ' ') + "pass\n" + std::string(32, ' ') + "\tb\n");
+        pylir::Lexer lexer(document);
+        std::vector<pylir::TokenType> result;
+        std::transform(lexer.begin(), lexer.end(), std::back_inserter(result),
+                       [](const auto& token) { return token.getTokenType(); });
+        CHECK(result
+              == std::vector{pylir::TokenType::IfKeyword, pylir::TokenType::Identifier, pylir::TokenType::Colon,
+                             pylir::TokenType::Newline, pylir::TokenType::Indent, pylir::TokenType::PassKeyword,
+                             pylir::TokenType::Newline, pylir::TokenType::Identifier, pylir::TokenType::Newline,
+                             pylir::TokenType::Dedent, pylir::TokenType::Newline});
+    }
+}
+
 TEST_CASE("Lexer fuzzer discoveries", "[Lexer]")
 {
     lex("2_\x87");
     lex("0Y");
     lex("\xFF\xfe\xff");
 }
+
+TEST_CASE("Lex in parallel", "[Lexer]")
+{
+    std::string source;
+    for (std::size_t i = 0; i < 5000; i++)
+    {
+        source += "def foo" + std::to_string(i) + "(a, b = (3,\n4)):\n"
+                  "    # comment with \"quotes'\n"
+                  "    return a + r'\\' + '\\''\n"
+                  "x = \"\"\"multi\nline = 3\n\"\"\"\n"
+                  "\n"
+                  "y = [1,\n2]\n"
+                  "z = 1 + \\\n5\n"
+                  "if x:\n"
+                  "    if y:\n"
+                  "        pass\n";
+    }
+    pylir::Diag::Document document(source);
+    pylir::Lexer sequential(document);
+    std::vector<pylir::Token> expected(sequential.begin(), sequential.end());
+    CHECK(std::none_of(expected.begin(), expected.end(),
+                       [](const pylir::Token& token)
+                       { return token.getTokenType() == pylir::TokenType::SyntaxError; }));
+
+    llvm::ThreadPool threadPool(llvm::hardware_concurrency(4));
+    pylir::Lexer parallel(document, 0, [](auto&&) {}, &threadPool);
+    std::vector<pylir::Token> actual(parallel.begin(), parallel.end());
+    REQUIRE(actual.size() == expected.size());
+    for (std::size_t i = 0; i < actual.size(); i++)
+    {
+        CHECK(actual[i].getTokenType() == expected[i].getTokenType());
+        CHECK(actual[i].getOffset() == expected[i].getOffset());
+        CHECK(actual[i].getSize() == expected[i].getSize());
+        CHECK(actual[i].getInlineInteger() == expected[i].getInlineInteger());
+        REQUIRE(actual[i].getValueIndex().has_value() == expected[i].getValueIndex().has_value());
+        if (actual[i].getValueIndex())
+        {
+            CHECK((*parallel.getTokenValues())[*actual[i].getValueIndex()]
+                  == (*sequential.getTokenValues())[*expected[i].getValueIndex()]);
+        }
+    }
+
+    // Identifiers lexed by different chunks have to be interned into the same value.
+    std::unordered_map<std::string, pylir::Token::ValueIndex> identifiers;
+    for (auto& token : actual)
+    {
+        if (token.getTokenType() != pylir::TokenType::Identifier)
+        {
+            continue;
+        }
+        auto [iter, inserted] = identifiers.emplace(parallel.getTokenValues()->getString(token), *token.getValueIndex());
+        CHECK(iter->second == token.getValueIndex());
+    }
+}
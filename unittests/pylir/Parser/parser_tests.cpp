@@ -11,6 +11,7 @@
 #include <pylir/Parser/Parser.hpp>
 
 #include <iostream>
+#include <optional>
 
 #define PARSER_EMITS(source, ...)                                         \
     [](std::string str)                                                   \
@@ -206,3 +207,18 @@ TEST_CASE("Parse function definition", "[Parser]")
                  "  pass",
                  pylir::Diag::NO_DEFAULT_ARGUMENT_FOR_PARAMETER_N_FOLLOWING_PARAMETERS_WITH_DEFAULT_ARGUMENTS, "c");
 }
+
+TEST_CASE("Parse file input outlives parser", "[Parser]")
+{
+    std::optional<pylir::Syntax::FileInput> fileInput;
+    for (std::size_t i = 0; i < 2; i++)
+    {
+        pylir::Diag::Document document("def foo(a):\n"
+                                       "    return [a, (a + 3) * 5]\n");
+        pylir::Parser parser(document);
+        auto result = parser.parseFileInput();
+        REQUIRE(result);
+        fileInput = std::move(*result);
+    }
+    REQUIRE(fileInput->input->statements.size() == 1);
+}